@@ -0,0 +1,212 @@
+#include "jsopt/lex.h"
+#include "jsopt/source.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Lexer throughput on synthetic inputs shaped like the code each fast
+// path targets, plus any files given, alone and interning identifiers
+// into an atom table shared across the run, and the watch-mode latency of
+// one space typed mid-file (lex_diff + lex_edit). Prints one JSON object
+// to stdout.
+//
+//   bench_lex [-s BYTES] [-r REPS] [FILE...]
+
+#define BENCH_BYTES (4u << 20)
+#define BENCH_REPS  5
+
+typedef void (*GenFn)(char *buf, uint32_t size);
+
+// Repeat unit until size bytes are filled, cutting at a unit boundary
+static void fill(char *buf, uint32_t size, const char *unit) {
+    size_t n = strlen(unit), at = 0;
+    while (at + n <= size) {
+        memcpy(buf + at, unit, n);
+        at += n;
+    }
+    memset(buf + at, ' ', size - at);
+}
+
+// Minified vendor code: short regexes next to divisions
+static void gen_regex(char *buf, uint32_t size) {
+    fill(buf, size, "a=/[a-z0-9_\\/]+\\.(js|css)$/i.test(s)?x/2:/^\\s*\\/\\/.*$/gm;"
+                    "r=s.replace(/\\s+/g,\" \").split(/,\\s*/);");
+}
+
+// JSON-heavy / i18n bundles: string-dominated object literals
+static void gen_strings(char *buf, uint32_t size) {
+    fill(buf, size, "{\"id\":\"greeting.welcome_back\",\"msg\":\"Willkommen zur\\u00fcck, "
+                    "\\\"{name}\\\"! Sie haben {count} neue Nachrichten.\",\"desc\":"
+                    "'Shown on the dashboard header after sign-in \\'v2\\''},\n");
+}
+
+// One string spanning the whole input (localized bundles ship several MB)
+static void gen_big_string(char *buf, uint32_t size) {
+    fill(buf, size, "Lorem ipsum dolor sit amet, \\\"consectetur\\\" adipiscing elit. ");
+    buf[0] = '"';
+    buf[size - 2] = '"';
+    buf[size - 3] = 'x'; // not a backslash escaping the closing quote
+    buf[size - 1] = ';';
+}
+
+// CSS-in-JS / GraphQL: large templates with a few substitutions
+static void gen_templates(char *buf, uint32_t size) {
+    fill(buf, size, "const Button=styled.button`\n  display: inline-flex;\n  padding: "
+                    "${p=>p.dense?4:8}px 16px;\n  color: ${({theme})=>theme.fg};\n"
+                    "  &:hover { background: \\`$100\\`; }\n`;\n");
+}
+
+// Unminified library source: JSDoc blocks and line comments, a license
+// header now and then
+static void gen_comments(char *buf, uint32_t size) {
+    fill(buf, size, "/**\n * Returns the value at path of object.\n * @param {Object} object\n"
+                    " * @param {string} path\n * @returns {*}\n */\nfunction get(o, p) {\n"
+                    "  // walk the path one key at a time\n  return o[p]; // may be undefined\n}\n"
+                    "/*! lodash @license MIT */\n");
+}
+
+// Non-English code: identifiers in Cyrillic and CJK, escapes now and then
+static void gen_unicode(char *buf, uint32_t size) {
+    fill(buf, size, "const \xd0\xb8\xd0\xbc\xd1\x8f\xd0\x9f\xd0\xbe\xd0\xbb\xd1\x8c=\xe8\x8e"
+                    "\xb7\xe5\x8f\x96(\xe6\x95\xb0\xe6\x8d\xae.\xe6\xa0\x87\xe8\xaf\x86\xe7"
+                    "\xac\xa6,caf\\u00e9_count)+r\xc3\xa9sum\xc3\xa9.length;\n");
+}
+
+static void gen_mixed(char *buf, uint32_t size) {
+    fill(buf, size, "function f(a,b){var c=a.length>>>0,d=[];for(let i=0;i<c;i++)"
+                    "d.push(a[i]*2+b[i]/3);return d.filter(x=>x!==null)}\n");
+}
+
+typedef struct {
+    const char *name;
+    GenFn       gen;
+} Case;
+
+static const Case CASES[] = {
+    { "regex", gen_regex },
+    { "strings", gen_strings },
+    { "big_string", gen_big_string },
+    { "templates", gen_templates },
+    { "comments", gen_comments },
+    { "unicode", gen_unicode },
+    { "mixed", gen_mixed },
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Best time to re-lex src after a space is typed next to the first space
+// or newline from the middle on (inside a string, comment or template, or
+// between tokens, the text stays lexable)
+static uint64_t edit_ns(NodeArray *arr, AtomTable *atoms, const char *src, uint32_t len,
+                        int reps) {
+    uint32_t at = len / 2;
+    while (at < len && src[at] != ' ' && src[at] != '\n') at++;
+    char *typed = malloc((size_t)len + 1 + SOURCE_PADDING);
+    if (!typed) return 0;
+    memcpy(typed, src, at);
+    typed[at] = ' ';
+    memcpy(typed + at + 1, src + at, len - at);
+    memset(typed + len + 1, 0, SOURCE_PADDING);
+
+    uint64_t best = UINT64_MAX;
+    CommentTable comments = { 0 };
+    LexError err;
+    LexEdit edit;
+    LexSplice splice;
+    for (int r = 0; r < reps; r++) {
+        node_array_reset(arr);
+        if (lex(arr, src, len, &comments, atoms, &err) < 0) break;
+        uint64_t t0 = now_ns();
+        lex_diff(src, len, typed, len + 1, &edit);
+        int rc = lex_edit(arr, typed, len + 1, &edit, &comments, atoms, &splice, &err);
+        uint64_t t1 = now_ns();
+        if (rc < 0) break;
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    comment_table_free(&comments);
+    free(typed);
+    return best == UINT64_MAX ? 0 : best;
+}
+
+// Best of reps over one padded input, without and with atoms
+static void run(NodeArray *arr, AtomTable *atoms, const char *name, const char *src,
+                uint32_t len, int reps, int last) {
+    uint64_t best = UINT64_MAX, interned = UINT64_MAX;
+    LexError err;
+    int rc = 0;
+    for (int r = 0; r < reps; r++) {
+        node_array_reset(arr);
+        uint64_t t0 = now_ns();
+        rc = lex(arr, src, len, NULL, NULL, &err);
+        uint64_t t1 = now_ns();
+        node_array_reset(arr);
+        lex(arr, src, len, NULL, atoms, &err);
+        uint64_t t2 = now_ns();
+        if (t1 - t0 < best) best = t1 - t0;
+        if (t2 - t1 < interned) interned = t2 - t1;
+    }
+    uint32_t tokens = arr->count - 1;
+    uint64_t edit = edit_ns(arr, atoms, src, len, reps);
+    if (best == 0) best = 1;
+    if (interned == 0) interned = 1;
+    printf("    {\"name\": \"%s\", \"bytes\": %u, \"tokens\": %u, \"ok\": %s, \"ns\": %llu, "
+           "\"mb_per_s\": %.2f, \"ns_per_token\": %.3f, \"interned_mb_per_s\": %.2f, "
+           "\"edit_us\": %.1f}%s\n",
+           name, len, tokens, rc == 0 ? "true" : "false",
+           (unsigned long long)best, (double)len * 1e3 / (double)best,
+           tokens ? (double)best / tokens : 0.0,
+           (double)len * 1e3 / (double)interned, (double)edit / 1e3, last ? "" : ",");
+}
+
+int main(int argc, char **argv) {
+    uint32_t size = BENCH_BYTES;
+    int reps = BENCH_REPS, opt;
+    while ((opt = getopt(argc, argv, "s:r:")) != -1) {
+        switch (opt) {
+        case 's': size = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'r': reps = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: bench_lex [-s BYTES] [-r REPS] [FILE...]\n");
+            return 1;
+        }
+    }
+    if (size == 0 || size > SOURCE_MAX_LEN / 2) size = BENCH_BYTES;
+    if (reps < 1) reps = 1;
+
+    NodeArray arr;
+    AtomTable atoms;
+    char *buf = calloc(1, (size_t)size + SOURCE_PADDING);
+    if (!buf || node_array_init(&arr, 0) != 0 || atom_table_init(&atoms, 1u << 20) != 0) {
+        fprintf(stderr, "bench_lex: out of memory\n");
+        return 1;
+    }
+
+    size_t count = sizeof(CASES) / sizeof(CASES[0]);
+    printf("{\n  \"suite\": \"lex\", \"reps\": %d,\n  \"benchmarks\": [\n", reps);
+    for (size_t i = 0; i < count; i++) {
+        CASES[i].gen(buf, size);
+        run(&arr, &atoms, CASES[i].name, buf, size, reps, i + 1 == count && optind == argc);
+    }
+    for (int i = optind; i < argc; i++) {
+        Source src;
+        if (source_open(&src, argv[i]) < 0) {
+            perror(argv[i]);
+            continue;
+        }
+        run(&arr, &atoms, argv[i], src.data, src.len, reps, i + 1 == argc);
+        source_close(&src);
+    }
+    printf("  ]\n}\n");
+
+    node_array_free(&arr);
+    atom_table_free(&atoms);
+    free(buf);
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include "jsopt/node.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+
+// NodeArray hot-path microbenchmarks. Prints one JSON object to stdout;
+// counters the kernel refuses (perf_event_paranoid, containers) are null.
+//
+//   bench_node [-n NODES] [-r REPS]
+
+#define BENCH_NODES (1u << 22)
+#define BENCH_REPS  5
+#define LIST_LEN    4
+
+typedef enum { CTR_CYCLES, CTR_INSNS, CTR_DTLB, CTR_FAULTS, CTR_COUNT } Counter;
+
+static const char *const CTR_NAMES[CTR_COUNT] = {
+    "cycles", "instructions", "dtlb_misses", "page_faults",
+};
+
+typedef struct {
+    int      fd[CTR_COUNT];
+    uint64_t val[CTR_COUNT];
+} Counters;
+
+// Minimal lexer shape for EMIT
+typedef struct {
+    NodeArray nodes;
+    uint32_t  line;
+} BenchLex;
+
+typedef void (*BenchFn)(NodeArray *arr, uint32_t n);
+
+static int perf_open(uint32_t type, uint64_t config) {
+    struct perf_event_attr a;
+    memset(&a, 0, sizeof(a));
+    a.size           = sizeof(a);
+    a.type           = type;
+    a.config         = config;
+    a.disabled       = 1;
+    a.exclude_kernel = type != PERF_TYPE_SOFTWARE; // allowed at paranoid 2
+    a.exclude_hv     = 1;
+    return (int)syscall(__NR_perf_event_open, &a, 0, -1, -1, 0);
+}
+
+static void counters_open(Counters *c) {
+    c->fd[CTR_CYCLES] = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    c->fd[CTR_INSNS]  = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    c->fd[CTR_DTLB]   = perf_open(PERF_TYPE_HW_CACHE,
+                                  PERF_COUNT_HW_CACHE_DTLB |
+                                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    c->fd[CTR_FAULTS] = perf_open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+}
+
+static void counters_close(Counters *c) {
+    for (int i = 0; i < CTR_COUNT; i++)
+        if (c->fd[i] >= 0) close(c->fd[i]);
+}
+
+static void counters_start(Counters *c) {
+    for (int i = 0; i < CTR_COUNT; i++) {
+        if (c->fd[i] < 0) continue;
+        ioctl(c->fd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(c->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static void counters_stop(Counters *c) {
+    for (int i = 0; i < CTR_COUNT; i++) {
+        if (c->fd[i] < 0) continue;
+        ioctl(c->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(c->fd[i], &c->val[i], sizeof(uint64_t)) != sizeof(uint64_t))
+            c->val[i] = 0;
+    }
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_push_token(NodeArray *arr, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++)
+        node_push_token(arr, NODE_IDENT, i, 3, 1);
+}
+
+static void bench_emit(NodeArray *arr, uint32_t n) {
+    BenchLex lex = { *arr, 1 };
+    for (uint32_t i = 0; i < n; i++)
+        EMIT(&lex, NODE_IDENT, i, i + 3);
+    *arr = lex.nodes;
+}
+
+// Three tokens per compound, roughly a lexed-then-parsed binary expression
+static void bench_push_mixed(NodeArray *arr, uint32_t n) {
+    for (uint32_t i = 0; i + 4 <= n; i += 4) {
+        uint32_t a = node_push_token(arr, NODE_IDENT, i, 1, 1);
+        node_push_token(arr, NODE_PLUS, i + 2, 1, 1);
+        uint32_t b = node_push_token(arr, NODE_NUMBER, i + 4, 1, 1);
+        node_push(arr, NODE_BINARY, 0, NODE_PLUS, i, a, b);
+    }
+}
+
+// Parser make_list: reserve count + 1, copy children, parent in the last slot
+static void bench_reserve_fill(NodeArray *arr, uint32_t n) {
+    const Node child = { NODE_IDENT, 0, 1, 0, { 1, 0 } };
+    for (uint32_t i = 0; i + LIST_LEN + 1 <= n; i += LIST_LEN + 1) {
+        uint32_t first = node_reserve(arr, LIST_LEN + 1);
+        for (uint32_t k = 0; k < LIST_LEN; k++)
+            arr->nodes[first + k] = child;
+        arr->nodes[first + LIST_LEN] = (Node){ NODE_ARRAY, 0, 0, i, { first, LIST_LEN } };
+    }
+}
+
+typedef struct {
+    const char *name;
+    BenchFn     fn;
+    int         cold; // fresh reservation every rep: measures first touch
+} Bench;
+
+static const Bench BENCHES[] = {
+    { "push_token_warm",  bench_push_token,   0 },
+    { "push_token_cold",  bench_push_token,   1 },
+    { "emit_warm",        bench_emit,         0 },
+    { "emit_cold",        bench_emit,         1 },
+    { "push_mixed_warm",  bench_push_mixed,   0 },
+    { "reserve_fill_warm", bench_reserve_fill, 0 },
+};
+
+// Best of reps; counters are those of the fastest rep
+static void run(const Bench *b, uint32_t n, int reps, int last) {
+    NodeArray arr;
+    if (node_array_init(&arr, 0) != 0) {
+        fprintf(stderr, "bench_node: cannot reserve node array\n");
+        exit(1);
+    }
+    // Warm runs fault the pages in once and rewind count, so every rep
+    // writes to resident memory (node_array_reset would release them)
+    if (!b->cold) b->fn(&arr, n);
+
+    Counters c, best;
+    counters_open(&c);
+    uint64_t best_ns = UINT64_MAX;
+    for (int r = 0; r < reps; r++) {
+        if (b->cold) {
+            node_array_free(&arr);
+            if (node_array_init(&arr, 0) != 0) exit(1);
+        } else {
+            arr.count = 1;
+        }
+        counters_start(&c);
+        uint64_t t0 = now_ns();
+        b->fn(&arr, n);
+        uint64_t t = now_ns() - t0;
+        counters_stop(&c);
+        if (t < best_ns) {
+            best_ns = t;
+            best = c;
+        }
+    }
+    uint32_t nodes = arr.count - 1;
+    counters_close(&c);
+    node_array_free(&arr);
+
+    if (best_ns == 0) best_ns = 1;
+    printf("    {\"name\": \"%s\", \"nodes\": %u, \"ns\": %llu, "
+           "\"ns_per_op\": %.3f, \"nodes_per_sec\": %.0f",
+           b->name, nodes, (unsigned long long)best_ns,
+           (double)best_ns / nodes, (double)nodes * 1e9 / (double)best_ns);
+    for (int i = 0; i < CTR_COUNT; i++) {
+        if (best.fd[i] < 0)
+            printf(", \"%s\": null", CTR_NAMES[i]);
+        else
+            printf(", \"%s\": %llu", CTR_NAMES[i], (unsigned long long)best.val[i]);
+    }
+    printf("}%s\n", last ? "" : ",");
+}
+
+int main(int argc, char **argv) {
+    uint32_t n = BENCH_NODES;
+    int reps = BENCH_REPS, opt;
+    while ((opt = getopt(argc, argv, "n:r:")) != -1) {
+        switch (opt) {
+        case 'n': n = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'r': reps = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: bench_node [-n NODES] [-r REPS]\n");
+            return 1;
+        }
+    }
+    if (n == 0 || n >= NODE_MAX_NODES) n = BENCH_NODES;
+    if (reps < 1) reps = 1;
+
+    size_t count = sizeof(BENCHES) / sizeof(BENCHES[0]);
+    printf("{\n  \"suite\": \"node\", \"node_size\": %zu, \"reps\": %d,\n"
+           "  \"benchmarks\": [\n", sizeof(Node), reps);
+    for (size_t i = 0; i < count; i++)
+        run(&BENCHES[i], n, reps, i + 1 == count);
+    printf("  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "jsopt/walk.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+// Walker overhead per node on trees shaped like parser output, with
+// counting pre and post callbacks and bare (no callbacks), and the cost of
+// node_array_validate on the same trees. Prints one JSON object to stdout.
+//
+//   bench_walk [-n NODES] [-r REPS]
+
+#define BENCH_NODES (1u << 22)
+#define BENCH_REPS  5
+#define STMT_NODES  8
+
+typedef void (*BuildFn)(NodeArray *arr, uint32_t n);
+
+// Statement list of `x = a + b * c;` (9 nodes each with the list copy),
+// built like the parser's make_list: statements first, then their copies
+static void build_statements(NodeArray *arr, uint32_t n) {
+    uint32_t count = n / (STMT_NODES + 1);
+    uint32_t stmts = arr->count;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t a = node_push_token(arr, NODE_IDENT, 0, 1, 1);
+        uint32_t b = node_push_token(arr, NODE_IDENT, 0, 1, 1);
+        uint32_t c = node_push_token(arr, NODE_IDENT, 0, 1, 1);
+        uint32_t mul = node_push(arr, NODE_BINARY, 0, NODE_STAR, 0, b, c);
+        uint32_t add = node_push(arr, NODE_BINARY, 0, NODE_PLUS, 0, a, mul);
+        uint32_t x = node_push_token(arr, NODE_IDENT, 0, 1, 1);
+        uint32_t asg = node_push(arr, NODE_ASSIGN, 0, NODE_EQ, 0, x, add);
+        node_push(arr, NODE_EXPR_STMT, 0, 0, 0, asg, 0);
+    }
+    uint32_t first = node_reserve(arr, count);
+    for (uint32_t i = 0; i < count; i++)
+        arr->nodes[first + i] = arr->nodes[stmts + i * STMT_NODES + STMT_NODES - 1];
+    arr->root = node_push(arr, NODE_PROGRAM, 0, 0, 0, first, count);
+}
+
+// Minified a+a+a+... : one left-deep chain
+static void build_chain(NodeArray *arr, uint32_t n) {
+    uint32_t left = node_push_token(arr, NODE_IDENT, 0, 1, 1);
+    for (uint32_t i = 0; i + 2 < n; i += 2) {
+        uint32_t right = node_push_token(arr, NODE_IDENT, 0, 1, 1);
+        left = node_push(arr, NODE_BINARY, 0, NODE_PLUS, 0, left, right);
+    }
+    arr->root = left;
+}
+
+typedef struct {
+    const char *name;
+    BuildFn     build;
+} Case;
+
+static const Case CASES[] = {
+    { "statements", build_statements },
+    { "chain", build_chain },
+};
+
+static WalkAction count_node(NodeArray *arr, uint32_t idx, uint32_t parent, void *ctx) {
+    (void)arr;
+    (void)idx;
+    (void)parent;
+    ++*(uint64_t *)ctx;
+    return WALK_CONTINUE;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    uint32_t n = BENCH_NODES;
+    int reps = BENCH_REPS, opt;
+    while ((opt = getopt(argc, argv, "n:r:")) != -1) {
+        switch (opt) {
+        case 'n': n = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'r': reps = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Usage: bench_walk [-n NODES] [-r REPS]\n");
+            return 1;
+        }
+    }
+    if (n < 16 || n >= NODE_MAX_NODES) n = BENCH_NODES;
+    if (reps < 1) reps = 1;
+
+    NodeArray arr;
+    if (node_array_init(&arr, 0) != 0) {
+        fprintf(stderr, "bench_walk: cannot reserve node array\n");
+        return 1;
+    }
+
+    size_t count = sizeof(CASES) / sizeof(CASES[0]);
+    printf("{\n  \"suite\": \"walk\", \"reps\": %d,\n  \"benchmarks\": [\n", reps);
+    for (size_t i = 0; i < count; i++) {
+        node_array_reset(&arr);
+        CASES[i].build(&arr, n);
+        uint64_t best = UINT64_MAX, bare = UINT64_MAX, check = UINT64_MAX, visits = 0;
+        NodeError err;
+        for (int r = 0; r < reps; r++) {
+            visits = 0;
+            uint64_t t0 = now_ns();
+            walk(&arr, arr.root, count_node, count_node, &visits);
+            uint64_t t1 = now_ns();
+            walk(&arr, arr.root, NULL, NULL, NULL);
+            uint64_t t2 = now_ns();
+            if (node_array_validate(&arr, &err) != 0) {
+                fprintf(stderr, "bench_walk: %s: node %u: %s\n", CASES[i].name, err.idx, err.msg);
+                return 1;
+            }
+            uint64_t t3 = now_ns();
+            if (t1 - t0 < best) best = t1 - t0;
+            if (t2 - t1 < bare) bare = t2 - t1;
+            if (t3 - t2 < check) check = t3 - t2;
+        }
+        double nodes = visits ? (double)(visits / 2) : 1.0;
+        printf("    {\"name\": \"%s\", \"nodes\": %llu, \"ns\": %llu, \"ns_per_node\": %.3f, "
+               "\"bare_ns_per_node\": %.3f, \"validate_ns_per_node\": %.3f}%s\n",
+               CASES[i].name, (unsigned long long)(visits / 2), (unsigned long long)best,
+               (double)best / nodes, (double)bare / nodes, (double)check / nodes,
+               i + 1 == count ? "" : ",");
+    }
+    printf("  ]\n}\n");
+
+    node_array_free(&arr);
+    return 0;
+}
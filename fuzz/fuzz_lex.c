@@ -0,0 +1,474 @@
+#include "jsopt/hash.h"
+#include "jsopt/lex.h"
+#include "jsopt/source.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// Differential lexer fuzz target. Every input is lexed by the production
+// lexer and by the scalar reference build (lex_reference); both must
+// produce byte-identical arrays, or the same error, and the tokens must
+// satisfy the invariants in check_tokens. Then an edit derived from the
+// input goes through lex_edit, which must match lexing the edited text.
+// SIMD fast paths are free to be aggressive as long as this stays quiet.
+//
+// Mutations are token-aware: token spans are cut, duplicated, swapped and
+// spliced with JS fragments, so most inputs stay close to real JS.
+//
+//   libFuzzer:  make fuzz CC=clang LIBFUZZER=1 && build/fuzz_lex CORPUS
+//   standalone: build/fuzz_lex [-n ITERS] [-s SEED] [-m MAXLEN] CORPUS [SEED...]
+//
+// The standalone loop (no coverage instrumentation with gcc) keeps inputs
+// that produce a new token bigram or error and writes them to CORPUS.
+// Failures are written to crash-<hash>.js in the working directory, as
+// libFuzzer does, and abort.
+
+#define FUZZ_MAX_INPUT (1u << 20)
+#define FUZZ_MAX_LEN   4096 // default -m for the standalone loop
+#define FUZZ_ATOMS     (1u << 20) // names before the atom table starts over
+
+static NodeArray prod, ref, scratch;
+static CommentTable prod_comments, ref_comments;
+static AtomTable atoms; // shared by both lexers: equal names, equal atoms
+static char     *pad, *edited;
+static size_t    pad_cap, edited_cap;
+
+// Token bigram (prev, kind) and error features seen so far
+static uint8_t features[1u << 14];
+static int     novel;
+
+static void feature(uint32_t f) {
+    f &= (1u << 17) - 1;
+    if (!(features[f >> 3] & (1u << (f & 7)))) {
+        features[f >> 3] |= (uint8_t)(1u << (f & 7));
+        novel = 1;
+    }
+}
+
+static void crash(const char *what, const uint8_t *data, size_t size) {
+    char name[64];
+    snprintf(name, sizeof(name), "crash-%016llx.js", (unsigned long long)hash64(data, size, 0));
+    FILE *f = fopen(name, "wb");
+    if (f) {
+        fwrite(data, 1, size, f);
+        fclose(f);
+    }
+    fprintf(stderr, "fuzz_lex: %s (input saved to %s)\n", what, name);
+    abort();
+}
+
+#define CHECK(cond, what) do { if (!(cond)) crash(what, data, size); } while (0)
+
+// Only whitespace and comments may sit between tokens: the first byte
+// after any ASCII whitespace must open a comment (or be non-ASCII space)
+static int gap_ok(const uint8_t *data, uint32_t g, uint32_t s) {
+    while (g < s && (data[g] == ' ' || data[g] == '\t' || data[g] == '\n' ||
+                     data[g] == '\r' || data[g] == '\v' || data[g] == '\f'))
+        g++;
+    return g == s || data[g] == '/' || data[g] >= 0x80 || (g == 0 && data[0] == '#');
+}
+
+static void check_tokens(const uint8_t *data, size_t size) {
+    CHECK(prod.token_end == prod.count, "tokens do not end the array");
+    CHECK(prod.token_end >= 2, "missing EOF");
+    const Node *eof = &prod.nodes[prod.token_end - 1];
+    CHECK(eof->kind == NODE_EOF && eof->start == size && NODE_LEN(eof) == 0, "bad EOF");
+
+    uint32_t end = 0, line = 1;
+    for (uint32_t i = 1; i + 1 < prod.token_end; i++) {
+        const Node *n = &prod.nodes[i];
+        uint32_t s = n->start, e = NODE_END(n);
+        CHECK(IS_TOKEN(n->kind) && n->kind != NODE_EOF, "non-token kind");
+        CHECK(s >= end && e > s && e <= size, "token out of order or out of bounds");
+        CHECK(n->data[0] >= line, "line numbers go backwards");
+        CHECK(n->op != NODE_LEN_OVERFLOW || e - s > 0xFFFE, "needless overflow length");
+
+        CHECK(gap_ok(data, end, s), "token text dropped between tokens");
+
+        uint8_t c = data[s], z = data[e - 1];
+        switch (n->kind) {
+        case NODE_STRING:
+            CHECK((c == '"' || c == '\'') && z == c && e - s >= 2, "bad string span");
+            break;
+        case NODE_REGEX:
+            CHECK(c == '/' && e - s >= 2, "bad regex span");
+            break;
+        case NODE_NUMBER:
+            CHECK((c >= '0' && c <= '9') || c == '.', "bad number span");
+            break;
+        case NODE_IDENT: {
+            // Escape-free names are their own text
+            uint32_t len;
+            const char *name = n->op == NODE_LEN_OVERFLOW ? NULL : atom_name(&atoms, n->data[1], &len);
+            CHECK(!name || n->data[1] != ATOM_NULL, "identifier without an atom");
+            CHECK(!name || memchr(data + s, '\\', e - s) ||
+                  (len == e - s && !memcmp(name, data + s, len)), "atom names other text");
+            break;
+        }
+        case NODE_TEMPLATE_FULL: case NODE_TEMPLATE_HEAD:
+        case NODE_TEMPLATE_MID: case NODE_TEMPLATE_TAIL:
+            CHECK(c == (n->kind == NODE_TEMPLATE_FULL || n->kind == NODE_TEMPLATE_HEAD ? '`' : '}'),
+                  "bad template start");
+            CHECK(z == (n->kind == NODE_TEMPLATE_FULL || n->kind == NODE_TEMPLATE_TAIL ? '`' : '{'),
+                  "bad template end");
+            break;
+        default:
+            break;
+        }
+        feature((uint32_t)prod.nodes[i - 1].kind << 8 | n->kind);
+        end = e;
+        line = n->data[0];
+    }
+    CHECK(gap_ok(data, end, (uint32_t)size), "token text dropped before EOF");
+
+    // Kept comments lie in order in the gap before the token they attach to
+    uint32_t after = 0;
+    for (uint32_t i = 0; i < prod_comments.count; i++) {
+        const Comment *c = &prod_comments.items[i];
+        const Node *next = &prod.nodes[c->attach];
+        CHECK(c->attach >= 1 && c->attach < prod.count, "comment attach out of range");
+        CHECK(c->start >= after && c->end <= next->start && c->end - c->start >= 2 &&
+              data[c->start] == '/' && (data[c->start + 1] == '/' || data[c->start + 1] == '*'),
+              "bad comment span");
+        CHECK(c->attach == 1 || NODE_END(&prod.nodes[c->attach - 1]) <= c->start,
+              "comment overlaps a token");
+        after = c->end;
+    }
+}
+
+// Bytes that flip lexer state when typed into the middle of a file
+static const char *const TYPED[] = {
+    "`", "${", "}", "/*", "*/", "/", "\"", "'", "\\", "\n", "a", " ", "",
+};
+
+// Replace data[a, b) by a typed string or another span of the input, both
+// picked from the input's hash, and require lex_edit on prod to agree
+// with lexing the result into ref
+static void check_edit(const uint8_t *data, size_t size) {
+    uint64_t h = hash64(data, size, 1);
+    size_t a = h % (size + 1), b = a + (h >> 20) % (size - a < 16 ? size - a + 1 : 17);
+    const char *ins = TYPED[(h >> 32) % (sizeof(TYPED) / sizeof(TYPED[0]))];
+    size_t n = strlen(ins);
+    if (h >> 60 & 1 && size) {
+        ins = (const char *)data + (h >> 40) % size;
+        n = (h >> 8) % 8;
+        if (n > size - (size_t)(ins - (const char *)data)) n = size - (size_t)(ins - (const char *)data);
+    }
+    size_t len = size - (b - a) + n;
+    if (edited_cap < len + SOURCE_PADDING) {
+        free(edited);
+        edited_cap = len + SOURCE_PADDING;
+        edited = malloc(edited_cap);
+        if (!edited) abort();
+    }
+    memcpy(edited, data, a);
+    memcpy(edited + a, ins, n);
+    memcpy(edited + a + n, data + b, size - b);
+    memset(edited + len, 0, SOURCE_PADDING);
+
+    LexEdit e = { (uint32_t)a, (uint32_t)b, (uint32_t)(a + n) };
+    LexSplice splice;
+    LexError e1 = { 0, 0, NULL }, e2 = { 0, 0, NULL };
+    uint32_t before = prod.count;
+    node_array_reset(&ref);
+    int r1 = lex_edit(&prod, edited, (uint32_t)len, &e, &prod_comments, &atoms, &splice, &e1);
+    int r2 = lex(&ref, edited, (uint32_t)len, &ref_comments, &atoms, &e2);
+    CHECK(r1 == r2, "lex_edit and lex disagree on success");
+    if (r1 < 0) {
+        CHECK(e1.pos == e2.pos && e1.line == e2.line && !strcmp(e1.msg, e2.msg),
+              "lex_edit and lex report different errors");
+        CHECK(prod.count == before && prod.nodes[before].kind == 0,
+              "failed lex_edit changed the tokens");
+        return;
+    }
+    CHECK(prod.count == ref.count && prod.token_end == ref.token_end &&
+          !memcmp(prod.nodes, ref.nodes, (prod.count + 1) * sizeof(Node)),
+          "lex_edit and lex produced different tokens");
+    CHECK(prod_comments.count == ref_comments.count &&
+          (!prod_comments.count || !memcmp(prod_comments.items, ref_comments.items,
+                                           prod_comments.count * sizeof(Comment))),
+          "lex_edit and lex kept different comments");
+    CHECK(splice.first + splice.added <= prod.count, "splice out of range");
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size > FUZZ_MAX_INPUT) return 0;
+    if (!prod.nodes && (node_array_init(&prod, 0) || node_array_init(&ref, 0))) abort();
+    if (atom_count(&atoms) > FUZZ_ATOMS / 2) atom_table_free(&atoms);
+    if (!atoms.slots && atom_table_init(&atoms, FUZZ_ATOMS)) abort();
+    if (pad_cap < size + SOURCE_PADDING) {
+        free(pad);
+        pad_cap = size + SOURCE_PADDING;
+        pad = malloc(pad_cap);
+        if (!pad) abort();
+    }
+    if (size) memcpy(pad, data, size);
+    memset(pad + size, 0, SOURCE_PADDING);
+
+    node_array_reset(&prod);
+    node_array_reset(&ref);
+    LexError e1 = { 0, 0, NULL }, e2 = { 0, 0, NULL };
+    int r1 = lex(&prod, pad, (uint32_t)size, &prod_comments, &atoms, &e1);
+    int r2 = lex_reference(&ref, pad, (uint32_t)size, &ref_comments, &atoms, &e2);
+
+    CHECK(r1 == r2, "lex and lex_reference disagree on success");
+    CHECK(prod.count == ref.count &&
+          !memcmp(prod.nodes, ref.nodes, prod.count * sizeof(Node)),
+          "lex and lex_reference produced different tokens");
+    CHECK(prod_comments.count == ref_comments.count &&
+          (!prod_comments.count || !memcmp(prod_comments.items, ref_comments.items,
+                                           prod_comments.count * sizeof(Comment))),
+          "lex and lex_reference kept different comments");
+    if (r1 < 0) {
+        CHECK(e1.pos == e2.pos && e1.line == e2.line && !strcmp(e1.msg, e2.msg),
+              "lex and lex_reference report different errors");
+        CHECK(e1.pos <= size, "error position out of bounds");
+        feature(1u << 16 | (uint32_t)(hash64(e1.msg, (uint32_t)strlen(e1.msg), 0) & 0xFF) << 8 |
+                prod.nodes[prod.count - 1].kind);
+        return 0;
+    }
+    NodeError verr;
+    CHECK(node_array_validate(&prod, &verr) == 0, "lex output fails node_array_validate");
+    check_tokens(data, size);
+    check_edit(data, size);
+    return 0;
+}
+
+// Snippets spliced in at token boundaries
+static const char *const FRAGMENTS[] = {
+    "var ", "let ", "const ", "function f(a, b) { return a; }", " => ",
+    "async ", "await ", "yield ", "class C extends D { #x = 1; static m() {} }",
+    "/re[/]x\\//gi", "a / b / c", "`t${x}u${`v${y}`}w`", "`${{a:1}.a}`",
+    "`\\${a}$\\{b}$\\`$`", "`a\r\n\\\r\nb\r$`", "`$$${x}`",
+    "'s\\'q'", "'\\\\\\\\\\'\\\\'", "'a\\\r\nb'",
+    "\"\\u{1F600}\\\n\"", "0x1F", "1e-7", ".5", "1_000n", "0b101",
+    "/* c\n */", "// line\n", "/*! (c) x */", "//! @license MIT\n", "/** @preserve */",
+    "?.", "?\?=", ">>>=", "**", "...", "\\u0061b",
+    "caf\xc3\xa9", "\xcf\x80", "\xf0\x9d\x90\x80", "\xe2\x82\xac", "\\u{1D400}", "\xe2\x80\x8c",
+    "\xe2\x80\xa8", "\xc2\xa0", "{", "}", "(", ")", "[", "]",
+    ";", ",", "typeof ", " instanceof ", "a.return / 2", "x++ / 2",
+    "if (a) b; else c;", "for (const k of o) {}", "\r\n", "#p", "this", "null",
+};
+
+#define FRAGMENT_COUNT (sizeof(FRAGMENTS) / sizeof(FRAGMENTS[0]))
+
+static uint64_t rng_state;
+
+static uint32_t rnd(uint32_t n) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return n ? (uint32_t)(rng_state % n) : 0;
+}
+
+// Replace data[a, b) with ins in place; returns the new size (<= max)
+static size_t edit(uint8_t *data, size_t size, size_t max,
+                     size_t a, size_t b, const uint8_t *ins, size_t n) {
+    if (size - (b - a) + n > max) return size;
+    memmove(data + a + n, data + b, size - b);
+    if (n) memmove(data + a, ins, n);
+    return size - (b - a) + n;
+}
+
+size_t LLVMFuzzerCustomMutator(uint8_t *data, size_t size, size_t max, unsigned seed) {
+    rng_state = (uint64_t)seed * 0x9E3779B97F4A7C15ULL | 1;
+    if (size > FUZZ_MAX_INPUT) size = FUZZ_MAX_INPUT;
+    if (!scratch.nodes && node_array_init(&scratch, 0)) abort();
+    if (pad_cap < size + SOURCE_PADDING) {
+        free(pad);
+        pad_cap = size + SOURCE_PADDING;
+        pad = malloc(pad_cap);
+        if (!pad) abort();
+    }
+    memcpy(pad, data, size);
+    memset(pad + size, 0, SOURCE_PADDING);
+
+    // Tokens up to the first error are still usable split points
+    node_array_reset(&scratch);
+    LexError err;
+    lex(&scratch, pad, (uint32_t)size, NULL, NULL, &err);
+    uint32_t ntok = scratch.count - 1;
+    if (ntok && scratch.nodes[scratch.count - 1].kind == NODE_EOF) ntok--;
+
+    const Node *t = &scratch.nodes[1 + rnd(ntok)];
+    size_t ts = t->start, te = NODE_END(t);
+    const char *frag = FRAGMENTS[rnd(FRAGMENT_COUNT)];
+    uint8_t tmp[256];
+
+    switch (ntok ? rnd(6) : 6) {
+    case 0: // drop a token
+        return edit(data, size, max, ts, te, NULL, 0);
+    case 1: // duplicate a token
+        if (te - ts > sizeof(tmp) - 1) break;
+        memcpy(tmp, data + ts, te - ts);
+        tmp[te - ts] = ' ';
+        return edit(data, size, max, ts, ts, tmp, te - ts + 1);
+    case 2: // insert a fragment before a token
+        return edit(data, size, max, ts, ts, (const uint8_t *)frag, strlen(frag));
+    case 3: // replace a token with a fragment
+        return edit(data, size, max, ts, te, (const uint8_t *)frag, strlen(frag));
+    case 4: { // move a token after a later one
+        const Node *u = &scratch.nodes[1 + rnd(ntok)];
+        size_t ue = NODE_END(u), n = te - ts;
+        if (ue <= te || n > sizeof(tmp)) break;
+        memcpy(tmp, data + ts, n);
+        size = edit(data, size, max, ue, ue, tmp, n);
+        return edit(data, size, max, ts, te, NULL, 0);
+    }
+    case 5: { // copy a run of tokens over another token
+        uint32_t first = 1 + rnd(ntok), last = first + rnd(8);
+        if (last > ntok) last = ntok;
+        size_t rs = scratch.nodes[first].start, re = NODE_END(&scratch.nodes[last]);
+        if (re - rs > sizeof(tmp)) break;
+        memcpy(tmp, data + rs, re - rs);
+        return edit(data, size, max, ts, te, tmp, re - rs);
+    }
+    default:
+        break;
+    }
+    // Byte-level fallback: flip, insert or delete one byte
+    size_t at = rnd((uint32_t)size + 1);
+    uint8_t byte = (uint8_t)rnd(256);
+    switch (rnd(3)) {
+    case 0:
+        if (at < size) data[at] ^= (uint8_t)(1u << rnd(8));
+        return size;
+    case 1:
+        return edit(data, size, max, at, at, &byte, 1);
+    default:
+        return at < size ? edit(data, size, max, at, at + 1, NULL, 0) : size;
+    }
+}
+
+#ifndef FUZZ_LIBFUZZER
+
+typedef struct {
+    uint8_t *data;
+    size_t   size;
+} Input;
+
+static Input *pool;
+static size_t pool_count, pool_cap;
+
+static void pool_add(const uint8_t *data, size_t size) {
+    if (pool_count == pool_cap) {
+        pool_cap = pool_cap ? pool_cap * 2 : 256;
+        pool = realloc(pool, pool_cap * sizeof(Input));
+        if (!pool) abort();
+    }
+    pool[pool_count].data = malloc(size ? size : 1);
+    if (!pool[pool_count].data) abort();
+    memcpy(pool[pool_count].data, data, size);
+    pool[pool_count++].size = size;
+}
+
+static void save(const char *dir, const uint8_t *data, size_t size) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%016llx.js", dir,
+             (unsigned long long)hash64(data, size, 0));
+    int fd = open(path, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) return; // already there
+    if (write(fd, data, size) != (ssize_t)size) unlink(path);
+    close(fd);
+}
+
+// Run one input and keep it when it reached something new
+static int try_input(const char *corpus, const uint8_t *data, size_t size, int persist) {
+    novel = 0;
+    LLVMFuzzerTestOneInput(data, size);
+    if (!novel) return 0;
+    pool_add(data, size);
+    if (persist) save(corpus, data, size);
+    return 1;
+}
+
+static void load(const char *corpus, const char *path, int persist, size_t max) {
+    struct stat st;
+    if (stat(path, &st) < 0) {
+        fprintf(stderr, "fuzz_lex: %s: %s\n", path, strerror(errno));
+        exit(1);
+    }
+    if (S_ISDIR(st.st_mode)) {
+        DIR *d = opendir(path);
+        if (!d) return;
+        struct dirent *de;
+        while ((de = readdir(d))) {
+            if (de->d_name[0] == '.') continue;
+            char sub[4096];
+            snprintf(sub, sizeof(sub), "%s/%s", path, de->d_name);
+            load(corpus, sub, persist, max);
+        }
+        closedir(d);
+        return;
+    }
+    Source src;
+    if (!S_ISREG(st.st_mode) || source_open(&src, path) < 0) return;
+    try_input(corpus, (const uint8_t *)src.data, src.len < max ? src.len : max, persist);
+    source_close(&src);
+}
+
+int main(int argc, char **argv) {
+    uint64_t iters = 100000, seed = (uint64_t)time(NULL);
+    size_t max = FUZZ_MAX_LEN;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:s:m:")) != -1) {
+        switch (opt) {
+        case 'n': iters = strtoull(optarg, NULL, 10); break;
+        case 's': seed = strtoull(optarg, NULL, 10); break;
+        case 'm': max = strtoull(optarg, NULL, 10); break;
+        default:
+            goto usage;
+        }
+    }
+    if (optind >= argc || max == 0 || max > FUZZ_MAX_INPUT) goto usage;
+
+    const char *corpus = argv[optind];
+    if (mkdir(corpus, 0755) < 0 && errno != EEXIST) {
+        fprintf(stderr, "fuzz_lex: %s: %s\n", corpus, strerror(errno));
+        return 1;
+    }
+    load(corpus, corpus, 0, max);
+    for (int i = optind + 1; i < argc; i++)
+        load(corpus, argv[i], 1, max);
+    if (!pool_count) {
+        const char *empty = "";
+        pool_add((const uint8_t *)empty, 0);
+    }
+    size_t initial = pool_count;
+
+    uint8_t *buf = malloc(max);
+    if (!buf) abort();
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    uint64_t bytes = 0;
+    for (uint64_t i = 0; i < iters; i++) {
+        const Input *in = &pool[(size_t)(seed + i * 0x9E3779B97F4A7C15ULL) % pool_count];
+        size_t size = in->size < max ? in->size : max;
+        memcpy(buf, in->data, size);
+        uint32_t rounds = 1 + (uint32_t)((seed ^ i) % 4);
+        for (uint32_t r = 0; r < rounds; r++)
+            size = LLVMFuzzerCustomMutator(buf, size, max, (unsigned)(seed + i * 4 + r));
+        try_input(corpus, buf, size, 1);
+        bytes += size;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double sec = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+    printf("fuzz_lex: %llu execs in %.2fs (%.0f/s, %.2f MB/s), corpus %zu (+%zu new)\n",
+           (unsigned long long)iters, sec, sec > 0 ? (double)iters / sec : 0.0,
+           sec > 0 ? (double)bytes / sec / 1e6 : 0.0, pool_count, pool_count - initial);
+    free(buf);
+    return 0;
+
+usage:
+    fprintf(stderr, "Usage: fuzz_lex [-n ITERS] [-s SEED] [-m MAXLEN] CORPUS [SEED...]\n");
+    return 1;
+}
+
+#endif
@@ -0,0 +1,246 @@
+#include "jsopt/lex.h"
+#include "jsopt/source.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Diff jsopt's tokens for FILE against the oxc oracle listing
+//
+//   ground-truth lex FILE > ORACLE; lexdiff FILE ORACLE
+//
+// ORACLE is the "  Kind start:end text" listing after "token_count:".
+// Both sides are canonicalized before comparing:
+//   - oxc's number kinds (Decimal, Hex, ...) are NUMBER, Str is STRING,
+//     contextual keywords jsopt doesn't have (of, get, ...) are IDENT
+//   - oxc lexes '>' alone (the parser joins >>, >=, ...), so every
+//     contiguous run of punctuators containing a '>' is compared as one
+//   - oxc's lexer has no parser context: it lexes a regex as Slash and a
+//     template continuation as RCurly. The comparison stops at jsopt's
+//     first REGEX, TEMPLATE_MID or TEMPLATE_TAIL.
+// Exit status: 0 equal, 1 mismatch (first difference printed), 2 error.
+
+typedef struct {
+    uint8_t  kind;
+    uint32_t start;
+    uint32_t end;
+} Tok;
+
+typedef struct {
+    Tok   *toks;
+    size_t count;
+    size_t cap;
+} TokList;
+
+typedef struct {
+    const char *name;
+    uint8_t     kind;
+} OxcKind;
+
+static const OxcKind OXC_KINDS[] = {
+    { "Ident", NODE_IDENT }, { "PrivateIdentifier", NODE_IDENT },
+    { "Str", NODE_STRING }, { "RegExp", NODE_REGEX },
+    { "Decimal", NODE_NUMBER }, { "Float", NODE_NUMBER },
+    { "Binary", NODE_NUMBER }, { "Octal", NODE_NUMBER }, { "Hex", NODE_NUMBER },
+    { "PositiveExponential", NODE_NUMBER }, { "NegativeExponential", NODE_NUMBER },
+    { "DecimalBigInt", NODE_NUMBER }, { "BinaryBigInt", NODE_NUMBER },
+    { "OctalBigInt", NODE_NUMBER }, { "HexBigInt", NODE_NUMBER },
+    { "NoSubstitutionTemplate", NODE_TEMPLATE_FULL },
+    { "TemplateHead", NODE_TEMPLATE_HEAD }, { "TemplateMiddle", NODE_TEMPLATE_MID },
+    { "TemplateTail", NODE_TEMPLATE_TAIL },
+    { "True", NODE_TRUE }, { "False", NODE_FALSE }, { "Null", NODE_NULL },
+    { "This", NODE_THIS }, { "Super", NODE_SUPER },
+
+    { "Async", NODE_KW_ASYNC }, { "Await", NODE_KW_AWAIT }, { "Break", NODE_KW_BREAK },
+    { "Case", NODE_KW_CASE }, { "Catch", NODE_KW_CATCH }, { "Class", NODE_KW_CLASS },
+    { "Const", NODE_KW_CONST }, { "Continue", NODE_KW_CONTINUE },
+    { "Debugger", NODE_KW_DEBUGGER }, { "Default", NODE_KW_DEFAULT },
+    { "Delete", NODE_KW_DELETE }, { "Do", NODE_KW_DO }, { "Else", NODE_KW_ELSE },
+    { "Export", NODE_KW_EXPORT }, { "Extends", NODE_KW_EXTENDS },
+    { "Finally", NODE_KW_FINALLY }, { "For", NODE_KW_FOR },
+    { "Function", NODE_KW_FUNCTION }, { "If", NODE_KW_IF }, { "Import", NODE_KW_IMPORT },
+    { "In", NODE_KW_IN }, { "Instanceof", NODE_KW_INSTANCEOF }, { "Let", NODE_KW_LET },
+    { "New", NODE_KW_NEW }, { "Return", NODE_KW_RETURN }, { "Static", NODE_KW_STATIC },
+    { "Switch", NODE_KW_SWITCH }, { "Throw", NODE_KW_THROW }, { "Try", NODE_KW_TRY },
+    { "Typeof", NODE_KW_TYPEOF }, { "Var", NODE_KW_VAR }, { "Void", NODE_KW_VOID },
+    { "While", NODE_KW_WHILE }, { "With", NODE_KW_WITH }, { "Yield", NODE_KW_YIELD },
+
+    { "LCurly", NODE_LBRACE }, { "RCurly", NODE_RBRACE },
+    { "LParen", NODE_LPAREN }, { "RParen", NODE_RPAREN },
+    { "LBrack", NODE_LBRACKET }, { "RBrack", NODE_RBRACKET },
+    { "Semicolon", NODE_SEMI }, { "Comma", NODE_COMMA }, { "Colon", NODE_COLON },
+    { "Dot", NODE_DOT }, { "Dot3", NODE_DOT_DOT_DOT }, { "Question", NODE_QUESTION },
+    { "QuestionDot", NODE_QUESTION_DOT }, { "Question2", NODE_QUESTION_QUESTION },
+    { "Arrow", NODE_ARROW_TOK },
+
+    { "Plus", NODE_PLUS }, { "Minus", NODE_MINUS }, { "Star", NODE_STAR },
+    { "Slash", NODE_SLASH }, { "Percent", NODE_PERCENT }, { "Star2", NODE_STAR_STAR },
+    { "Plus2", NODE_PLUS_PLUS }, { "Minus2", NODE_MINUS_MINUS },
+    { "LAngle", NODE_LT }, { "RAngle", NODE_GT }, { "LtEq", NODE_LT_EQ },
+    { "GtEq", NODE_GT_EQ }, { "Eq2", NODE_EQ_EQ }, { "Eq3", NODE_EQ_EQ_EQ },
+    { "Neq", NODE_BANG_EQ }, { "Neq2", NODE_BANG_EQ_EQ },
+    { "ShiftLeft", NODE_LT_LT }, { "ShiftRight", NODE_GT_GT },
+    { "ShiftRight3", NODE_GT_GT_GT }, { "Amp", NODE_AMP }, { "Pipe", NODE_PIPE },
+    { "Caret", NODE_CARET }, { "Tilde", NODE_TILDE }, { "Bang", NODE_BANG },
+    { "Amp2", NODE_AMP_AMP }, { "Pipe2", NODE_PIPE_PIPE },
+    { "Eq", NODE_EQ }, { "PlusEq", NODE_PLUS_EQ }, { "MinusEq", NODE_MINUS_EQ },
+    { "StarEq", NODE_STAR_EQ }, { "SlashEq", NODE_SLASH_EQ },
+    { "PercentEq", NODE_PERCENT_EQ }, { "Star2Eq", NODE_STAR_STAR_EQ },
+    { "ShiftLeftEq", NODE_LT_LT_EQ }, { "ShiftRightEq", NODE_GT_GT_EQ },
+    { "ShiftRight3Eq", NODE_GT_GT_GT_EQ }, { "AmpEq", NODE_AMP_EQ },
+    { "PipeEq", NODE_PIPE_EQ }, { "CaretEq", NODE_CARET_EQ },
+    { "Amp2Eq", NODE_AMP_AMP_EQ }, { "Pipe2Eq", NODE_PIPE_PIPE_EQ },
+    { "Question2Eq", NODE_QUESTION_QUESTION_EQ },
+    { "Eof", NODE_EOF },
+};
+
+#define OXC_KIND_COUNT (sizeof(OXC_KINDS) / sizeof(OXC_KINDS[0]))
+
+// Marks a merged punctuator run
+#define KIND_PUNCT_RUN 0xFF
+
+static void push(TokList *l, uint8_t kind, uint32_t start, uint32_t end) {
+    if (l->count == l->cap) {
+        l->cap = l->cap ? l->cap * 2 : 1024;
+        l->toks = realloc(l->toks, l->cap * sizeof(Tok));
+        if (!l->toks) {
+            fprintf(stderr, "jsopt: out of memory\n");
+            abort();
+        }
+    }
+    l->toks[l->count++] = (Tok){ kind, start, end };
+}
+
+// Unknown names are oxc keywords jsopt lexes as identifiers (of, get,
+// from, as, ...); anything else unknown will show up as a mismatch
+static uint8_t oxc_kind(const char *name) {
+    for (size_t i = 0; i < OXC_KIND_COUNT; i++)
+        if (!strcmp(OXC_KINDS[i].name, name)) return OXC_KINDS[i].kind;
+    return NODE_IDENT;
+}
+
+static int read_oracle(const char *path, TokList *out) {
+    FILE *f = strcmp(path, "-") ? fopen(path, "r") : stdin;
+    if (!f) return -1;
+    char line[512];
+    int in_tokens = 0;
+    while (fgets(line, sizeof(line), f)) {
+        size_t n = strlen(line);
+        int whole = n && line[n - 1] == '\n';
+        if (!strncmp(line, "token_count:", 12)) {
+            in_tokens = 1;
+        } else if (in_tokens && line[0] == ' ') {
+            char name[64];
+            unsigned start, end;
+            if (sscanf(line, " %63s %u:%u", name, &start, &end) == 3)
+                push(out, oxc_kind(name), start, end);
+        } else if (in_tokens && line[0] != ' ') {
+            in_tokens = 0;
+        }
+        // Skip the rest of an over-long token text
+        while (!whole && fgets(line, sizeof(line), f)) {
+            n = strlen(line);
+            whole = n && line[n - 1] == '\n';
+        }
+    }
+    if (f != stdin) fclose(f);
+    return 0;
+}
+
+static int is_punct(uint8_t k) {
+    return IS_PUNCT(k) || IS_OPERATOR(k);
+}
+
+// Merge contiguous punctuator runs that contain a '>'-led token into one
+// KIND_PUNCT_RUN spanning them all; drop everything from cut on
+static void canonicalize(TokList *l, const char *src, uint32_t cut) {
+    size_t w = 0;
+    for (size_t r = 0; r < l->count; r++) {
+        Tok t = l->toks[r];
+        if (t.start >= cut && t.kind != NODE_EOF) break;
+        if (t.kind == NODE_EOF && cut != UINT32_MAX) break;
+        if (is_punct(t.kind) && src[t.start] == '>') {
+            // Pull in contiguous punctuators before and after
+            while (w && is_punct(l->toks[w - 1].kind) && l->toks[w - 1].end == t.start)
+                t.start = l->toks[--w].start;
+            while (r + 1 < l->count && is_punct(l->toks[r + 1].kind) &&
+                   l->toks[r + 1].start == t.end && l->toks[r + 1].start < cut)
+                t.end = l->toks[++r].end;
+            t.kind = KIND_PUNCT_RUN;
+        } else if (w && l->toks[w - 1].kind == KIND_PUNCT_RUN && is_punct(t.kind) &&
+                   l->toks[w - 1].end == t.start) {
+            l->toks[w - 1].end = t.end;
+            continue;
+        }
+        l->toks[w++] = t;
+    }
+    l->count = w;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: lexdiff FILE ORACLE\n");
+        return 2;
+    }
+    Source src;
+    if (source_open(&src, argv[1]) < 0) {
+        fprintf(stderr, "lexdiff: %s: %s\n", argv[1], strerror(errno));
+        return 2;
+    }
+    TokList oxc = { NULL, 0, 0 }, ours = { NULL, 0, 0 };
+    if (read_oracle(argv[2], &oxc) < 0) {
+        fprintf(stderr, "lexdiff: %s: %s\n", argv[2], strerror(errno));
+        return 2;
+    }
+
+    NodeArray arr;
+    if (node_array_init(&arr, 0) < 0) return 2;
+    LexError err;
+    int rc = lex(&arr, src.data, src.len, NULL, NULL, &err);
+
+    // Without parser context the oracle is only comparable up to here;
+    // a lex error ends the comparison too (oxc recovers and goes on)
+    uint32_t cut = UINT32_MAX;
+    for (uint32_t i = 1; i < arr.count; i++) {
+        const Node *n = &arr.nodes[i];
+        if (n->kind == NODE_REGEX || n->kind == NODE_TEMPLATE_MID ||
+            n->kind == NODE_TEMPLATE_TAIL) {
+            cut = n->start;
+            break;
+        }
+        push(&ours, n->kind, n->start, NODE_END(n));
+    }
+    if (rc < 0 && err.pos < cut) cut = err.pos;
+
+    canonicalize(&ours, src.data, cut);
+    canonicalize(&oxc, src.data, cut);
+
+    int status = 0;
+    size_t n = ours.count < oxc.count ? ours.count : oxc.count;
+    for (size_t i = 0; i <= n && status == 0; i++) {
+        if (i == n) {
+            if (ours.count != oxc.count) {
+                printf("%s: token count differs: jsopt %zu, oxc %zu\n",
+                       argv[1], ours.count, oxc.count);
+                status = 1;
+            }
+            break;
+        }
+        const Tok *a = &ours.toks[i], *b = &oxc.toks[i];
+        if (a->kind != b->kind || a->start != b->start || a->end != b->end) {
+            printf("%s: token %zu differs: jsopt kind %u %u:%u, oxc kind %u %u:%u\n",
+                   argv[1], i, a->kind, a->start, a->end, b->kind, b->start, b->end);
+            status = 1;
+        }
+    }
+    if (status == 0)
+        printf("%s: %zu tokens match%s\n", argv[1], ours.count,
+               cut != UINT32_MAX ? " (compared up to the first regex, template or error)" : "");
+
+    free(ours.toks);
+    free(oxc.toks);
+    node_array_free(&arr);
+    source_close(&src);
+    return status;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Bump allocator for pass-local data (worklists, hash sets, scope stacks).
+// One virtual reservation like node_array_init, touched as used, so a
+// pass allocates without malloc and without locks: each worker owns its
+// arena, reuses it across files and empties it after each. Memory comes
+// back zeroed, as from calloc; nothing is freed individually.
+
+// Virtual reservation: 4 GB
+#define ARENA_RESERVE ((size_t)1 << 32)
+
+// Bytes kept resident across arena_reset: 1 MB
+#define ARENA_RESET_KEEP ((size_t)1 << 20)
+
+// Every allocation starts on this boundary
+#define ARENA_ALIGN 16
+
+typedef struct {
+    char  *base;
+    size_t used;     // bytes handed out
+    size_t high;     // bytes touched since the last reset
+    size_t reserved;
+} Arena;
+
+int  arena_init(Arena *a);
+void arena_free(Arena *a);
+// Empty the arena after a file. Touched bytes are re-zeroed: the first
+// ARENA_RESET_KEEP stay resident, the rest go back to the kernel.
+void arena_reset(Arena *a);
+
+// size zeroed bytes, ARENA_ALIGN-aligned. Aborts past ARENA_RESERVE.
+void *arena_alloc(Arena *a, size_t size);
+// Resize p (the arena's, old_size bytes) to new_size, in place when it is
+// the last allocation, else by copying to the end. New bytes are zero.
+void *arena_grow(Arena *a, void *p, size_t old_size, size_t new_size);
+
+#define ARENA_NEW(a, type, n) ((type *)arena_alloc((a), (size_t)(n) * sizeof(type)))
+
+// Checkpoints: everything allocated after arena_mark is released (and
+// zeroed) by arena_rewind, so a pass can drop per-function scratch data
+// and reuse the memory for the next function
+static inline size_t arena_mark(const Arena *a) {
+    return a->used;
+}
+
+void arena_rewind(Arena *a, size_t mark);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "jsopt/node.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define ASTFILE_VERSION 2
+
+// On-disk NodeArray: a 64-byte header followed by the nodes verbatim
+// (index 0 included), so a file maps back as a ready NodeArray without
+// any parsing. Files are native-endian; a foreign byte order fails the
+// header check like any other version mismatch.
+typedef struct {
+    char     magic[8];
+    uint32_t version;      // ASTFILE_VERSION
+    uint32_t kind_version; // NODE_KIND_VERSION
+    uint32_t kind_count;   // NODE_COUNT
+    uint32_t node_size;    // sizeof(Node)
+    uint32_t count;
+    uint32_t token_end;
+    uint32_t root;
+    uint32_t src_len;
+    uint64_t src_hash;     // hash64 of the source Node.start indexes into
+    uint64_t checksum;     // hash64 of the node payload
+    uint64_t reserved;
+} AstHeader;
+
+_Static_assert(sizeof(AstHeader) == 64, "AstHeader must be 64 bytes");
+
+// Mapped file. arr is a read-only view: capacity == count, so pushes
+// abort rather than write through. Copy with astfile_thaw to mutate.
+typedef struct {
+    NodeArray arr;
+    uint64_t  src_hash;
+    uint32_t  src_len;
+    void     *map;
+    size_t    map_size;
+} AstFile;
+
+// Skip the payload checksum and node_array_validate on load (header
+// checks still apply); only for files this process wrote
+#define ASTFILE_TRUST (1u << 0)
+
+// Write arr to fd. Returns 0, or -1 with errno set.
+int  astfile_write_fd(const NodeArray *arr, const char *src, uint32_t src_len, int fd);
+// Write to path via a temporary name and rename, so readers never map a
+// partial file.
+int  astfile_save(const NodeArray *arr, const char *src, uint32_t src_len,
+                  const char *path);
+// Map a file written by astfile_write_fd. Regular files are mapped in
+// place; pipes and sockets are read into an anonymous mapping. Returns 0,
+// or -1 with errno set (EINVAL for a bad header, checksum or tree).
+int  astfile_open_fd(AstFile *f, int fd, unsigned flags);
+int  astfile_open(AstFile *f, const char *path, unsigned flags);
+void astfile_close(AstFile *f);
+// Copy the mapped nodes into a fresh growable array (node_array_init)
+int  astfile_thaw(const AstFile *f, NodeArray *dst);
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+// Identifier interning shared by every worker of a batch, so passes that
+// look across files (bundle-wide mangling, export analysis) compare and
+// index names as integer atoms. ATOM_SHARDS independent open-addressing
+// tables, picked by the low hash bits; each keeps its own id counter, so
+// concurrent interns of different names rarely touch the same cache line.
+// Lock-free: a new name claims its empty slot with one CAS and publishes
+// its id with a release store; a reader that finds a claimed slot with its
+// own tag waits out that publish (a few stores) instead of taking a lock.
+#define ATOM_SHARD_BITS 6
+#define ATOM_SHARDS     (1u << ATOM_SHARD_BITS)
+
+// Atom 0 is never handed out
+#define ATOM_NULL 0
+
+// Name bytes are bump-allocated from one reservation, touched as used
+#define ATOM_MAX_BYTES ((uint64_t)1 << 32)
+
+typedef struct {
+    uint64_t offset; // name in bytes, NUL-terminated
+    uint32_t len;
+    uint32_t hash;   // low hash bits, for rehashing into per-pass tables
+} AtomEntry;
+
+typedef struct {
+    _Alignas(64) _Atomic uint32_t count; // ids handed out by this shard
+} AtomShard;
+
+typedef struct {
+    _Atomic uint64_t *slots;       // ATOM_SHARDS runs of shard_slots: tag << 32 | id
+    AtomEntry        *entries;     // by id
+    char             *bytes;
+    uint32_t          shard_slots; // power of two
+    uint32_t          shard_atoms; // ids per shard
+    _Atomic uint64_t  used;        // bytes handed out
+    AtomShard         shards[ATOM_SHARDS];
+} AtomTable;
+
+// Room for about capacity distinct names; interning past a shard's share
+// aborts like the node limit does. Memory is reserved, not committed: a
+// table costs what its names touch. Returns 0, or -1 with errno set.
+int      atom_table_init(AtomTable *t, uint32_t capacity);
+void     atom_table_free(AtomTable *t);
+
+// Atom of s[0, len), interned on first sight. Safe from any number of
+// threads; equal names always get the same atom.
+uint32_t atom_intern(AtomTable *t, const char *s, uint32_t len);
+// Atom of s[0, len) if interned, else ATOM_NULL
+uint32_t atom_find(const AtomTable *t, const char *s, uint32_t len);
+
+// Ids are sparse across shards (id - 1 = shard-local index << bits |
+// shard): arrays indexed by atom need atom_limit entries. Both are exact
+// only once interning has stopped.
+uint32_t atom_limit(const AtomTable *t);
+uint32_t atom_count(const AtomTable *t);
+
+static inline const char *atom_name(const AtomTable *t, uint32_t atom, uint32_t *len) {
+    const AtomEntry *e = &t->entries[atom];
+    if (len) *len = e->len;
+    return t->bytes + e->offset;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "jsopt/atom.h"
+#include "jsopt/node.h"
+
+// Scope hoisting: ES modules concatenated into one flat program instead of
+// one wrapper function per module, so the bundle starts without wrapper
+// calls and the mangler sees every top-level name at once.
+//
+// Each module is parser output over source lexed with the shared atom
+// table: root NODE_PROGRAM, children before parents, NODE_IMPORT ops
+// resolved to module indices. Module code is var / let / const
+// declarations and the other documented layouts; any other compound
+// (functions, classes, member access, patterns, ...) is rejected, as its
+// scopes and property names cannot be told from references yet.
+typedef struct {
+    const NodeArray *arr;
+    uint32_t         len; // source length
+} BundleModule;
+
+typedef struct {
+    uint32_t    module; // index into the modules argument
+    uint32_t    pos;    // byte offset in that module's source
+    const char *msg;    // static string
+} BundleError;
+
+// Concatenate count modules into out, which must be empty (count == 1).
+// Modules run in dependency order (imports first, input order otherwise,
+// cycles broken as ES evaluation does). Top-level bindings keep their
+// names unless another module declares or reads the same name, or a
+// block anywhere declares it; those are renamed name$N with atoms fresh
+// to the table. Imports are dropped and references to their locals
+// rewritten to the exporting binding's final atom; exports become plain
+// declarations. Tokens come first in out ([1, token_end)), then every
+// module's compounds, then the new NODE_PROGRAM root; token offsets
+// point into the module sources laid end to end in input order.
+// Identifier text comes from atoms: codegen prints NODE_IDENT through
+// atom_name. Returns the number of renamed bindings, or -1 with *err
+// filled (out is then unspecified).
+int bundle_concat(NodeArray *out, const BundleModule *modules, uint32_t count,
+                  AtomTable *atoms, BundleError *err);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Bump when output for the same source and options changes
+#define CACHE_FORMAT_VERSION 2
+
+// Persistent content-addressed output cache. Entries live in
+// dir/<2 hex>/<14 hex>, keyed by hash64(source, options); a hit maps the
+// stored output and source map and skips every compiler phase. Entries
+// also record the source length and a second hash of a different
+// construction, so a key collision is a miss rather than another file's
+// output. Writes go
+// to a temporary name and are renamed into place, so readers never see a
+// partial entry and concurrent writers of the same key are harmless.
+// Entry mtime is the LRU clock: hits refresh it and cache_prune evicts
+// the oldest entries once the directory exceeds max_bytes.
+typedef struct {
+    char            *dir;
+    uint64_t         max_bytes; // 0 = unbounded
+    _Atomic uint64_t hits;
+    _Atomic uint64_t misses;
+    _Atomic uint64_t stores;
+    _Atomic uint64_t evictions;
+} Cache;
+
+typedef struct {
+    const char *code;
+    uint32_t    code_len;
+    const char *map;
+    uint32_t    map_len;
+    void       *base;
+    size_t      size;
+} CacheEntry;
+
+// Creates dir if needed. Returns 0 on success, -1 with errno set.
+int      cache_open(Cache *c, const char *dir, uint64_t max_bytes);
+void     cache_close(Cache *c);
+uint64_t cache_key(const char *src, uint32_t len, uint64_t options);
+// 0 on hit (release the entry when done), -1 on miss
+int      cache_get(Cache *c, uint64_t key, const char *src, uint32_t src_len,
+                   CacheEntry *e);
+void     cache_entry_release(CacheEntry *e);
+int      cache_put(Cache *c, uint64_t key, const char *src, uint32_t src_len,
+                   const char *code, uint32_t code_len,
+                   const char *map, uint32_t map_len);
+// Evict least recently used entries until under max_bytes
+void     cache_prune(Cache *c);
+void     cache_stats_print(const Cache *c, FILE *out);
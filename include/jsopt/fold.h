@@ -0,0 +1,19 @@
+#pragma once
+
+#include "jsopt/node.h"
+
+// Boolean and conditional compression, in place on NODE_IF, NODE_TERNARY
+// and NODE_UNARY (op == NODE_BANG):
+//   if (a) b; else c;   ->  a ? b : c
+//   if (a) b;           ->  a && b        (if (!a) b  ->  a || b)
+//   !a ? b : c          ->  a ? c : b
+//   !0, !1              ->  true, false leaves
+//   true ? b : c        ->  b             (same for if)
+//   a ? (b ? x : y) : y ->  a && b ? x : y
+//   a ? x : (b ? x : y) ->  a || b ? x : y
+// A constant if's dropped branch leaves `var x;` behind for the vars it
+// declares (appended past the root), and the if stays when the branch
+// declares a function or may (statements without a layout, var
+// patterns). Only nodes reachable from arr->root are touched. src is the
+// source the leaf tokens index into. Returns the number of rewrites.
+uint32_t fold_conditionals(NodeArray *arr, const char *src);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 64-bit non-cryptographic hash in the xxh3 style: eight 64-bit lanes
+// consume 64-byte stripes with a 32x32->64 multiply, keyed by the
+// stripe's place in its block and scrambled every HASH_BLOCK_STRIPES
+// stripes. hash64 uses AVX-512 when built with it and
+// always returns the same value as hash64_scalar, so hashes persisted on
+// disk do not depend on the build.
+#define HASH_STRIPE        64
+#define HASH_BLOCK_STRIPES 16
+
+uint64_t hash64(const void *data, size_t len, uint64_t seed);
+uint64_t hash64_scalar(const void *data, size_t len, uint64_t seed);
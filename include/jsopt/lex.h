@@ -0,0 +1,86 @@
+#pragma once
+
+#include "jsopt/atom.h"
+#include "jsopt/node.h"
+#include <stdint.h>
+
+// Open template substitutions tracked at once: `${`a${`b${...}`}`}`
+#define LEX_TEMPLATE_DEPTH 64
+
+// Legal comment kept for codegen: one starting "/*!" or "//!", or one
+// containing @license or @preserve. Comments never become nodes; these
+// go to a side table instead, and codegen re-emits each, in order,
+// before the token at attach.
+typedef struct {
+    uint32_t start;  // the opening '/'
+    uint32_t end;    // past "*/", or at the line end of a line comment
+    uint32_t attach; // index of the token that follows (NODE_EOF at the end)
+} Comment;
+
+// Zero-initialized is empty; grows on demand and is reused across lex calls
+typedef struct {
+    Comment *items;
+    uint32_t count;
+    uint32_t capacity;
+} CommentTable;
+
+void comment_table_free(CommentTable *t);
+
+typedef struct {
+    uint32_t    pos;  // byte offset of the offending character
+    uint32_t    line; // 1-based
+    const char *msg;  // static string
+} LexError;
+
+// Tokenize src[0, len) into arr, which must be empty (count == 1). src
+// needs SOURCE_PADDING readable zero bytes past len (see source.h).
+// Emits one token node per token, with data[0] = 1-based start line,
+// then NODE_EOF at len, and sets arr->token_end. Comments and
+// whitespace produce no nodes; legal comments are recorded in comments
+// (emptied first) unless it is NULL. With atoms, each NODE_IDENT token
+// gets its name's atom in data[1] (escapes decoded, a private name with
+// its '#'); identifiers too long for op keep their end there instead and
+// are interned by whoever needs them. Keywords are not interned.
+// Returns 0, or -1 with *err filled.
+int lex(NodeArray *arr, const char *src, uint32_t len, CommentTable *comments,
+        AtomTable *atoms, LexError *err);
+
+// Same tokenizer built without fast paths (src/lex.c with
+// -DLEX_REFERENCE). Only linked into the fuzz targets, which require
+// both to produce identical arrays.
+int lex_reference(NodeArray *arr, const char *src, uint32_t len,
+                  CommentTable *comments, AtomTable *atoms, LexError *err);
+
+// One edit between two versions of a source: bytes [start, old_end) of
+// the old text became [start, new_end) of the new one, the rest is equal
+typedef struct {
+    uint32_t start;
+    uint32_t old_end;
+    uint32_t new_end;
+} LexEdit;
+
+// Tokens replaced by lex_edit: [first, first + removed) of the old array
+// became [first, first + added); later tokens are the old ones, moved by
+// added - removed with offsets and lines shifted. A parser re-parses the
+// statement list enclosing the range and keeps the rest.
+typedef struct {
+    uint32_t first;
+    uint32_t removed;
+    uint32_t added;
+} LexSplice;
+
+// Narrowest single edit turning old[0, old_len) into src[0, len): the
+// common prefix and suffix compared a word at a time
+void lex_diff(const char *old, uint32_t old_len, const char *src, uint32_t len,
+              LexEdit *edit);
+
+// Watch mode: update arr, lexed from the old source by lex or lex_edit
+// and not parsed yet (count == token_end), to the tokens of src after
+// edit, with the same comments table and atoms as before. Re-lexes from
+// the token before the edit until a token past it comes out equal to an
+// old one in the same lexer state, then shifts the old tokens after it
+// instead of lexing them; the result equals lex on src, comments
+// included. Fills *splice. Returns 0, or -1 with *err filled and arr and
+// comments left as they were (line 0 when the edit does not fit arr).
+int lex_edit(NodeArray *arr, const char *src, uint32_t len, const LexEdit *edit,
+             CommentTable *comments, AtomTable *atoms, LexSplice *splice, LexError *err);
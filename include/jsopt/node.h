@@ -17,6 +17,10 @@ _Static_assert(sizeof(Node) == 16, "Node must be 16 bytes");
 
 // NodeKind: explicit, stable enum values
 // Tokens 0-127, AST compounds 128-255
+// Bump NODE_KIND_VERSION whenever a value or a compound layout changes;
+// serialized arrays (astfile.h) from another version are rejected
+#define NODE_KIND_VERSION 3
+
 typedef enum {
     // Leaves: persist as AST nodes (0-15)
     NODE_IDENT = 0,
@@ -82,6 +86,10 @@ typedef enum {
 
     NODE_PROGRAM,
 
+    // Payload slot of an extension run (compounds with more than two
+    // children); not a node of its own
+    NODE_EXT,
+
     NODE_COUNT
 } NodeKind;
 
@@ -116,9 +124,68 @@ typedef enum {
 #define NODE_LEN(n)  (NODE_END(n) - (n)->start)
 #define TOKEN_END(n) (((n)->op == NODE_LEN_OVERFLOW) ? (n)->data[1] : (n)->start + (n)->op)
 
+// Compound layouts (parser contract, children precede parents; list runs
+// relinked by node_list_append may follow their owner)
+//   BINARY, ASSIGN      op = operator, data[0] = left, data[1] = right
+//   UNARY               op = operator, data[0] = operand
+//   EXPR_STMT           data[0] = expression
+//   BLOCK, PROGRAM,     list: data[0] = first element, data[1] = count
+//   SEQUENCE, VAR_DECL    (elements are contiguous copies, see node_reserve)
+//                         VAR_DECL flags: CONST, LET, or neither for var
+//   DECLARATOR          data[0] = binding, data[1] = init (0 if none)
+//   IF, TERNARY         data[0] = test, data[1] = run {consequent, alternate}
+//                         (IF alternate 0 if none)
+//   FOR                 data[0] = init, data[1] = run {test, update}, {body, 0}
+//                         (absent init, test, update are 0)
+//   TRY                 data[0] = block, data[1] = run {handler, finalizer}
+//                         (either may be 0, not both)
+//   IMPORT              list of IMPORT_SPEC copies; op = index of the source
+//                         module in the bundle, filled in by the resolver
+//   IMPORT_SPEC         data[0] = imported name, data[1] = local binding
+//   EXPORT              data[0] = exported declaration (VAR_DECL)
+// Compounds with more than two children keep the first in data[0] and the
+// rest, two per slot in child order, in a run of NODE_EXT slots reserved
+// just before the compound (node_push_ext); data[1] is the run's first
+// slot. One contiguous run instead of a chain of pairs: a pass reaches
+// every child with one prefetch and no pointer chasing.
+
+// NodeLayout: the layouts above as data, node_layout[kind]. Generic passes
+// (walk, liveness, parent links, validation) read children through it
+// instead of switching on kind. Tokens and kinds without a documented
+// layout are all NODE_FIELD_NONE with arity 0 (opaque).
+typedef enum {
+    NODE_FIELD_NONE = 0,  // not a node index (token line/end, unused)
+    NODE_FIELD_CHILD,     // child index (0 if optional and absent)
+    NODE_FIELD_EXT,       // first slot of the extension run
+    NODE_FIELD_LIST,      // first element of a contiguous list run
+    NODE_FIELD_COUNT,     // element count of that run
+} NodeField;
+
+#define NODE_ARITY_LIST   0xFF // children are the run data[0], data[1]
+#define NODE_LAYOUT_OP    (1 << 0) // op holds an operator kind or keyword operator
+
+typedef struct {
+    uint8_t field[2]; // NodeField of data[0], data[1]
+    uint8_t arity;    // children, or NODE_ARITY_LIST
+    uint8_t ext;      // NODE_EXT slots in the run at data[1], arity / 2
+    uint8_t optional; // bit i: child i may be 0
+    uint8_t flags;    // NODE_LAYOUT_*
+} NodeLayout;
+
+extern const NodeLayout node_layout[256];
+
+// Number of children of n (list length, or the kind's arity)
+static inline uint32_t node_child_count(const Node *n) {
+    uint8_t arity = node_layout[n->kind].arity;
+    return arity == NODE_ARITY_LIST ? n->data[1] : arity;
+}
+
 // Arena limit: 16M nodes = 256 MB virtual reservation
 #define NODE_MAX_NODES (1 << 24)
 
+// Nodes kept resident across node_array_reset: 64K nodes = 1 MB
+#define NODE_RESET_KEEP (1 << 16)
+
 // NodeArray
 typedef struct {
     Node    *nodes;
@@ -128,17 +195,77 @@ typedef struct {
     uint32_t root;
 } NodeArray;
 
+// Child i < node_child_count(n) of n, 0 for an absent optional child.
+// Extension runs are read through, so their NODE_EXT slots never show up.
+static inline uint32_t node_child(const NodeArray *arr, const Node *n, uint32_t i) {
+    const NodeLayout *l = &node_layout[n->kind];
+    if (l->arity == NODE_ARITY_LIST) return n->data[0] + i;
+    if (!l->ext || i == 0) return n->data[i];
+    i -= 1;
+    return arr->nodes[n->data[1] + (i >> 1)].data[i & 1];
+}
+
 // NodeArray API
 int      node_array_init(NodeArray *arr, uint32_t capacity);
 void     node_array_free(NodeArray *arr);
+// Empty the array for reuse (count = 1) keeping the reservation. Touched
+// slots are re-zeroed: the first NODE_RESET_KEEP stay resident, the rest
+// are handed back to the kernel.
+void     node_array_reset(NodeArray *arr);
+// Re-zero a mapping whose first used bytes may be non-zero and first
+// touched bytes resident: up to keep stays resident, whole pages past it
+// are released. The reset behind node_array_reset and arena_reset.
+void     node_mem_reset(void *base, size_t used, size_t touched, size_t keep);
 uint32_t node_push_token(NodeArray *arr, NodeKind kind,
                          uint32_t start, uint32_t len, uint32_t line);
 uint32_t node_push(NodeArray *arr, NodeKind kind, uint8_t flags,
                    uint16_t op, uint32_t start,
                    uint32_t d0, uint32_t d1);
+// Push a compound whose layout has an extension run: children[0] goes to
+// data[0], the other arity - 1 into fresh NODE_EXT slots reserved first.
+uint32_t node_push_ext(NodeArray *arr, NodeKind kind, uint8_t flags,
+                       uint16_t op, uint32_t start, const uint32_t *children);
 // Reserve count consecutive slots. Returns index of first.
 // Caller accounts for subsequent node_push (make_list reserves count+1).
 uint32_t node_reserve(NodeArray *arr, uint32_t count);
+// Append copies of the n nodes at src to the list run first/count.
+// A run that already ends at the tail grows in place; any other run is
+// relocated to the tail once. Returns the (possibly new) first index.
+uint32_t node_list_append(NodeArray *arr, uint32_t first, uint32_t count,
+                          uint32_t src, uint32_t n);
+// Mark every node reachable from arr->root (live must hold count bytes,
+// zeroed), extension slots included. Kinds without a documented layout
+// are treated as opaque.
+void     node_mark_live(const NodeArray *arr, uint8_t *live);
+// Parent index of every node reachable from arr->root, 0 for the root,
+// for extension slots and for unreachable nodes (parent must hold count
+// entries). Built on demand
+// so passes can walk upwards in O(1) without re-walking from the root.
+void     node_build_parents(const NodeArray *arr, uint32_t *parent);
+// Next child of the same parent in child order (list element k -> k+1,
+// node_child i -> i + 1), 0 for last children and unreachable nodes. Takes
+// the node_build_parents result as the liveness mask; one linear pass.
+void     node_build_siblings(const NodeArray *arr, const uint32_t *parent,
+                             uint32_t *next);
+
+// First violation found by node_array_validate
+typedef struct {
+    uint32_t    idx; // offending node (0 for array-wide problems)
+    const char *msg;
+} NodeError;
+
+// Check the invariants above. A linear pass over every slot (vectorized):
+// nodes[0] is the zero sentinel, [1, token_end) holds only token kinds,
+// past token_end only leaves and compounds, and overflowed tokens end past
+// their start. Then the tree from arr->root, dead slots ignored: children
+// in [1, count), present unless optional, never keyword, punctuation or
+// operator tokens nor bare NODE_EXT slots, each reached once, and before
+// their parent unless appended past the root by a pass (relinked runs,
+// pushed nodes); extension runs are NODE_EXT slots, list runs in bounds,
+// NODE_LAYOUT_OP ops are operators or in, instanceof, typeof, void and
+// delete. Returns 0, or -1 with the first violation in *err. Cheap enough
+// for staging; DEBUG builds of jsopt run it after every phase.
+int      node_array_validate(const NodeArray *arr, NodeError *err);
 
 // EMIT: lexer hot path for token emission
 // lex must have .nodes (NodeArray) and .line (uint32_t)
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+// Runs one job; worker is a stable id in [0, nthreads) for per-worker
+// state such as a recycled NodeArray. Returns 0 on success.
+typedef int (*PoolFn)(void *ctx, uint32_t worker, uint32_t job);
+
+// Run jobs 0..njobs-1 on up to nthreads threads (the caller's thread is
+// worker 0). Idle workers claim the next job from a shared cursor, so jobs
+// start in index order: sort largest-first to keep the tail short.
+// Returns the number of jobs that failed.
+uint32_t pool_run(uint32_t nthreads, uint32_t njobs, PoolFn fn, void *ctx);
+
+// Online CPUs, at least 1
+uint32_t pool_cpu_count(void);
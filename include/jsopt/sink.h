@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Bytes handed to the kernel per flush
+#define SINK_CHUNK (256u << 10)
+
+// Force plain write(2) even when io_uring is available
+#define SINK_SYNC (1u << 0)
+
+typedef struct SinkRing SinkRing;
+
+// Streaming output with two SINK_CHUNK buffers: while one is being
+// written the emitter fills the other, so output never has to exist in
+// full and I/O overlaps emission. Full buffers are submitted through
+// io_uring when the kernel allows it (one write in flight keeps them
+// ordered); otherwise they are written synchronously. Errors are sticky
+// and reported by sink_close.
+typedef struct {
+    int       fd;
+    char     *buf[2];
+    uint32_t  cur;      // buffer being filled
+    uint32_t  len;      // bytes in buf[cur]
+    uint32_t  inflight; // bytes of buf[cur ^ 1] submitted, 0 if idle
+    int       err;      // first errno seen
+    uint64_t  written;
+    SinkRing *ring;     // NULL: synchronous
+} Sink;
+
+// Returns 0, or -1 with errno set. fd stays owned by the caller.
+int  sink_open(Sink *s, int fd, unsigned flags);
+void sink_write(Sink *s, const void *data, size_t len);
+// Flush and wait for all output. Returns 0, or -1 with errno set to the
+// first failure.
+int  sink_close(Sink *s);
+
+// Flush buf[cur] and switch buffers; sink_putc calls it when full
+void sink_rotate(Sink *s);
+
+static inline void sink_putc(Sink *s, char c) {
+    if (__builtin_expect(s->len == SINK_CHUNK, 0)) sink_rotate(s);
+    s->buf[s->cur][s->len++] = c;
+}
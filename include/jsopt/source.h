@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Bytes guaranteed readable and zero past the end of every source, so the
+// lexer can issue full 64-byte loads without a scalar tail loop
+#define SOURCE_PADDING 64
+
+// Node.start is a 32-bit offset into data
+#define SOURCE_MAX_LEN (UINT32_MAX - SOURCE_PADDING)
+
+// Read-only source text. Regular files are mapped in place (zero-copy) with
+// anonymous zero pages behind them; pipes and stdin are read into a padded
+// anonymous buffer. data stays valid until source_close, so every Node.start
+// indexes the same bytes from lexing through codegen.
+typedef struct {
+    const char *data;
+    uint32_t    len;
+    void       *map;
+    size_t      map_size;
+} Source;
+
+// Open path ("-" for stdin). Returns 0 on success, -1 with errno set.
+int  source_open(Source *src, const char *path);
+// Read fd to EOF into a padded buffer. Does not close fd.
+int  source_read_fd(Source *src, int fd);
+void source_close(Source *src);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "jsopt/node.h"
+#include <stdint.h>
+#include <stdio.h>
+#ifdef JSOPT_STATS
+#include <x86intrin.h>
+#endif
+
+// Pipeline phases, in order. Names match `ground-truth bench` keys.
+typedef enum {
+    PHASE_READ, PHASE_LEX, PHASE_PARSE, PHASE_SCOPE,
+    PHASE_MANGLE, PHASE_CODEGEN, PHASE_WRITE, PHASE_COUNT
+} Phase;
+
+extern const char *const PHASE_NAMES[PHASE_COUNT];
+
+// Node classes, per the NodeKind ranges (EOF counts as punctuation)
+typedef enum {
+    NODE_CLASS_LEAF, NODE_CLASS_KEYWORD, NODE_CLASS_PUNCT,
+    NODE_CLASS_OPERATOR, NODE_CLASS_COMPOUND, NODE_CLASS_COUNT
+} NodeClass;
+
+// Per-worker counters, merged for the report. Phase cycles come from the
+// TSC and are only collected in -DJSOPT_STATS builds, so release builds
+// pay nothing on the hot path; the per-file fields are cheap and always
+// available. Cache-line aligned (and so padded to whole lines): workers
+// update their own Stats in an array without sharing lines.
+typedef struct {
+    _Alignas(64) uint64_t phase_cycles[PHASE_COUNT];
+    uint64_t mark;                  // TSC at the end of the last phase
+    uint64_t nodes[NODE_CLASS_COUNT];
+    uint64_t node_bytes;            // NodeArray bytes written, all files
+    uint32_t peak_nodes;            // largest count of any one file
+    uint32_t files;
+} Stats;
+
+#ifdef JSOPT_STATS
+// Start timing the first phase of a file
+static inline void stats_mark(Stats *s) {
+    if (s) s->mark = __rdtsc();
+}
+// Charge cycles since the last mark to phase
+static inline void stats_phase(Stats *s, Phase phase) {
+    if (!s) return;
+    uint64_t now = __rdtsc();
+    s->phase_cycles[phase] += now - s->mark;
+    s->mark = now;
+}
+#else
+#define stats_mark(s)         ((void)(s))
+#define stats_phase(s, phase) ((void)(s), (void)(phase))
+#endif
+
+// Record TSC and clock at startup to convert cycles for the report
+void stats_start(void);
+// Count the nodes of a finished file
+void stats_record_array(Stats *s, const NodeArray *arr);
+void stats_merge(Stats *dst, const Stats *src);
+// JSON object with phases (null without JSOPT_STATS), node classes,
+// bytes, peak count, page faults and peak RSS
+void stats_print_json(const Stats *s, FILE *out);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+// ID_Start / ID_Continue for code points >= 0x80 (ASCII is the lexer's
+// job). Two-level bitmaps generated into src/unicode.c by
+// tools/gen_unicode.py: cp >> 8 picks one of UNICODE_ID_BLOCKS shared
+// 256-bit blocks. Nothing at or past UNICODE_ID_LIMIT has either property.
+#define UNICODE_ID_LIMIT  0xE0200
+#define UNICODE_ID_BLOCKS 186
+
+extern const uint8_t  unicode_id_start[UNICODE_ID_LIMIT >> 8];
+extern const uint8_t  unicode_id_continue[UNICODE_ID_LIMIT >> 8];
+extern const uint64_t unicode_id_blocks[UNICODE_ID_BLOCKS][4];
+
+static inline int unicode_bit(const uint8_t *index, uint32_t cp) {
+    if (cp >= UNICODE_ID_LIMIT) return 0;
+    return (int)(unicode_id_blocks[index[cp >> 8]][(cp >> 6) & 3] >> (cp & 63) & 1);
+}
+
+static inline int unicode_is_id_start(uint32_t cp) {
+    return unicode_bit(unicode_id_start, cp);
+}
+
+static inline int unicode_is_id_continue(uint32_t cp) {
+    return unicode_bit(unicode_id_continue, cp);
+}
+
+// Decode the UTF-8 sequence at p into *cp. Returns its length, or 0 for
+// a malformed, overlong or surrogate sequence. Reads at most 4 bytes and
+// stops at the first bad one, so a zero terminator is never passed.
+static inline uint32_t unicode_utf8_decode(const uint8_t *p, uint32_t *cp) {
+    uint8_t c = p[0];
+    if (c < 0x80) {
+        *cp = c;
+        return 1;
+    }
+    uint32_t n = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC2 ? 2 : 0;
+    if (n == 0 || c > 0xF4) return 0;
+    uint32_t v = c & (0x7F >> n);
+    for (uint32_t i = 1; i < n; i++) {
+        if ((p[i] & 0xC0) != 0x80) return 0;
+        v = v << 6 | (p[i] & 0x3F);
+    }
+    static const uint32_t min[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+    if (v < min[n] || v > 0x10FFFF || (v >= 0xD800 && v <= 0xDFFF)) return 0;
+    *cp = v;
+    return n;
+}
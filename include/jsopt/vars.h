@@ -0,0 +1,13 @@
+#pragma once
+
+#include "jsopt/node.h"
+
+// Declaration merging over every live NODE_BLOCK / NODE_PROGRAM list:
+//   var a; var b;          ->  var a, b;      (same for let and const)
+//   var a; for (;;) ...    ->  for (var a;;) ...
+//   var a; for (var i;;)   ->  for (var a, i;;)
+// Hoisting only moves var (never let/const) and skips initializers that
+// could contain an `in` operator. Merged declarator lists are relinked
+// with node_list_append, so each declarator is copied at most once.
+// Returns the number of statements removed.
+uint32_t vars_merge(NodeArray *arr);
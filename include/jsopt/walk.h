@@ -0,0 +1,26 @@
+#pragma once
+
+#include "jsopt/node.h"
+
+// Frames kept on the C stack; deeper trees (minified a+a+a+... chains run
+// to 50k levels) continue on the heap
+#define WALK_INLINE_DEPTH 256
+
+typedef enum {
+    WALK_CONTINUE = 0,
+    WALK_SKIP,  // from pre: leave the children out (post still runs)
+    WALK_STOP,  // end the walk at once
+} WalkAction;
+
+// parent is 0 for the walk's root. Callbacks may rewrite the node at idx
+// in place: children are read from it as they are reached, so a pre that
+// replaces them has the new ones walked.
+typedef WalkAction (*WalkFn)(NodeArray *arr, uint32_t idx, uint32_t parent, void *ctx);
+
+// Depth-first walk of the subtree at root in child order, calling pre on
+// the way down and post on the way up (either may be NULL). Children are
+// found through node_child: extension runs are read through without
+// visiting their NODE_EXT slots, and absent optional children are
+// skipped. Iterative: no recursion
+// however deep the tree. Returns 1 if a callback stopped the walk, else 0.
+int walk(NodeArray *arr, uint32_t root, WalkFn pre, WalkFn post, void *ctx);
@@ -0,0 +1,67 @@
+#include "jsopt/arena.h"
+#include "jsopt/node.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+int arena_init(Arena *a) {
+    // Regular pages committed as touched; transparent huge pages where the
+    // kernel allows, without pinning a hugetlb reservation per worker
+    void *buf = mmap(NULL, ARENA_RESERVE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (buf == MAP_FAILED) return -1;
+    madvise(buf, ARENA_RESERVE, MADV_HUGEPAGE);
+    // mmap zeroes memory, no memset needed
+    *a = (Arena){ buf, 0, 0, ARENA_RESERVE };
+    return 0;
+}
+
+void arena_free(Arena *a) {
+    if (a->base) munmap(a->base, a->reserved);
+    memset(a, 0, sizeof(*a));
+}
+
+void arena_reset(Arena *a) {
+    // Bytes past used are zero already (rewind and shrinking clear them)
+    node_mem_reset(a->base, a->used, a->high, ARENA_RESET_KEEP);
+    a->used = 0;
+    a->high = 0;
+}
+
+void arena_rewind(Arena *a, size_t mark) {
+    // Rewound bytes are likely reused right away: clear, keep resident
+    if (a->used > mark) memset(a->base + mark, 0, a->used - mark);
+    a->used = mark;
+}
+
+// Hand out [at, at + size)
+static void *bump(Arena *a, size_t at, size_t size) {
+    if (at > a->reserved || size > a->reserved - at) {
+        fprintf(stderr, "jsopt: arena limit exceeded (%zu)\n", a->reserved);
+        abort();
+    }
+    a->used = at + size;
+    if (a->used > a->high) a->high = a->used;
+    return a->base + at;
+}
+
+void *arena_alloc(Arena *a, size_t size) {
+    return bump(a, (a->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1), size);
+}
+
+void *arena_grow(Arena *a, void *p, size_t old_size, size_t new_size) {
+    char *c = p;
+    if (c && c + old_size == a->base + a->used) {
+        if (new_size <= old_size) {
+            a->used -= old_size - new_size;
+            memset(c + new_size, 0, old_size - new_size);
+            return p;
+        }
+        return bump(a, (size_t)(c - a->base), new_size);
+    }
+    if (new_size <= old_size) return p;
+    void *q = arena_alloc(a, new_size);
+    if (old_size) memcpy(q, p, old_size);
+    return q;
+}
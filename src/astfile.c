@@ -0,0 +1,209 @@
+#include "jsopt/astfile.h"
+#include "jsopt/hash.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#define ASTFILE_MAGIC "JSOPTAST"
+
+static _Atomic uint64_t tmp_seq;
+
+static uint64_t payload_hash(const Node *nodes, uint32_t count) {
+    return hash64(nodes, (size_t)count * sizeof(Node), 0);
+}
+
+static int write_all(int fd, struct iovec *v, int iovcnt) {
+    while (iovcnt) {
+        ssize_t n = writev(fd, v, iovcnt);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        // Advance past fully written vectors
+        while (iovcnt && (size_t)n >= v->iov_len) {
+            n -= (ssize_t)v->iov_len;
+            v++;
+            iovcnt--;
+        }
+        if (iovcnt) {
+            v->iov_base = (char *)v->iov_base + n;
+            v->iov_len -= (size_t)n;
+        }
+    }
+    return 0;
+}
+
+static int read_all(int fd, void *buf, size_t len) {
+    char *p = buf;
+    while (len) {
+        ssize_t n = read(fd, p, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (n == 0) {
+            errno = EINVAL; // short file
+            return -1;
+        }
+        p   += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+int astfile_write_fd(const NodeArray *arr, const char *src, uint32_t src_len, int fd) {
+    AstHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, ASTFILE_MAGIC, 8);
+    h.version      = ASTFILE_VERSION;
+    h.kind_version = NODE_KIND_VERSION;
+    h.kind_count   = NODE_COUNT;
+    h.node_size    = sizeof(Node);
+    h.count        = arr->count;
+    h.token_end    = arr->token_end;
+    h.root         = arr->root;
+    h.src_len      = src_len;
+    h.src_hash     = hash64(src, src_len, 0);
+    h.checksum     = payload_hash(arr->nodes, arr->count);
+
+    struct iovec iov[2] = {
+        { &h, sizeof(h) },
+        { arr->nodes, (size_t)arr->count * sizeof(Node) },
+    };
+    return write_all(fd, iov, 2);
+}
+
+int astfile_save(const NodeArray *arr, const char *src, uint32_t src_len,
+                 const char *path) {
+    char tmp[4096];
+    int n = snprintf(tmp, sizeof(tmp), "%s.tmp-%ld-%llu", path, (long)getpid(),
+                     (unsigned long long)atomic_fetch_add(&tmp_seq, 1));
+    if (n < 0 || (size_t)n >= sizeof(tmp)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) return -1;
+
+    int rc = astfile_write_fd(arr, src, src_len, fd);
+    if (close(fd) < 0) rc = -1;
+    if (rc == 0 && rename(tmp, path) == 0) return 0;
+
+    int err = errno;
+    unlink(tmp);
+    errno = err;
+    return -1;
+}
+
+static int header_ok(const AstHeader *h) {
+    return !memcmp(h->magic, ASTFILE_MAGIC, 8) &&
+           h->version == ASTFILE_VERSION &&
+           h->kind_version == NODE_KIND_VERSION &&
+           h->kind_count == NODE_COUNT &&
+           h->node_size == sizeof(Node) &&
+           h->count >= 1 && h->count <= NODE_MAX_NODES &&
+           h->token_end <= h->count && h->root < h->count;
+}
+
+// Header and payload are in memory at base; fill f or fail with EINVAL.
+// A matching checksum only proves the bytes are the ones written, so
+// untrusted loads also validate the tree before anything walks it.
+static int finish_open(AstFile *f, void *base, size_t map_size, unsigned flags) {
+    const AstHeader *h = base;
+    const Node *nodes = (const Node *)((const char *)base + sizeof(AstHeader));
+    NodeArray view = { .nodes = (Node *)nodes, .count = h->count, .capacity = h->count,
+                       .token_end = h->token_end, .root = h->root };
+    NodeError err;
+    if (!(flags & ASTFILE_TRUST) && (payload_hash(nodes, h->count) != h->checksum ||
+                                     node_array_validate(&view, &err) < 0)) {
+        munmap(base, map_size);
+        errno = EINVAL;
+        return -1;
+    }
+    f->arr           = view;
+    f->src_hash      = h->src_hash;
+    f->src_len       = h->src_len;
+    f->map           = base;
+    f->map_size      = map_size;
+    return 0;
+}
+
+static int open_mapped(AstFile *f, int fd, size_t size, unsigned flags) {
+    if (size < sizeof(AstHeader)) {
+        errno = EINVAL;
+        return -1;
+    }
+    void *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    if (base == MAP_FAILED) return -1;
+    const AstHeader *h = base;
+    if (!header_ok(h) || sizeof(AstHeader) + (size_t)h->count * sizeof(Node) != size) {
+        munmap(base, size);
+        errno = EINVAL;
+        return -1;
+    }
+    return finish_open(f, base, size, flags);
+}
+
+// Pipes: read the header to size the mapping, then the payload behind it
+static int open_streamed(AstFile *f, int fd, unsigned flags) {
+    AstHeader h;
+    if (read_all(fd, &h, sizeof(h)) < 0) return -1;
+    if (!header_ok(&h)) {
+        errno = EINVAL;
+        return -1;
+    }
+    size_t size = sizeof(h) + (size_t)h.count * sizeof(Node);
+    char *base = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return -1;
+    memcpy(base, &h, sizeof(h));
+    if (read_all(fd, base + sizeof(h), size - sizeof(h)) < 0) {
+        int err = errno;
+        munmap(base, size);
+        errno = err;
+        return -1;
+    }
+    mprotect(base, size, PROT_READ);
+    return finish_open(f, base, size, flags);
+}
+
+int astfile_open_fd(AstFile *f, int fd, unsigned flags) {
+    memset(f, 0, sizeof(*f));
+    struct stat st;
+    if (fstat(fd, &st) < 0) return -1;
+    if (S_ISREG(st.st_mode))
+        return open_mapped(f, fd, (size_t)st.st_size, flags);
+    return open_streamed(f, fd, flags);
+}
+
+int astfile_open(AstFile *f, const char *path, unsigned flags) {
+    memset(f, 0, sizeof(*f));
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    int rc = astfile_open_fd(f, fd, flags);
+    int err = errno;
+    close(fd); // the mapping keeps its own reference
+    errno = err;
+    return rc;
+}
+
+void astfile_close(AstFile *f) {
+    if (f->map)
+        munmap(f->map, f->map_size);
+    memset(f, 0, sizeof(*f));
+}
+
+int astfile_thaw(const AstFile *f, NodeArray *dst) {
+    if (node_array_init(dst, 0) != 0) return -1;
+    memcpy(dst->nodes, f->arr.nodes, (size_t)f->arr.count * sizeof(Node));
+    dst->count     = f->arr.count;
+    dst->token_end = f->arr.token_end;
+    dst->root      = f->arr.root;
+    return 0;
+}
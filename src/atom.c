@@ -0,0 +1,157 @@
+#include "jsopt/atom.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define ATOM_SEED 0x61746f6d // "atom"
+
+// Claimed slots carry their tag with id 0 until the id is published
+#define SLOT_TAG(v) ((uint32_t)((v) >> 32))
+#define SLOT_ID(v)  ((uint32_t)(v))
+
+// Names are short (most under 16 bytes) and hashes never leave the
+// process, so a word-at-a-time multiply hash beats hash64's 64-byte
+// stripes here; the murmur3 finalizer spreads every input bit into the
+// low (shard) and high (tag) bits.
+static uint64_t atom_hash(const char *s, uint32_t len) {
+    const uint64_t k = 0x9E3779B97F4A7C15ULL;
+    uint64_t h = ATOM_SEED ^ (uint64_t)len * k, w;
+    for (; len >= 8; s += 8, len -= 8) {
+        memcpy(&w, s, 8);
+        h = (h ^ w) * k;
+        h ^= h >> 29;
+    }
+    w = 0;
+    memcpy(&w, s, len);
+    h = (h ^ w) * k;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    return h ^ h >> 33;
+}
+
+static void *reserve(size_t size) {
+    void *p = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return p == MAP_FAILED ? NULL : p;
+}
+
+static uint32_t pow2_at_least(uint32_t n) {
+    uint32_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+static size_t slots_size(const AtomTable *t) {
+    return (size_t)ATOM_SHARDS * t->shard_slots * sizeof(uint64_t);
+}
+
+static size_t entries_size(const AtomTable *t) {
+    return ((size_t)ATOM_SHARDS * t->shard_atoms + 1) * sizeof(AtomEntry);
+}
+
+int atom_table_init(AtomTable *t, uint32_t capacity) {
+    memset(t, 0, sizeof(*t));
+    // A quarter over the even share absorbs hash imbalance between shards;
+    // at most half of every shard's slots fill, keeping probes short
+    uint32_t share = capacity / ATOM_SHARDS + 1;
+    t->shard_atoms = share + share / 4 + 64;
+    t->shard_slots = pow2_at_least(2 * t->shard_atoms);
+    t->slots   = reserve(slots_size(t));
+    t->entries = reserve(entries_size(t));
+    t->bytes   = reserve(ATOM_MAX_BYTES);
+    if (!t->slots || !t->entries || !t->bytes) {
+        int saved = errno;
+        atom_table_free(t);
+        errno = saved;
+        return -1;
+    }
+    return 0;
+}
+
+void atom_table_free(AtomTable *t) {
+    if (t->slots) munmap((void *)t->slots, slots_size(t));
+    if (t->entries) munmap(t->entries, entries_size(t));
+    if (t->bytes) munmap(t->bytes, ATOM_MAX_BYTES);
+    memset(t, 0, sizeof(*t));
+}
+
+static void table_full(const char *what) {
+    fprintf(stderr, "jsopt: atom table full (%s)\n", what);
+    abort();
+}
+
+static int same_name(const AtomTable *t, uint32_t id, const char *s, uint32_t len) {
+    const AtomEntry *e = &t->entries[id];
+    return e->len == len && !memcmp(t->bytes + e->offset, s, len);
+}
+
+// Probe for s; on a miss with insert set, claim the empty slot and
+// publish a new atom there. Returns the atom, or ATOM_NULL on a miss.
+static uint32_t probe(AtomTable *t, const char *s, uint32_t len, int insert) {
+    uint64_t h = atom_hash(s, len);
+    uint32_t shard = (uint32_t)h & (ATOM_SHARDS - 1);
+    uint32_t mask = t->shard_slots - 1;
+    _Atomic uint64_t *slots = t->slots + (size_t)shard * t->shard_slots;
+    uint32_t tag = SLOT_TAG(h) | 1;
+
+    for (uint32_t i = (uint32_t)(h >> ATOM_SHARD_BITS) & mask, n = 0; n <= mask;
+         i = (i + 1) & mask, n++) {
+        uint64_t v = atomic_load_explicit(&slots[i], memory_order_acquire);
+        if (v == 0) {
+            if (!insert) return ATOM_NULL;
+            uint64_t claim = (uint64_t)tag << 32;
+            if (atomic_compare_exchange_strong_explicit(&slots[i], &v, claim,
+                                                        memory_order_acq_rel,
+                                                        memory_order_acquire)) {
+                uint32_t local = atomic_fetch_add_explicit(&t->shards[shard].count, 1,
+                                                           memory_order_relaxed);
+                if (local >= t->shard_atoms) table_full("atoms");
+                uint64_t off = atomic_fetch_add_explicit(&t->used, (uint64_t)len + 1,
+                                                         memory_order_relaxed);
+                if (off + len + 1 > ATOM_MAX_BYTES) table_full("bytes");
+                uint32_t id = (local << ATOM_SHARD_BITS | shard) + 1;
+                memcpy(t->bytes + off, s, len); // the reservation is zeroed: NUL is there
+                t->entries[id] = (AtomEntry){ off, len, (uint32_t)h };
+                atomic_store_explicit(&slots[i], claim | id, memory_order_release);
+                return id;
+            }
+            // Lost the slot; v is now the winner's, maybe this very name
+        }
+        if (SLOT_TAG(v) != tag) continue;
+        while (SLOT_ID(v) == 0) {
+            __builtin_ia32_pause();
+            v = atomic_load_explicit(&slots[i], memory_order_acquire);
+        }
+        if (same_name(t, SLOT_ID(v), s, len)) return SLOT_ID(v);
+    }
+    if (insert) table_full("slots");
+    return ATOM_NULL;
+}
+
+uint32_t atom_intern(AtomTable *t, const char *s, uint32_t len) {
+    return probe(t, s, len, 1);
+}
+
+uint32_t atom_find(const AtomTable *t, const char *s, uint32_t len) {
+    return probe((AtomTable *)t, s, len, 0);
+}
+
+uint32_t atom_limit(const AtomTable *t) {
+    uint32_t most = 0;
+    for (uint32_t i = 0; i < ATOM_SHARDS; i++) {
+        uint32_t n = atomic_load(&t->shards[i].count);
+        if (n > most) most = n;
+    }
+    return most ? ((most - 1) << ATOM_SHARD_BITS | (ATOM_SHARDS - 1)) + 2 : 1;
+}
+
+uint32_t atom_count(const AtomTable *t) {
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < ATOM_SHARDS; i++)
+        total += atomic_load(&t->shards[i].count);
+    return total;
+}
@@ -0,0 +1,469 @@
+#include "jsopt/bundle.h"
+#include "jsopt/walk.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t atom;
+    uint32_t final;    // atom it is emitted as
+    uint32_t exported;
+} Binding;
+
+typedef struct {
+    uint32_t local;    // atom
+    uint32_t from;     // exporting module
+    uint32_t imported; // atom
+    uint32_t spec;     // NODE_IMPORT_SPEC in out, for errors
+    uint32_t final;
+} Import;
+
+typedef struct {
+    uint32_t  root;     // the module's NODE_PROGRAM in out
+    uint32_t  src_base; // its source's offset in the concatenation
+    Binding  *binds;    // top-level bindings, sorted by atom once scanned
+    uint32_t  nbinds, cap_binds;
+    Import   *imports;  // sorted by local once scanned
+    uint32_t  nimports, cap_imports;
+    uint32_t *refs;     // NODE_IDENT tokens not under a block-scoped namesake
+    uint32_t  nrefs, cap_refs;
+} Module;
+
+typedef struct {
+    NodeArray          *out;
+    AtomTable          *atoms;
+    BundleError        *err;
+    const BundleModule *in;
+    uint32_t            count;
+    Module             *mods;
+    uint32_t           *order;   // evaluation order
+    uint32_t            limit;   // atom_limit before any renaming
+    uint8_t            *claimed; // by atom: name taken in the bundle scope
+    uint32_t           *shadow;  // by atom: enclosing block-scoped declarations
+    uint32_t            cur;     // module being scanned
+    uint32_t            suffix;  // last name$N handed out
+    char               *name;    // rename scratch
+    uint32_t            name_cap;
+} Bundle;
+
+static void *xrealloc(void *p, size_t n) {
+    p = realloc(p, n ? n : 1);
+    if (!p) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+    return p;
+}
+
+static void *xcalloc(size_t n, size_t size) {
+    void *p = calloc(n ? n : 1, size);
+    if (!p) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+    return p;
+}
+
+#define PUSH(items, n, cap, value) do { \
+    if ((n) == (cap)) { \
+        (cap) = (cap) ? (cap) * 2 : 16; \
+        (items) = xrealloc((items), (size_t)(cap) * sizeof(*(items))); \
+    } \
+    (items)[(n)++] = (value); \
+} while (0)
+
+static int fail(Bundle *b, uint32_t module, uint32_t pos, const char *msg) {
+    b->err->module = module;
+    b->err->pos    = pos;
+    b->err->msg    = msg;
+    return -1;
+}
+
+// Position of out node idx in its module's source
+static int fail_at(Bundle *b, uint32_t idx, const char *msg) {
+    return fail(b, b->cur, b->out->nodes[idx].start - b->mods[b->cur].src_base, msg);
+}
+
+static WalkAction stop(Bundle *b, uint32_t idx, const char *msg) {
+    fail_at(b, idx, msg);
+    return WALK_STOP;
+}
+
+static const Node *program_of(const BundleModule *m) {
+    const NodeArray *a = m->arr;
+    if (!NODE_VALID(a->root) || a->root >= a->count) return NULL;
+    const Node *p = &a->nodes[a->root];
+    if (p->kind != NODE_PROGRAM || p->data[1] > a->root || p->data[0] > a->root - p->data[1])
+        return NULL;
+    return p;
+}
+
+// Depth-first over the imports, each module after its dependencies; a
+// module already on the path (a cycle) counts as done, as in ES
+// evaluation
+static int order_modules(Bundle *b) {
+    uint8_t *seen = xcalloc(b->count, 1);
+    uint32_t *stack = xcalloc((size_t)b->count * 2, sizeof(uint32_t)); // module, next statement
+    uint32_t n = 0;
+    int rc = 0;
+    for (uint32_t r = 0; r < b->count && rc == 0; r++) {
+        if (seen[r]) continue;
+        uint32_t sp = 0;
+        stack[sp++] = r;
+        stack[sp++] = 0;
+        seen[r] = 1;
+        while (sp && rc == 0) {
+            uint32_t m = stack[sp - 2];
+            const NodeArray *a = b->in[m].arr;
+            const Node *prog = &a->nodes[a->root];
+            if (stack[sp - 1] == prog->data[1]) {
+                b->order[n++] = m;
+                sp -= 2;
+                continue;
+            }
+            const Node *s = &a->nodes[prog->data[0] + stack[sp - 1]++];
+            if (s->kind != NODE_IMPORT) continue;
+            if (s->op >= b->count) {
+                rc = fail(b, m, s->start, "import from a module outside the bundle");
+            } else if (!seen[s->op]) {
+                seen[s->op] = 1;
+                stack[sp++] = s->op;
+                stack[sp++] = 0;
+            }
+        }
+    }
+    free(seen);
+    free(stack);
+    return rc;
+}
+
+// Copy module m's tokens to tok and its compounds to cmp, rebasing child
+// indices and source offsets. Parser order (every child before its
+// parent) is what keeps the copy in order, so it is checked here.
+static int copy_module(Bundle *b, uint32_t m, uint32_t tok, uint32_t cmp) {
+    const NodeArray *a = b->in[m].arr;
+    uint32_t te = a->token_end > 1 ? a->token_end : 1;
+    uint32_t base = b->mods[m].src_base;
+#define REBASE(i) ((i) < te ? tok + (i) - 1 : cmp + (i) - te)
+    for (uint32_t i = 1; i < a->count; i++) {
+        Node n = a->nodes[i];
+        n.start += base;
+        if (IS_TOKEN(n.kind)) {
+            if (n.op == NODE_LEN_OVERFLOW) n.data[1] += base;
+        } else if (n.kind == NODE_EXT) {
+            for (int f = 0; f < 2; f++) {
+                if (!n.data[f]) continue;
+                if (n.data[f] >= i) return fail(b, m, a->nodes[i].start, "module not in parser order");
+                n.data[f] = REBASE(n.data[f]);
+            }
+        } else {
+            const NodeLayout *l = &node_layout[n.kind];
+            for (int f = 0; f < 2; f++) {
+                uint8_t field = l->field[f];
+                if (field == NODE_FIELD_NONE || field == NODE_FIELD_COUNT || !n.data[f]) continue;
+                uint32_t end = field == NODE_FIELD_LIST ? n.data[0] + n.data[1] - 1 : n.data[f];
+                if (end >= i) return fail(b, m, a->nodes[i].start, "module not in parser order");
+                if (field == NODE_FIELD_LIST && n.data[1] && (n.data[0] < te) != (end < te))
+                    return fail(b, m, a->nodes[i].start, "list run straddles token_end");
+                n.data[f] = REBASE(n.data[f]);
+            }
+        }
+        b->out->nodes[REBASE(i)] = n;
+    }
+    b->mods[m].root = REBASE(a->root);
+#undef REBASE
+    return 0;
+}
+
+// Atom of a NODE_IDENT token, 0 if it was not interned in this table
+static uint32_t ident_atom(const Bundle *b, const Node *n) {
+    if (n->kind != NODE_IDENT || n->op == NODE_LEN_OVERFLOW) return 0;
+    return n->data[1] < b->limit ? n->data[1] : 0;
+}
+
+// Enter (delta 1) or leave (-1) the block scope of a BLOCK or FOR: its
+// let and const names shadow the bundle scope, and are never handed to
+// a top-level binding, so no rewrite is captured by them
+static void scope(Bundle *b, const NodeArray *arr, const Node *n, int delta) {
+    uint32_t first = 0, count = 0;
+    if (n->kind == NODE_BLOCK) {
+        first = n->data[0];
+        count = n->data[1];
+    } else if (NODE_VALID(n->data[0])) {
+        first = n->data[0]; // FOR init
+        count = 1;
+    }
+    for (uint32_t k = 0; k < count; k++) {
+        const Node *s = &arr->nodes[first + k];
+        if (s->kind != NODE_VAR_DECL || !(s->flags & (NODE_FLAG_LET | NODE_FLAG_CONST))) continue;
+        for (uint32_t d = 0; d < s->data[1]; d++) {
+            uint32_t atom = ident_atom(b, &arr->nodes[arr->nodes[s->data[0] + d].data[0]]);
+            if (!atom) continue; // patterns are rejected by the walk
+            b->shadow[atom] += (uint32_t)delta;
+            b->claimed[atom] = 1;
+        }
+    }
+}
+
+static WalkAction scan_import(Bundle *b, const NodeArray *arr, uint32_t idx, uint32_t parent) {
+    Module *m = &b->mods[b->cur];
+    const Node *n = &arr->nodes[idx];
+    if (parent != m->root) return stop(b, idx, "import below the top level");
+    for (uint32_t k = 0; k < n->data[1]; k++) {
+        uint32_t spec = n->data[0] + k;
+        const Node *s = &arr->nodes[spec];
+        uint32_t imported = s->kind == NODE_IMPORT_SPEC ? ident_atom(b, &arr->nodes[s->data[0]]) : 0;
+        uint32_t local = s->kind == NODE_IMPORT_SPEC ? ident_atom(b, &arr->nodes[s->data[1]]) : 0;
+        if (!imported || !local)
+            return stop(b, spec, "unsupported import (default, namespace or not interned)");
+        Import imp = { local, n->op, imported, spec, 0 };
+        PUSH(m->imports, m->nimports, m->cap_imports, imp);
+    }
+    return WALK_SKIP; // specs are not references
+}
+
+static WalkAction scan_pre(NodeArray *arr, uint32_t idx, uint32_t parent, void *ctx) {
+    Bundle *b = ctx;
+    Module *m = &b->mods[b->cur];
+    const Node *n = &arr->nodes[idx];
+    switch (n->kind) {
+    case NODE_IDENT: {
+        uint32_t atom = ident_atom(b, n);
+        if (!atom) return stop(b, idx, "identifier not interned in the bundle's atom table");
+        if (!b->shadow[atom]) PUSH(m->refs, m->nrefs, m->cap_refs, idx);
+        return WALK_CONTINUE;
+    }
+    case NODE_IMPORT:
+        return scan_import(b, arr, idx, parent);
+    case NODE_EXPORT:
+        if (parent != m->root) return stop(b, idx, "export below the top level");
+        if (arr->nodes[n->data[0]].kind != NODE_VAR_DECL)
+            return stop(b, idx, "unsupported export");
+        return WALK_CONTINUE;
+    case NODE_VAR_DECL: {
+        // var is function-scoped: with no functions, every var is top-level
+        int exported = arr->nodes[parent].kind == NODE_EXPORT;
+        if ((n->flags & (NODE_FLAG_LET | NODE_FLAG_CONST)) && parent != m->root && !exported)
+            return WALK_CONTINUE;
+        for (uint32_t d = 0; d < n->data[1]; d++) {
+            uint32_t binding = arr->nodes[n->data[0] + d].data[0];
+            uint32_t atom = ident_atom(b, &arr->nodes[binding]);
+            if (!atom) return stop(b, binding, "unsupported binding pattern");
+            Binding bind = { atom, 0, (uint32_t)exported };
+            PUSH(m->binds, m->nbinds, m->cap_binds, bind);
+        }
+        return WALK_CONTINUE;
+    }
+    case NODE_BLOCK:
+    case NODE_FOR:
+        scope(b, arr, n, 1);
+        return WALK_CONTINUE;
+    default:
+        if (IS_COMPOUND(n->kind) && !node_layout[n->kind].arity &&
+            n->kind != NODE_EMPTY && n->kind != NODE_DEBUGGER)
+            return stop(b, idx, "unsupported node in module code");
+        return WALK_CONTINUE;
+    }
+}
+
+static WalkAction scan_post(NodeArray *arr, uint32_t idx, uint32_t parent, void *ctx) {
+    (void)parent;
+    const Node *n = &arr->nodes[idx];
+    if (n->kind == NODE_BLOCK || n->kind == NODE_FOR) scope(ctx, arr, n, -1);
+    return WALK_CONTINUE;
+}
+
+static int by_atom(const void *a, const void *b) {
+    uint32_t x = ((const Binding *)a)->atom, y = ((const Binding *)b)->atom;
+    return (x > y) - (x < y);
+}
+
+static int by_local(const void *a, const void *b) {
+    uint32_t x = ((const Import *)a)->local, y = ((const Import *)b)->local;
+    return (x > y) - (x < y);
+}
+
+static Binding *find_binding(const Module *m, uint32_t atom) {
+    Binding key = { atom, 0, 0 };
+    return m->nbinds ? bsearch(&key, m->binds, m->nbinds, sizeof(Binding), by_atom) : NULL;
+}
+
+static Import *find_import(const Module *m, uint32_t atom) {
+    Import key = { atom, 0, 0, 0, 0 };
+    return m->nimports ? bsearch(&key, m->imports, m->nimports, sizeof(Import), by_local) : NULL;
+}
+
+// Sort the bindings, merging redeclarations (var a; var a;)
+static void sort_bindings(Module *m) {
+    if (m->nbinds) qsort(m->binds, m->nbinds, sizeof(Binding), by_atom);
+    uint32_t w = 0;
+    for (uint32_t r = 0; r < m->nbinds; r++) {
+        if (w && m->binds[w - 1].atom == m->binds[r].atom)
+            m->binds[w - 1].exported |= m->binds[r].exported;
+        else
+            m->binds[w++] = m->binds[r];
+    }
+    m->nbinds = w;
+    if (m->nimports) qsort(m->imports, m->nimports, sizeof(Import), by_local);
+}
+
+// name$N for the first N whose atom does not exist yet: nothing in the
+// bundle (or anywhere else in the table) can be using it
+static uint32_t fresh_name(Bundle *b, uint32_t atom) {
+    uint32_t len;
+    const char *base = atom_name(b->atoms, atom, &len);
+    if (b->name_cap < len + 12) {
+        b->name_cap = len + 12;
+        b->name = xrealloc(b->name, b->name_cap);
+    }
+    for (;;) {
+        int n = snprintf(b->name, b->name_cap, "%.*s$%u", (int)len, base, ++b->suffix);
+        if (atom_find(b->atoms, b->name, (uint32_t)n) == ATOM_NULL)
+            return atom_intern(b->atoms, b->name, (uint32_t)n);
+    }
+}
+
+// The merged statement list: each module's, in evaluation order, without
+// imports and with exports unwrapped
+static uint32_t build_program(Bundle *b) {
+    NodeArray *out = b->out;
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < b->count; i++) {
+        const Node *p = &out->nodes[b->mods[i].root];
+        for (uint32_t k = 0; k < p->data[1]; k++)
+            total += out->nodes[p->data[0] + k].kind != NODE_IMPORT;
+    }
+    uint32_t first = node_reserve(out, total), w = first;
+    for (uint32_t i = 0; i < b->count; i++) {
+        const Node p = out->nodes[b->mods[b->order[i]].root];
+        for (uint32_t k = 0; k < p.data[1]; k++) {
+            const Node *s = &out->nodes[p.data[0] + k];
+            if (s->kind == NODE_IMPORT) continue;
+            out->nodes[w++] = s->kind == NODE_EXPORT ? out->nodes[s->data[0]] : *s;
+        }
+    }
+    return node_push(out, NODE_PROGRAM, 0, 0, 0, total ? first : 0, total);
+}
+
+static int concat(Bundle *b) {
+    NodeArray *out = b->out;
+    uint64_t tokens = 0, compounds = 0, stmts = 0, src = 0;
+    for (uint32_t i = 0; i < b->count; i++) {
+        const NodeArray *a = b->in[i].arr;
+        const Node *p = program_of(&b->in[i]);
+        if (!p) return fail(b, i, 0, "module root is not a program");
+        uint32_t te = a->token_end > 1 ? a->token_end : 1;
+        tokens += te - 1;
+        compounds += a->count - te;
+        // build_program copies these once more
+        for (uint32_t k = 0; k < p->data[1]; k++)
+            stmts += a->nodes[p->data[0] + k].kind != NODE_IMPORT;
+        b->mods[i].src_base = (uint32_t)src;
+        src += b->in[i].len;
+    }
+    if (src > UINT32_MAX) return fail(b, b->count - 1, 0, "bundle sources exceed 4 GB");
+    if (tokens + compounds + stmts + 1 > out->capacity - out->count)
+        return fail(b, 0, 0, "bundle exceeds the node limit");
+    if (order_modules(b) < 0) return -1;
+
+    // Every token first, then every module's compounds, both in
+    // evaluation order
+    uint32_t tok = node_reserve(out, (uint32_t)tokens);
+    uint32_t cmp = node_reserve(out, (uint32_t)compounds);
+    out->token_end = cmp;
+    for (uint32_t i = 0; i < b->count; i++) {
+        uint32_t m = b->order[i];
+        const NodeArray *a = b->in[m].arr;
+        uint32_t te = a->token_end > 1 ? a->token_end : 1;
+        if (copy_module(b, m, tok, cmp) < 0) return -1;
+        tok += te - 1;
+        cmp += a->count - te;
+    }
+
+    b->limit = atom_limit(b->atoms);
+    b->claimed = xcalloc(b->limit, 1);
+    b->shadow = xcalloc(b->limit, sizeof(uint32_t));
+    for (b->cur = 0; b->cur < b->count; b->cur++) {
+        if (walk(out, b->mods[b->cur].root, scan_pre, scan_post, b)) return -1;
+        sort_bindings(&b->mods[b->cur]);
+    }
+
+    // Names read without a binding in their module are globals (or typos):
+    // no top-level binding may take them over
+    for (uint32_t i = 0; i < b->count; i++) {
+        const Module *m = &b->mods[i];
+        for (uint32_t r = 0; r < m->nrefs; r++) {
+            uint32_t atom = out->nodes[m->refs[r]].data[1];
+            if (!find_binding(m, atom) && !find_import(m, atom)) b->claimed[atom] = 1;
+        }
+    }
+
+    // First declaration in evaluation order keeps the name
+    int renamed = 0;
+    for (uint32_t i = 0; i < b->count; i++) {
+        Module *m = &b->mods[b->order[i]];
+        for (uint32_t k = 0; k < m->nbinds; k++) {
+            Binding *bind = &m->binds[k];
+            if (b->claimed[bind->atom]) {
+                bind->final = fresh_name(b, bind->atom);
+                renamed++;
+            } else {
+                b->claimed[bind->atom] = 1;
+                bind->final = bind->atom;
+            }
+        }
+    }
+
+    for (b->cur = 0; b->cur < b->count; b->cur++) {
+        Module *m = &b->mods[b->cur];
+        for (uint32_t k = 0; k < m->nimports; k++) {
+            Import *imp = &m->imports[k];
+            const Binding *bind = find_binding(&b->mods[imp->from], imp->imported);
+            if (!bind || !bind->exported) return fail_at(b, imp->spec, "imported name is not exported");
+            imp->final = bind->final;
+        }
+    }
+
+    // Rewrite references through a scratch map, one module at a time
+    uint32_t *map = b->shadow; // back to all zero after the walks
+    for (uint32_t i = 0; i < b->count; i++) {
+        const Module *m = &b->mods[i];
+        for (uint32_t k = 0; k < m->nbinds; k++) map[m->binds[k].atom] = m->binds[k].final;
+        for (uint32_t k = 0; k < m->nimports; k++) map[m->imports[k].local] = m->imports[k].final;
+        for (uint32_t r = 0; r < m->nrefs; r++) {
+            Node *n = &out->nodes[m->refs[r]];
+            if (map[n->data[1]]) n->data[1] = map[n->data[1]];
+        }
+        for (uint32_t k = 0; k < m->nbinds; k++) map[m->binds[k].atom] = 0;
+        for (uint32_t k = 0; k < m->nimports; k++) map[m->imports[k].local] = 0;
+    }
+
+    out->root = build_program(b);
+    return renamed;
+}
+
+int bundle_concat(NodeArray *out, const BundleModule *modules, uint32_t count,
+                  AtomTable *atoms, BundleError *err) {
+    Bundle b = { 0 };
+    b.out   = out;
+    b.atoms = atoms;
+    b.err   = err;
+    b.in    = modules;
+    b.count = count;
+    b.mods  = xcalloc(count, sizeof(Module));
+    b.order = xcalloc(count, sizeof(uint32_t));
+
+    int rc = concat(&b);
+
+    for (uint32_t i = 0; i < count; i++) {
+        free(b.mods[i].binds);
+        free(b.mods[i].imports);
+        free(b.mods[i].refs);
+    }
+    free(b.mods);
+    free(b.order);
+    free(b.claimed);
+    free(b.shadow);
+    free(b.name);
+    return rc;
+}
@@ -0,0 +1,275 @@
+#include "jsopt/cache.h"
+#include "jsopt/hash.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+
+#define CACHE_MAGIC "JSOPTC\r\n"
+
+// Prune down to this fraction of max_bytes so every build doesn't evict
+#define CACHE_PRUNE_NUM 9
+#define CACHE_PRUNE_DEN 10
+
+// Temporaries older than this were left by a crashed writer
+#define CACHE_TMP_STALE_SEC 3600
+
+typedef struct {
+    char     magic[8];
+    uint64_t key;
+    uint32_t version;
+    uint32_t src_len;
+    uint32_t code_len;
+    uint32_t map_len;
+    uint64_t check;    // source_check of the source
+} CacheHeader;
+
+_Static_assert(sizeof(CacheHeader) == 40, "CacheHeader must be 40 bytes");
+
+static _Atomic uint64_t tmp_seq;
+
+// dir + "/xx/" + 14 hex + NUL, or a temporary name of similar length
+#define CACHE_PATH_EXTRA 64
+
+static void entry_path(const Cache *c, uint64_t key, char *buf, size_t n) {
+    snprintf(buf, n, "%s/%02x/%014llx", c->dir, (unsigned)(key >> 56),
+             (unsigned long long)(key & 0x00FFFFFFFFFFFFFFULL));
+}
+
+int cache_open(Cache *c, const char *dir, uint64_t max_bytes) {
+    memset(c, 0, sizeof(*c));
+    if (mkdir(dir, 0755) < 0 && errno != EEXIST) return -1;
+    c->dir = strdup(dir);
+    if (!c->dir) return -1;
+    c->max_bytes = max_bytes;
+    return 0;
+}
+
+void cache_close(Cache *c) {
+    free(c->dir);
+    c->dir = NULL;
+}
+
+uint64_t cache_key(const char *src, uint32_t len, uint64_t options) {
+    return hash64(src, len, options ^ ((uint64_t)CACHE_FORMAT_VERSION << 56));
+}
+
+// Second source hash, stored next to the key: a serial word-at-a-time
+// chain shares no structure with hash64's parallel lanes, so one input
+// pair colliding in both is as unlikely as two independent hashes
+static uint64_t source_check(const char *s, uint32_t len) {
+    const uint64_t k = 0x9E3779B97F4A7C15ULL;
+    uint64_t h = 0x6a736f7074ULL ^ (uint64_t)len * k, w; // "jsopt"
+    for (; len >= 8; s += 8, len -= 8) {
+        memcpy(&w, s, 8);
+        h = (h ^ w) * k;
+        h ^= h >> 29;
+    }
+    w = 0;
+    if (len) memcpy(&w, s, len);
+    h = (h ^ w) * k;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    return h ^ h >> 33;
+}
+
+int cache_get(Cache *c, uint64_t key, const char *src, uint32_t src_len, CacheEntry *e) {
+    memset(e, 0, sizeof(*e));
+    char path[4096];
+    entry_path(c, key, path, sizeof(path));
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) goto miss;
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(CacheHeader)) {
+        close(fd);
+        goto miss;
+    }
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        goto miss;
+    }
+
+    // Truncated or foreign entries are misses; the next put replaces them
+    const CacheHeader *h = base;
+    if (memcmp(h->magic, CACHE_MAGIC, 8) || h->key != key ||
+        h->version != CACHE_FORMAT_VERSION || h->src_len != src_len ||
+        sizeof(CacheHeader) + (uint64_t)h->code_len + h->map_len != (uint64_t)st.st_size ||
+        h->check != source_check(src, src_len)) {
+        munmap(base, (size_t)st.st_size);
+        close(fd);
+        goto miss;
+    }
+
+    futimens(fd, NULL); // LRU touch
+    close(fd);
+    e->base     = base;
+    e->size     = (size_t)st.st_size;
+    e->code     = (const char *)base + sizeof(CacheHeader);
+    e->code_len = h->code_len;
+    e->map      = e->code + h->code_len;
+    e->map_len  = h->map_len;
+    atomic_fetch_add_explicit(&c->hits, 1, memory_order_relaxed);
+    return 0;
+
+miss:
+    atomic_fetch_add_explicit(&c->misses, 1, memory_order_relaxed);
+    return -1;
+}
+
+void cache_entry_release(CacheEntry *e) {
+    if (e->base)
+        munmap(e->base, e->size);
+    memset(e, 0, sizeof(*e));
+}
+
+int cache_put(Cache *c, uint64_t key, const char *src, uint32_t src_len,
+              const char *code, uint32_t code_len,
+              const char *map, uint32_t map_len) {
+    char sub[4096], path[4096], tmp[4096 + CACHE_PATH_EXTRA];
+    snprintf(sub, sizeof(sub), "%s/%02x", c->dir, (unsigned)(key >> 56));
+    if (mkdir(sub, 0755) < 0 && errno != EEXIST) return -1;
+    entry_path(c, key, path, sizeof(path));
+    snprintf(tmp, sizeof(tmp), "%s/.tmp-%ld-%llu", sub, (long)getpid(),
+             (unsigned long long)atomic_fetch_add(&tmp_seq, 1));
+
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) return -1;
+
+    CacheHeader h;
+    memcpy(h.magic, CACHE_MAGIC, 8);
+    h.key      = key;
+    h.version  = CACHE_FORMAT_VERSION;
+    h.src_len  = src_len;
+    h.code_len = code_len;
+    h.map_len  = map_len;
+    h.check    = source_check(src, src_len);
+
+    struct iovec iov[3] = {
+        { &h, sizeof(h) },
+        { (void *)code, code_len },
+        { (void *)map, map_len },
+    };
+    size_t want = sizeof(h) + (size_t)code_len + map_len, done = 0;
+    int iovcnt = 3;
+    struct iovec *v = iov;
+    while (done < want) {
+        ssize_t n = writev(fd, v, iovcnt);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            goto fail;
+        }
+        done += (size_t)n;
+        // Advance past fully written vectors
+        while (iovcnt && (size_t)n >= v->iov_len) {
+            n -= (ssize_t)v->iov_len;
+            v++;
+            iovcnt--;
+        }
+        if (iovcnt) {
+            v->iov_base = (char *)v->iov_base + n;
+            v->iov_len -= (size_t)n;
+        }
+    }
+    if (close(fd) < 0) {
+        fd = -1;
+        goto fail;
+    }
+    if (rename(tmp, path) < 0) {
+        fd = -1;
+        goto fail;
+    }
+    atomic_fetch_add_explicit(&c->stores, 1, memory_order_relaxed);
+    return 0;
+
+fail:;
+    int err = errno;
+    if (fd >= 0) close(fd);
+    unlink(tmp);
+    errno = err;
+    return -1;
+}
+
+typedef struct {
+    char    *path;
+    uint64_t size;
+    int64_t  mtime_ns;
+} PruneEntry;
+
+static int by_mtime(const void *a, const void *b) {
+    int64_t x = ((const PruneEntry *)a)->mtime_ns, y = ((const PruneEntry *)b)->mtime_ns;
+    return (x > y) - (x < y);
+}
+
+void cache_prune(Cache *c) {
+    if (!c->max_bytes) return;
+
+    PruneEntry *ents = NULL;
+    size_t count = 0, cap = 0;
+    uint64_t total = 0;
+    time_t now = time(NULL);
+
+    for (unsigned b = 0; b < 256; b++) {
+        char sub[4096];
+        snprintf(sub, sizeof(sub), "%s/%02x", c->dir, b);
+        DIR *d = opendir(sub);
+        if (!d) continue;
+        struct dirent *de;
+        while ((de = readdir(d))) {
+            if (!strcmp(de->d_name, ".") || !strcmp(de->d_name, "..")) continue;
+            char path[sizeof(sub) + sizeof(de->d_name) + 1];
+            snprintf(path, sizeof(path), "%s/%s", sub, de->d_name);
+            struct stat st;
+            if (stat(path, &st) < 0 || !S_ISREG(st.st_mode)) continue;
+            if (de->d_name[0] == '.') {
+                if (now - st.st_mtime > CACHE_TMP_STALE_SEC) unlink(path);
+                continue;
+            }
+            if (count == cap) {
+                cap = cap ? cap * 2 : 1024;
+                PruneEntry *grown = realloc(ents, cap * sizeof(PruneEntry));
+                if (!grown) break;
+                ents = grown;
+            }
+            ents[count].path = strdup(path);
+            if (!ents[count].path) continue;
+            ents[count].size = (uint64_t)st.st_size;
+            ents[count].mtime_ns = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+            total += ents[count].size;
+            count++;
+        }
+        closedir(d);
+    }
+
+    if (total > c->max_bytes) {
+        uint64_t target = c->max_bytes / CACHE_PRUNE_DEN * CACHE_PRUNE_NUM;
+        qsort(ents, count, sizeof(PruneEntry), by_mtime);
+        for (size_t i = 0; i < count && total > target; i++) {
+            if (unlink(ents[i].path) == 0) {
+                total -= ents[i].size;
+                atomic_fetch_add_explicit(&c->evictions, 1, memory_order_relaxed);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+        free(ents[i].path);
+    free(ents);
+}
+
+void cache_stats_print(const Cache *c, FILE *out) {
+    uint64_t hits = atomic_load(&c->hits), misses = atomic_load(&c->misses);
+    uint64_t lookups = hits + misses;
+    fprintf(out, "cache: %llu hits, %llu misses (%.1f%% hit rate), %llu stored, %llu evicted\n",
+            (unsigned long long)hits, (unsigned long long)misses,
+            lookups ? 100.0 * (double)hits / (double)lookups : 0.0,
+            (unsigned long long)atomic_load(&c->stores),
+            (unsigned long long)atomic_load(&c->evictions));
+}
@@ -0,0 +1,301 @@
+#include "jsopt/fold.h"
+#include "jsopt/walk.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// Bound on structural comparison depth; deeper branches are never merged
+#define SAME_MAX_DEPTH 32
+
+static int is_not(const NodeArray *arr, uint32_t idx) {
+    const Node *n = &arr->nodes[idx];
+    return n->kind == NODE_UNARY && n->op == NODE_BANG;
+}
+
+// 1 = constant true, 0 = constant false, -1 = unknown
+static int truthiness(const NodeArray *arr, uint32_t idx) {
+    switch (arr->nodes[idx].kind) {
+    case NODE_TRUE:  return 1;
+    case NODE_FALSE: return 0;
+    case NODE_NULL:  return 0;
+    default:         return -1;
+    }
+}
+
+// Expression of an expression statement, or of a block holding only one
+static uint32_t stmt_expr(const NodeArray *arr, uint32_t idx) {
+    const Node *n = &arr->nodes[idx];
+    if (n->kind == NODE_BLOCK && n->data[1] == 1)
+        n = &arr->nodes[n->data[0]];
+    return n->kind == NODE_EXPR_STMT ? n->data[0] : NODE_NULL_IDX;
+}
+
+static int same_tree(const NodeArray *arr, const char *src,
+                     uint32_t a, uint32_t b, int depth) {
+    if (a == b) return 1;
+    if (!NODE_VALID(a) || !NODE_VALID(b) || depth == 0) return 0;
+    const Node *x = &arr->nodes[a], *y = &arr->nodes[b];
+    if (x->kind != y->kind) return 0;
+    if (x->kind >= NODE_TRUE && x->kind <= NODE_SUPER) return 1;
+    if (IS_TOKEN(x->kind)) {
+        uint32_t len = NODE_LEN(x);
+        return len == NODE_LEN(y) && !memcmp(src + x->start, src + y->start, len);
+    }
+    if (x->op != y->op || x->flags != y->flags) return 0;
+    switch (x->kind) {
+    case NODE_UNARY:
+        return same_tree(arr, src, x->data[0], y->data[0], depth - 1);
+    case NODE_BINARY:
+        return same_tree(arr, src, x->data[0], y->data[0], depth - 1) &&
+               same_tree(arr, src, x->data[1], y->data[1], depth - 1);
+    default:
+        return 0;
+    }
+}
+
+static void set_binary(Node *n, uint16_t op, uint32_t start,
+                       uint32_t left, uint32_t right) {
+    n->kind = NODE_BINARY; n->flags = 0; n->op = op; n->start = start;
+    n->data[0] = left; n->data[1] = right;
+}
+
+// !0 -> true, !1 -> false, !true -> false, !false -> true
+static uint32_t fold_bang(NodeArray *arr, const char *src, uint32_t idx) {
+    Node *n = &arr->nodes[idx];
+    const Node *v = &arr->nodes[n->data[0]];
+    NodeKind k;
+    if (v->kind == NODE_NUMBER && NODE_LEN(v) == 1 &&
+        (src[v->start] == '0' || src[v->start] == '1'))
+        k = src[v->start] == '0' ? NODE_TRUE : NODE_FALSE;
+    else if (v->kind == NODE_TRUE || v->kind == NODE_FALSE)
+        k = v->kind == NODE_TRUE ? NODE_FALSE : NODE_TRUE;
+    else
+        return 0;
+
+    // Leaf spans the whole "!0" so the token still maps back to source
+    uint32_t len = NODE_END(v) - n->start;
+    n->kind = k; n->flags = 0;
+    n->op = (len <= 0xFFFE) ? (uint16_t)len : NODE_LEN_OVERFLOW;
+    n->data[0] = 0;
+    n->data[1] = (len > 0xFFFE) ? n->start + len : 0;
+    return 1;
+}
+
+static uint32_t fold_ternary(NodeArray *arr, const char *src, uint32_t idx) {
+    Node *n = &arr->nodes[idx];
+    Node *e = &arr->nodes[n->data[1]];
+
+    int t = truthiness(arr, n->data[0]);
+    if (t >= 0) {
+        *n = arr->nodes[t ? e->data[0] : e->data[1]];
+        return 1;
+    }
+
+    uint32_t rewrites = 0;
+    if (is_not(arr, n->data[0])) {
+        n->data[0] = arr->nodes[n->data[0]].data[0];
+        uint32_t tmp = e->data[0];
+        e->data[0] = e->data[1];
+        e->data[1] = tmp;
+        rewrites++;
+    }
+
+    // Merging only removes nodes, so this terminates
+    for (;;) {
+        uint32_t x = e->data[0], y = e->data[1];
+        Node *xn = &arr->nodes[x], *yn = &arr->nodes[y];
+        if (xn->kind == NODE_TERNARY) {
+            // a ? (b ? x2 : y2) : y  with y2 == y
+            Node *xe = &arr->nodes[xn->data[1]];
+            if (same_tree(arr, src, xe->data[1], y, SAME_MAX_DEPTH)) {
+                e->data[0] = xe->data[0];
+                set_binary(xn, NODE_AMP_AMP, n->start, n->data[0], xn->data[0]);
+                n->data[0] = x;
+                rewrites++;
+                continue;
+            }
+        }
+        if (yn->kind == NODE_TERNARY) {
+            // a ? x : (b ? x2 : y2)  with x2 == x
+            Node *ye = &arr->nodes[yn->data[1]];
+            if (same_tree(arr, src, x, ye->data[0], SAME_MAX_DEPTH)) {
+                e->data[1] = ye->data[1];
+                set_binary(yn, NODE_PIPE_PIPE, n->start, n->data[0], yn->data[0]);
+                n->data[0] = y;
+                rewrites++;
+                continue;
+            }
+        }
+        break;
+    }
+    return rewrites;
+}
+
+// Names a dropped branch still declares for its whole function: var
+// bindings hoist out of it. Function declarations (Annex B), var patterns
+// and statements without a layout (which may hide either) block the fold.
+typedef struct {
+    uint32_t *names; // binding identifiers
+    uint32_t  count;
+    uint32_t  cap;
+    int       blocked;
+} Hoisted;
+
+static WalkAction hoist_pre(NodeArray *arr, uint32_t idx, uint32_t parent, void *ctx) {
+    (void)parent;
+    Hoisted *h = ctx;
+    const Node *n = &arr->nodes[idx];
+    switch (n->kind) {
+    case NODE_VAR_DECL:
+        if (n->flags & (NODE_FLAG_CONST | NODE_FLAG_LET)) break;
+        for (uint32_t i = 0; i < n->data[1]; i++) {
+            uint32_t id = arr->nodes[n->data[0] + i].data[0];
+            if (arr->nodes[id].kind != NODE_IDENT) {
+                h->blocked = 1;
+                return WALK_STOP;
+            }
+            if (h->count == h->cap) {
+                h->cap = h->cap ? h->cap * 2 : 8;
+                h->names = realloc(h->names, h->cap * sizeof(uint32_t));
+                if (!h->names) {
+                    fprintf(stderr, "jsopt: out of memory\n");
+                    abort();
+                }
+            }
+            h->names[h->count++] = id;
+        }
+        break;
+    case NODE_FUNC_DECL: case NODE_CLASS:
+    case NODE_WHILE: case NODE_DO_WHILE: case NODE_FOR_IN: case NODE_FOR_OF:
+    case NODE_SWITCH: case NODE_CASE: case NODE_CATCH: case NODE_WITH: case NODE_LABELED:
+        h->blocked = 1;
+        return WALK_STOP;
+    default:
+        break;
+    }
+    return WALK_CONTINUE;
+}
+
+// Replace the if at idx with pick (0: nothing) followed by a
+// declarator-only `var` of the hoisted names, appended past the root
+static void keep_vars(NodeArray *arr, uint32_t idx, uint32_t pick, const Hoisted *h) {
+    uint32_t start = arr->nodes[idx].start;
+    uint32_t first = node_reserve(arr, h->count);
+    for (uint32_t i = 0; i < h->count; i++) {
+        uint32_t id = h->names[i];
+        arr->nodes[first + i] = (Node){ NODE_DECLARATOR, 0, 0, arr->nodes[id].start, { id, 0 } };
+    }
+    Node decl = { NODE_VAR_DECL, 0, 0, start, { first, h->count } };
+    if (!NODE_VALID(pick)) {
+        arr->nodes[idx] = decl;
+        return;
+    }
+    uint32_t run = node_reserve(arr, 2);
+    arr->nodes[run] = arr->nodes[pick];
+    arr->nodes[run + 1] = decl;
+    arr->nodes[idx] = (Node){ NODE_BLOCK, 0, 0, start, { run, 2 } };
+}
+
+static uint32_t fold_if(NodeArray *arr, const char *src, uint32_t idx) {
+    Node *n = &arr->nodes[idx];
+    uint32_t ext = n->data[1];
+    Node *e = &arr->nodes[ext];
+
+    int t = truthiness(arr, n->data[0]);
+    if (t >= 0) {
+        uint32_t pick = t ? e->data[0] : e->data[1];
+        uint32_t drop = t ? e->data[1] : e->data[0];
+        Hoisted h = { NULL, 0, 0, 0 };
+        if (NODE_VALID(drop)) walk(arr, drop, hoist_pre, NULL, &h);
+        if (h.blocked || h.count) {
+            if (!h.blocked) keep_vars(arr, idx, pick, &h);
+            free(h.names);
+            return !h.blocked;
+        }
+        if (NODE_VALID(pick)) {
+            *n = arr->nodes[pick];
+        } else {
+            uint32_t start = n->start;
+            memset(n, 0, sizeof(*n));
+            n->kind = NODE_EMPTY;
+            n->start = start;
+        }
+        return 1;
+    }
+
+    uint32_t test = n->data[0];
+    uint32_t cons = e->data[0], alt = e->data[1];
+    uint32_t x = stmt_expr(arr, cons);
+    if (!NODE_VALID(alt)) {
+        if (!NODE_VALID(x)) return 0;
+        // if (a) b  ->  a && b;   if (!a) b  ->  a || b
+        uint16_t op = NODE_AMP_AMP;
+        if (is_not(arr, test)) {
+            op = NODE_PIPE_PIPE;
+            test = arr->nodes[test].data[0];
+        }
+        set_binary(e, op, n->start, test, x);
+        n->kind = NODE_EXPR_STMT; n->flags = 0; n->op = 0;
+        n->data[0] = ext; n->data[1] = 0;
+        return 1;
+    }
+
+    uint32_t y = stmt_expr(arr, alt);
+    if (!NODE_VALID(x) || !NODE_VALID(y)) return 0;
+
+    // if (a) b; else c;  ->  a ? b : c;
+    // The later branch slot follows both expressions, so it can hold the
+    // new payload without breaking child-before-parent order.
+    uint32_t pay = cons > alt ? cons : alt;
+    Node *p = &arr->nodes[pay];
+    memset(p, 0, sizeof(*p));
+    p->kind = NODE_EXT;
+    p->data[0] = x;
+    p->data[1] = y;
+
+    e->kind = NODE_TERNARY; e->flags = 0; e->op = 0; e->start = n->start;
+    e->data[0] = test;
+    e->data[1] = pay;
+
+    n->kind = NODE_EXPR_STMT; n->flags = 0; n->op = 0;
+    n->data[0] = ext; n->data[1] = 0;
+    return 1 + fold_ternary(arr, src, ext);
+}
+
+uint32_t fold_conditionals(NodeArray *arr, const char *src) {
+    if (!NODE_VALID(arr->root)) return 0;
+
+    // make_list leaves the original of every copied element behind, still
+    // pointing at the same children. Rewriting a dead original in place
+    // would corrupt its live copy, so only reachable nodes are visited.
+    uint8_t *live = calloc(arr->count, 1);
+    if (!live) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+    node_mark_live(arr, live);
+
+    // Post-order: every node is visited after its (already folded)
+    // children. Nodes keep_vars appends are never folded.
+    uint32_t rewrites = 0, end = arr->count;
+    for (uint32_t i = 1; i < end; i++) {
+        if (!live[i]) continue;
+        Node *n = &arr->nodes[i];
+        switch (n->kind) {
+        case NODE_UNARY:
+            if (n->op == NODE_BANG) rewrites += fold_bang(arr, src, i);
+            break;
+        case NODE_TERNARY:
+            rewrites += fold_ternary(arr, src, i);
+            break;
+        case NODE_IF:
+            rewrites += fold_if(arr, src, i);
+            break;
+        default:
+            break;
+        }
+    }
+
+    free(live);
+    return rewrites;
+}
@@ -0,0 +1,153 @@
+#include "jsopt/hash.h"
+#include <string.h>
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+#define P32_1 0x9E3779B1U
+#define P64_1 0x9E3779B185EBCA87ULL
+#define P64_2 0xC2B2AE3D27D4EB4FULL
+#define P64_3 0x165667B19E3779F9ULL
+
+__extension__ typedef unsigned __int128 u128;
+
+// The xxh3 default secret. Stripe s of a block keys its lanes with
+// entries s..s+7, as xxh3 offsets its secret by 8 bytes per stripe, so
+// stripes are not interchangeable within a block; the scramble uses the
+// last eight.
+#define SECRET_LEN (HASH_BLOCK_STRIPES + 8)
+static const uint64_t SECRET[SECRET_LEN] = {
+    0xbe4ba423396cfeb8ULL, 0x1cad21f72c81017cULL,
+    0xdb979083e96dd4deULL, 0x1f67b3b7a4a44072ULL,
+    0x78e5c0cc4ee679cbULL, 0x2172ffcc7dd05a82ULL,
+    0x8e2443f7744608b8ULL, 0x4c263a81e69035e0ULL,
+    0xcb00c391bb52283cULL, 0xa32e531b8b65d088ULL,
+    0x4ef90da297486471ULL, 0xd8acdea946ef1938ULL,
+    0x3f349ce33f76faa8ULL, 0x1d4f0bc7c7bbdcf9ULL,
+    0x3159b4cd4be0518aULL, 0x647378d9c97e9fc8ULL,
+    0xc3ebd33483acc5eaULL, 0xeb6313faffa081c5ULL,
+    0x49daf0b751dd0d17ULL, 0x9e68d429265516d3ULL,
+    0xfca1477d58be162bULL, 0xce31d07ad1b8f88fULL,
+    0x280416958f3acb45ULL, 0x7e404bbbcafbd7afULL,
+};
+
+#define SCRAMBLE_KEY (SECRET_LEN - 8)
+
+static uint64_t read64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static uint64_t mul_fold(uint64_t a, uint64_t b) {
+    u128 p = (u128)a * b;
+    return (uint64_t)p ^ (uint64_t)(p >> 64);
+}
+
+static uint64_t avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= P64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+static void keys_init(uint64_t key[SECRET_LEN], uint64_t seed) {
+    for (int i = 0; i < SECRET_LEN; i++)
+        key[i] = SECRET[i] ^ seed;
+}
+
+static void stripe_scalar(uint64_t acc[8], const unsigned char *p, const uint64_t key[8]) {
+    for (int i = 0; i < 8; i++) {
+        uint64_t d  = read64(p + 8 * i);
+        uint64_t dk = d ^ key[i];
+        acc[i ^ 1] += d;
+        acc[i] += (dk & 0xFFFFFFFFu) * (dk >> 32);
+    }
+}
+
+static void scramble_scalar(uint64_t acc[8], const uint64_t key[8]) {
+    for (int i = 0; i < 8; i++) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= key[i];
+        acc[i] = a * P32_1;
+    }
+}
+
+// Bulk of the input: whole stripes, scrambling after every block
+static size_t accumulate_scalar(uint64_t acc[8], const unsigned char *p, size_t len,
+                                const uint64_t key[SECRET_LEN]) {
+    size_t stripes = len / HASH_STRIPE;
+    for (size_t s = 0; s < stripes; s++) {
+        stripe_scalar(acc, p + s * HASH_STRIPE, key + s % HASH_BLOCK_STRIPES);
+        if ((s + 1) % HASH_BLOCK_STRIPES == 0) scramble_scalar(acc, key + SCRAMBLE_KEY);
+    }
+    return stripes * HASH_STRIPE;
+}
+
+#ifdef __AVX512F__
+static size_t accumulate_avx512(uint64_t acc_out[8], const unsigned char *p, size_t len,
+                                const uint64_t key_in[SECRET_LEN]) {
+    size_t stripes = len / HASH_STRIPE;
+    __m512i acc  = _mm512_loadu_si512((const void *)acc_out);
+    __m512i skey = _mm512_loadu_si512((const void *)(key_in + SCRAMBLE_KEY));
+    __m512i prime = _mm512_set1_epi64(P32_1);
+    for (size_t s = 0; s < stripes; s++) {
+        __m512i key = _mm512_loadu_si512((const void *)(key_in + s % HASH_BLOCK_STRIPES));
+        __m512i d  = _mm512_loadu_si512((const void *)(p + s * HASH_STRIPE));
+        __m512i dk = _mm512_xor_si512(d, key);
+        // acc[i ^ 1] += d: swap adjacent 64-bit lanes
+        __m512i sw = _mm512_shuffle_epi32(d, (_MM_PERM_ENUM)_MM_SHUFFLE(1, 0, 3, 2));
+        __m512i pr = _mm512_mul_epu32(dk, _mm512_srli_epi64(dk, 32));
+        acc = _mm512_add_epi64(acc, _mm512_add_epi64(sw, pr));
+        if ((s + 1) % HASH_BLOCK_STRIPES == 0) {
+            acc = _mm512_xor_si512(acc, _mm512_srli_epi64(acc, 47));
+            acc = _mm512_xor_si512(acc, skey);
+            // 64x32 multiply: lo * P + (hi * P) << 32
+            __m512i lo = _mm512_mul_epu32(acc, prime);
+            __m512i hi = _mm512_mul_epu32(_mm512_srli_epi64(acc, 32), prime);
+            acc = _mm512_add_epi64(lo, _mm512_slli_epi64(hi, 32));
+        }
+    }
+    _mm512_storeu_si512((void *)acc_out, acc);
+    return stripes * HASH_STRIPE;
+}
+#endif
+
+static uint64_t finish(uint64_t acc[8], const unsigned char *p, size_t done,
+                       size_t len, const uint64_t key[SECRET_LEN]) {
+    // Final partial stripe, zero padded, keyed by its place in the block
+    unsigned char tail[HASH_STRIPE] = {0};
+    memcpy(tail, p + done, len - done);
+    stripe_scalar(acc, tail, key + done / HASH_STRIPE % HASH_BLOCK_STRIPES);
+
+    uint64_t h = (uint64_t)len * P64_1;
+    for (int i = 0; i < 8; i += 2)
+        h += mul_fold(acc[i] ^ key[i + 1], acc[i + 1] ^ key[i] ^ P64_2);
+    return avalanche(h);
+}
+
+static void acc_init(uint64_t acc[8]) {
+    acc[0] = P32_1; acc[1] = P64_1; acc[2] = P64_2; acc[3] = P64_3;
+    acc[4] = P64_2 ^ P64_3; acc[5] = P32_1 ^ P64_1; acc[6] = ~P64_1; acc[7] = ~P64_3;
+}
+
+uint64_t hash64_scalar(const void *data, size_t len, uint64_t seed) {
+    uint64_t acc[8], key[SECRET_LEN];
+    acc_init(acc);
+    keys_init(key, seed);
+    size_t done = accumulate_scalar(acc, data, len, key);
+    return finish(acc, data, done, len, key);
+}
+
+uint64_t hash64(const void *data, size_t len, uint64_t seed) {
+#ifdef __AVX512F__
+    uint64_t acc[8], key[SECRET_LEN];
+    acc_init(acc);
+    keys_init(key, seed);
+    size_t done = accumulate_avx512(acc, data, len, key);
+    return finish(acc, data, done, len, key);
+#else
+    return hash64_scalar(data, len, seed);
+#endif
+}
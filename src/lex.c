@@ -0,0 +1,1177 @@
+#include "jsopt/lex.h"
+#include "jsopt/unicode.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The reference build keeps only the scalar paths; fuzz/fuzz_lex.c links
+// both and diffs them
+#ifdef LEX_REFERENCE
+#define lex lex_reference
+#elif defined(__AVX512BW__)
+#define LEX_SIMD 1
+#include <immintrin.h>
+#endif
+
+// lex_edit: the old tokens past the restart, walked alongside the re-lex
+// with the template state after each
+typedef struct {
+    const Node *old;
+    uint32_t    next;  // first old token not walked past yet
+    uint32_t    last;  // old NODE_EOF, never matched
+    uint32_t    from;  // new tokens starting here or later have unchanged text
+    uint32_t    delta; // new minus old offset past the edit (mod 2^32)
+    uint32_t    match; // old token the re-lex resynchronized on, 0 if none
+    uint32_t    braces;
+    uint32_t    depth;
+    uint32_t    saved[LEX_TEMPLATE_DEPTH];
+} EditSync;
+
+typedef struct {
+    NodeArray      nodes; // EMIT target, copied back to the caller's array
+    uint32_t       line;
+    const uint8_t *src;
+    uint32_t       len;
+    uint32_t       pos;
+    uint32_t       braces; // open '{' in the innermost substitution
+    uint32_t       depth;  // open substitutions
+    uint32_t       saved[LEX_TEMPLATE_DEPTH]; // braces of the enclosing ones
+    CommentTable  *comments; // NULL: legal comments are not collected
+    AtomTable     *atoms;    // NULL: identifiers are not interned
+    EditSync      *sync;     // NULL: lex to the end
+    LexError      *err;
+} Lexer;
+
+typedef struct {
+    const char *name;
+    uint8_t     len;
+    uint8_t     kind;
+} Keyword;
+
+// Sorted by first letter; KW_FIRST indexes the first entry per letter
+static const Keyword KEYWORDS[] = {
+    { "async", 5, NODE_KW_ASYNC }, { "await", 5, NODE_KW_AWAIT },
+    { "break", 5, NODE_KW_BREAK },
+    { "case", 4, NODE_KW_CASE }, { "catch", 5, NODE_KW_CATCH },
+    { "class", 5, NODE_KW_CLASS }, { "const", 5, NODE_KW_CONST },
+    { "continue", 8, NODE_KW_CONTINUE },
+    { "debugger", 8, NODE_KW_DEBUGGER }, { "default", 7, NODE_KW_DEFAULT },
+    { "delete", 6, NODE_KW_DELETE }, { "do", 2, NODE_KW_DO },
+    { "else", 4, NODE_KW_ELSE }, { "export", 6, NODE_KW_EXPORT },
+    { "extends", 7, NODE_KW_EXTENDS },
+    { "false", 5, NODE_FALSE }, { "finally", 7, NODE_KW_FINALLY },
+    { "for", 3, NODE_KW_FOR }, { "function", 8, NODE_KW_FUNCTION },
+    { "if", 2, NODE_KW_IF }, { "import", 6, NODE_KW_IMPORT },
+    { "in", 2, NODE_KW_IN }, { "instanceof", 10, NODE_KW_INSTANCEOF },
+    { "let", 3, NODE_KW_LET },
+    { "new", 3, NODE_KW_NEW }, { "null", 4, NODE_NULL },
+    { "return", 6, NODE_KW_RETURN },
+    { "static", 6, NODE_KW_STATIC }, { "super", 5, NODE_SUPER },
+    { "switch", 6, NODE_KW_SWITCH },
+    { "this", 4, NODE_THIS }, { "throw", 5, NODE_KW_THROW },
+    { "true", 4, NODE_TRUE }, { "try", 3, NODE_KW_TRY },
+    { "typeof", 6, NODE_KW_TYPEOF },
+    { "var", 3, NODE_KW_VAR }, { "void", 4, NODE_KW_VOID },
+    { "while", 5, NODE_KW_WHILE }, { "with", 4, NODE_KW_WITH },
+    { "yield", 5, NODE_KW_YIELD },
+};
+
+#define KEYWORD_COUNT (sizeof(KEYWORDS) / sizeof(KEYWORDS[0]))
+
+static const uint8_t KW_FIRST[27] = {
+    ['a' - 'a'] = 0,  ['b' - 'a'] = 2,  ['c' - 'a'] = 3,  ['d' - 'a'] = 8,
+    ['e' - 'a'] = 12, ['f' - 'a'] = 15, ['g' - 'a'] = 19, ['h' - 'a'] = 19,
+    ['i' - 'a'] = 19, ['j' - 'a'] = 23, ['k' - 'a'] = 23, ['l' - 'a'] = 23,
+    ['m' - 'a'] = 24, ['n' - 'a'] = 24, ['o' - 'a'] = 26, ['p' - 'a'] = 26,
+    ['q' - 'a'] = 26, ['r' - 'a'] = 26, ['s' - 'a'] = 27, ['t' - 'a'] = 30,
+    ['u' - 'a'] = 35, ['v' - 'a'] = 35, ['w' - 'a'] = 37, ['x' - 'a'] = 39,
+    ['y' - 'a'] = 39, ['z' - 'a'] = 40, [26] = 40,
+};
+
+_Static_assert(KEYWORD_COUNT == 40, "KW_FIRST out of date");
+
+static int fail(Lexer *lx, uint32_t pos, const char *msg) {
+    lx->err->pos  = pos;
+    lx->err->line = lx->line;
+    lx->err->msg  = msg;
+    return -1;
+}
+
+static inline int is_digit(uint8_t c) {
+    return (uint8_t)(c - '0') < 10;
+}
+
+static inline int is_hex(uint8_t c) {
+    return is_digit(c) || (uint8_t)((c | 0x20) - 'a') < 6;
+}
+
+// ASCII identifier characters; bytes >= 0x80 are handled by the caller
+static inline int is_ident_start(uint8_t c) {
+    return (uint8_t)((c | 0x20) - 'a') < 26 || c == '$' || c == '_';
+}
+
+static inline int is_ident_part(uint8_t c) {
+    return is_ident_start(c) || is_digit(c);
+}
+
+// U+2028 LINE SEPARATOR, U+2029 PARAGRAPH SEPARATOR
+static inline int is_ls_ps(const uint8_t *p) {
+    return p[0] == 0xE2 && p[1] == 0x80 && (p[2] | 1) == 0xA9;
+}
+
+// Byte length of the non-ASCII whitespace at p (Zs, BOM), 0 if none.
+// LS/PS are line terminators and not counted here.
+static uint32_t unicode_space(const uint8_t *p) {
+    switch (p[0]) {
+    case 0xC2: return p[1] == 0xA0 ? 2 : 0;                   // NBSP
+    case 0xE1: return p[1] == 0x9A && p[2] == 0x80 ? 3 : 0;   // U+1680
+    case 0xE2:
+        if (p[1] == 0x80) return p[2] <= 0x8A || p[2] == 0xAF ? 3 : 0;
+        return p[1] == 0x81 && p[2] == 0x9F ? 3 : 0;          // U+205F
+    case 0xE3: return p[1] == 0x80 && p[2] == 0x80 ? 3 : 0;   // U+3000
+    case 0xEF: return p[1] == 0xBB && p[2] == 0xBF ? 3 : 0;   // BOM
+    default:   return 0;
+    }
+}
+
+// Length of the UTF-8 sequence led by c; stray continuation bytes count as 1
+static inline uint32_t utf8_len(uint8_t c) {
+    return c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+}
+
+// "@license" or "@preserve" at p (on the '@'); reads into the padding
+static inline int legal_tag(const uint8_t *p) {
+    return !memcmp(p, "@license", 8) || !memcmp(p, "@preserve", 9);
+}
+
+// Position of the line terminator ending a line comment (or hashbang)
+// whose text starts at p, len if none. Sets *tagged on a legal tag.
+static uint32_t line_comment_end(const uint8_t *src, uint32_t p, uint32_t len, int *tagged) {
+#ifdef LEX_SIMD
+    const __m512i vlf = _mm512_set1_epi8('\n'), vcr = _mm512_set1_epi8('\r');
+    const __m512i vls = _mm512_set1_epi8((char)0xE2), vat = _mm512_set1_epi8('@');
+    for (; p < len; p += 64) {
+        __m512i v = _mm512_loadu_si512(src + p);
+        uint64_t m = _mm512_cmpeq_epi8_mask(v, vlf) | _mm512_cmpeq_epi8_mask(v, vcr) |
+                     _mm512_cmpeq_epi8_mask(v, vls);
+        // 0xE2 that leads anything but LS/PS is comment text
+        while (m && src[p + __builtin_ctzll(m)] == 0xE2 && !is_ls_ps(src + p + __builtin_ctzll(m)))
+            m &= m - 1;
+        uint64_t before = m ? (m & -m) - 1 : ~0ULL;
+        for (uint64_t at = _mm512_cmpeq_epi8_mask(v, vat) & before; at; at &= at - 1)
+            *tagged |= legal_tag(src + p + __builtin_ctzll(at));
+        // Padding past len never matches
+        if (m) return p + (uint32_t)__builtin_ctzll(m);
+    }
+    return len;
+#else
+    for (; p < len; p++) {
+        uint8_t c = src[p];
+        if (c == '\n' || c == '\r' || is_ls_ps(src + p)) break;
+        if (c == '@') *tagged |= legal_tag(src + p);
+    }
+    return p < len ? p : len;
+#endif
+}
+
+// Position of the "*/" closing a block comment whose text starts at p,
+// len if unterminated. Line terminators in the text (CRLF as one) are
+// added to *lines, and a legal tag sets *tagged.
+static uint32_t block_comment_end(const uint8_t *src, uint32_t p, uint32_t len,
+                                  uint32_t *lines, int *tagged) {
+#ifdef LEX_SIMD
+    const __m512i vstar = _mm512_set1_epi8('*'), vslash = _mm512_set1_epi8('/');
+    const __m512i vlf = _mm512_set1_epi8('\n'), vcr = _mm512_set1_epi8('\r');
+    const __m512i vls = _mm512_set1_epi8((char)0xE2), vat = _mm512_set1_epi8('@');
+    for (; p < len; p += 64) {
+        __m512i v = _mm512_loadu_si512(src + p);
+        uint64_t slash = _mm512_cmpeq_epi8_mask(v, vslash) >> 1 |
+                         (uint64_t)(src[p + 64] == '/') << 63;
+        uint64_t stop = _mm512_cmpeq_epi8_mask(v, vstar) & slash;
+        uint64_t before = stop ? (stop & -stop) - 1 : ~0ULL;
+        uint64_t lf = _mm512_cmpeq_epi8_mask(v, vlf);
+        uint64_t lone_cr = _mm512_cmpeq_epi8_mask(v, vcr) &
+                           ~(lf >> 1 | (uint64_t)(src[p + 64] == '\n') << 63);
+
+        *lines += (uint32_t)__builtin_popcountll((lf | lone_cr) & before);
+        for (uint64_t m = _mm512_cmpeq_epi8_mask(v, vls) & before; m; m &= m - 1)
+            *lines += is_ls_ps(src + p + __builtin_ctzll(m));
+        for (uint64_t at = _mm512_cmpeq_epi8_mask(v, vat) & before; at; at &= at - 1)
+            *tagged |= legal_tag(src + p + __builtin_ctzll(at));
+        if (stop) return p + (uint32_t)__builtin_ctzll(stop);
+    }
+    return len;
+#else
+    for (; p < len; p++) {
+        uint8_t c = src[p];
+        if (c == '*' && src[p + 1] == '/') return p;
+        if (c == '\n' || (c == '\r' && src[p + 1] != '\n') || is_ls_ps(src + p))
+            ++*lines;
+        else if (c == '@')
+            *tagged |= legal_tag(src + p);
+    }
+    return len;
+#endif
+}
+
+static void comment_push(CommentTable *t, uint32_t start, uint32_t end, uint32_t attach) {
+    if (t->count == t->capacity) {
+        uint32_t cap = t->capacity ? t->capacity * 2 : 16;
+        Comment *items = realloc(t->items, cap * sizeof(Comment));
+        if (!items) {
+            fprintf(stderr, "jsopt: out of memory\n");
+            abort();
+        }
+        t->items = items;
+        t->capacity = cap;
+    }
+    t->items[t->count++] = (Comment){ start, end, attach };
+}
+
+// Skip whitespace, line terminators and comments, recording legal ones
+static int skip_trivia(Lexer *lx) {
+    const uint8_t *src = lx->src;
+    uint32_t p = lx->pos, len = lx->len;
+    int tagged = 0;
+
+    if (p == 0 && src[0] == '#' && src[1] == '!')
+        p = line_comment_end(src, 2, len, &tagged);
+
+    while (p < len) {
+        uint8_t c = src[p];
+        if (c == ' ' || c == '\t' || c == '\v' || c == '\f') {
+            p++;
+        } else if (c == '\n') {
+            lx->line++;
+            p++;
+        } else if (c == '\r') {
+            lx->line++;
+            p += src[p + 1] == '\n' ? 2 : 1;
+        } else if (c == '/' && (src[p + 1] == '/' || src[p + 1] == '*')) {
+            uint32_t open = p;
+            tagged = src[p + 2] == '!';
+            if (src[p + 1] == '/') {
+                p = line_comment_end(src, p + 2, len, &tagged);
+            } else {
+                p = block_comment_end(src, p + 2, len, &lx->line, &tagged);
+                if (p >= len) {
+                    lx->pos = len;
+                    return fail(lx, open, "unterminated comment");
+                }
+                p += 2;
+            }
+            if (tagged && lx->comments)
+                comment_push(lx->comments, open, p, lx->nodes.count);
+        } else if (c >= 0x80) {
+            uint32_t n = unicode_space(src + p);
+            if (!n && is_ls_ps(src + p)) {
+                lx->line++;
+                n = 3;
+            }
+            if (!n) break;
+            p += n;
+        } else {
+            break;
+        }
+    }
+    lx->pos = p < len ? p : len;
+    return 0;
+}
+
+static uint8_t keyword(const uint8_t *s, uint32_t n) {
+    if (n < 2 || n > 10 || (uint8_t)(s[0] - 'a') >= 26) return NODE_IDENT;
+    for (uint32_t i = KW_FIRST[s[0] - 'a']; i < KW_FIRST[s[0] - 'a' + 1]; i++)
+        if (KEYWORDS[i].len == n && !memcmp(KEYWORDS[i].name + 1, s + 1, n - 1))
+            return KEYWORDS[i].kind;
+    return NODE_IDENT;
+}
+
+// \uXXXX or \u{X...} at p (on the backslash), its code point in *cp.
+// Returns bytes consumed, 0 if malformed or past U+10FFFF.
+static uint32_t unicode_escape(const uint8_t *p, uint32_t *cp) {
+    uint32_t v = 0, i;
+    if (p[1] != 'u') return 0;
+    if (p[2] == '{') {
+        for (i = 3; is_hex(p[i]); i++) {
+            v = v << 4 | (uint32_t)(is_digit(p[i]) ? p[i] - '0' : (p[i] | 0x20) - 'a' + 10);
+            if (v > 0x10FFFF) return 0;
+        }
+        *cp = v;
+        return i > 3 && p[i] == '}' ? i + 1 : 0;
+    }
+    for (i = 2; i < 6; i++) {
+        if (!is_hex(p[i])) return 0;
+        v = v << 4 | (uint32_t)(is_digit(p[i]) ? p[i] - '0' : (p[i] | 0x20) - 'a' + 10);
+    }
+    *cp = v;
+    return 6;
+}
+
+// Length of the identifier character at p spelled as a \u escape or in
+// UTF-8, 0 if it is neither or not ID_Start (start) / ID_Continue
+// (ZWNJ and ZWJ included). Plain ASCII is left to the callers.
+static uint32_t ident_char(const uint8_t *p, int start) {
+    uint32_t cp, n = p[0] == '\\' ? unicode_escape(p, &cp) : unicode_utf8_decode(p, &cp);
+    if (!n) return 0;
+    if (cp < 0x80) return (start ? is_ident_start((uint8_t)cp) : is_ident_part((uint8_t)cp)) ? n : 0;
+    if (start) return unicode_is_id_start(cp) ? n : 0;
+    return unicode_is_id_continue(cp) || cp == 0x200C || cp == 0x200D ? n : 0;
+}
+
+// First position at or after p that is not ASCII [A-Za-z0-9$_]. The zero
+// padding ends any run by len.
+static inline uint32_t ident_run(const uint8_t *src, uint32_t p) {
+#ifdef LEX_SIMD
+    const __m512i case_bit = _mm512_set1_epi8(0x20), a = _mm512_set1_epi8('a');
+    const __m512i zero = _mm512_set1_epi8('0'), dollar = _mm512_set1_epi8('$');
+    const __m512i under = _mm512_set1_epi8('_');
+    const __m512i letters = _mm512_set1_epi8(26), digits = _mm512_set1_epi8(10);
+    for (;; p += 64) {
+        __m512i v = _mm512_loadu_si512(src + p);
+        uint64_t id = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(_mm512_or_si512(v, case_bit), a),
+                                             letters) |
+                      _mm512_cmplt_epu8_mask(_mm512_sub_epi8(v, zero), digits) |
+                      _mm512_cmpeq_epi8_mask(v, dollar) | _mm512_cmpeq_epi8_mask(v, under);
+        if (~id) return p + (uint32_t)__builtin_ctzll(~id);
+    }
+#else
+    while (is_ident_part(src[p])) p++;
+    return p;
+#endif
+}
+
+static uint32_t utf8_encode(uint32_t cp, uint8_t *out) {
+    if (cp < 0x80) {
+        out[0] = (uint8_t)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = (uint8_t)(0xC0 | cp >> 6);
+        out[1] = (uint8_t)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = (uint8_t)(0xE0 | cp >> 12);
+        out[1] = (uint8_t)(0x80 | (cp >> 6 & 0x3F));
+        out[2] = (uint8_t)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (uint8_t)(0xF0 | cp >> 18);
+    out[1] = (uint8_t)(0x80 | (cp >> 12 & 0x3F));
+    out[2] = (uint8_t)(0x80 | (cp >> 6 & 0x3F));
+    out[3] = (uint8_t)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+// Atom of the identifier src[s, e) with its \u escapes decoded, so
+// \u0061b and ab are one name; a private name keeps its '#'. Escapes
+// only shrink (\uXXXX is 6 bytes for at most 3), so the raw length
+// bounds the buffer.
+static uint32_t intern_cooked(Lexer *lx, uint32_t s, uint32_t e) {
+    uint8_t stack_buf[256];
+    uint8_t *buf = e - s <= sizeof(stack_buf) ? stack_buf : malloc(e - s);
+    if (!buf) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+    uint32_t n = 0, p = s, cp;
+    do { // identifiers are never empty
+        if (lx->src[p] == '\\') {
+            p += unicode_escape(lx->src + p, &cp);
+            n += utf8_encode(cp, buf + n);
+        } else {
+            buf[n++] = lx->src[p++];
+        }
+    } while (p < e);
+    uint32_t atom = atom_intern(lx->atoms, (const char *)buf, n);
+    if (buf != stack_buf) free(buf);
+    return atom;
+}
+
+// Identifier, keyword or private name (#x, emitted as NODE_IDENT). ASCII
+// runs take the fast path; \u escapes and UTF-8 are checked against
+// ID_Start / ID_Continue one character at a time.
+static int scan_ident(Lexer *lx, uint32_t s) {
+    const uint8_t *src = lx->src;
+    uint32_t p = s, n;
+    int plain = src[s] != '#';
+    if (!plain) p++;
+
+    uint8_t c = src[p];
+    if (is_ident_start(c)) {
+        p++;
+    } else if ((n = ident_char(src + p, 1))) {
+        plain &= c != '\\';
+        p += n;
+    } else if (c == '\\') {
+        return fail(lx, p, "invalid unicode escape in identifier");
+    } else {
+        return fail(lx, s, plain ? "unexpected character" : "expected identifier after '#'");
+    }
+
+    for (;;) {
+        p = ident_run(src, p);
+        c = src[p];
+        if (c == '\\') {
+            n = ident_char(src + p, 0);
+            if (!n) return fail(lx, p, "invalid unicode escape in identifier");
+            plain = 0;
+            p += n;
+        } else if (c >= 0x80 && (n = ident_char(src + p, 0))) {
+            p += n;
+        } else {
+            break;
+        }
+    }
+    uint8_t kind = plain ? keyword(src + s, p - s) : NODE_IDENT;
+    EMIT(lx, kind, s, p);
+    if (kind == NODE_IDENT && lx->atoms && p - s <= 0xFFFE)
+        lx->nodes.nodes[lx->nodes.count - 1].data[1] =
+            plain ? atom_intern(lx->atoms, (const char *)src + s, p - s) : intern_cooked(lx, s, p);
+    lx->pos = p;
+    return 0;
+}
+
+static uint32_t digits(const uint8_t *src, uint32_t p, int hex) {
+    while (hex ? is_hex(src[p]) || src[p] == '_' : is_digit(src[p]) || src[p] == '_') p++;
+    return p;
+}
+
+// Every numeric form (decimal, .5, exponents, 0x/0o/0b, separators,
+// BigInt n suffix) is one NODE_NUMBER; the literal text is kept as is
+static int scan_number(Lexer *lx, uint32_t s) {
+    const uint8_t *src = lx->src;
+    uint32_t p = s;
+    uint8_t radix = src[s] == '0' ? (uint8_t)(src[s + 1] | 0x20) : 0;
+
+    if (radix == 'x' || radix == 'o' || radix == 'b') {
+        p = digits(src, s + 2, radix == 'x');
+        if (p == s + 2) return fail(lx, p, "missing digits after radix prefix");
+        for (uint32_t i = s + 2; i < p; i++)
+            if (radix != 'x' && src[i] != '_' && src[i] - '0' >= (radix == 'o' ? 8 : 2))
+                return fail(lx, i, "invalid digit in numeric literal");
+        if (src[p] == 'n') p++;
+    } else {
+        int integer = 1;
+        p = digits(src, p, 0);
+        if (src[p] == '.') {
+            integer = 0;
+            p = digits(src, p + 1, 0);
+        }
+        if ((src[p] | 0x20) == 'e') {
+            uint32_t q = p + 1;
+            if (src[q] == '+' || src[q] == '-') q++;
+            if (!is_digit(src[q])) return fail(lx, q, "missing exponent");
+            p = digits(src, q, 0);
+            integer = 0;
+        }
+        if (integer && src[p] == 'n') p++;
+    }
+    if (is_ident_part(src[p]) || src[p] == '\\' || (src[p] >= 0x80 && ident_char(src + p, 1)))
+        return fail(lx, p, "identifier directly after number");
+    EMIT(lx, NODE_NUMBER, s, p);
+    lx->pos = p;
+    return 0;
+}
+
+#ifdef LEX_SIMD
+// Bits of the bytes escaped by a backslash, given the backslash bits of a
+// 64-byte block (simdjson's find_escaped). A run of backslashes escapes
+// every other byte; *carry is set when the block's last backslash
+// escapes the first byte of the next block.
+static inline uint64_t escaped_bits(uint64_t bs, uint64_t *carry) {
+    const uint64_t even = 0x5555555555555555ULL;
+    bs &= ~*carry;
+    uint64_t follows = bs << 1 | *carry;
+    uint64_t odd_starts = bs & ~even & ~follows;
+    uint64_t even_runs;
+    *carry = __builtin_add_overflow(odd_starts, bs, &even_runs);
+    return (even ^ (even_runs << 1)) & follows;
+}
+#else
+// Consume the escape at p (on the backslash): a line continuation counts
+// its line (CRLF is one), anything else is the backslash and one byte.
+// Returns the position after it.
+static uint32_t skip_escape(const uint8_t *src, uint32_t p, uint32_t *lines) {
+    uint8_t c = src[p + 1];
+    if (c == '\r') {
+        ++*lines;
+        return p + (src[p + 2] == '\n' ? 3 : 2);
+    }
+    if (c == '\n' || is_ls_ps(src + p + 1)) ++*lines;
+    return p + 2;
+}
+#endif
+
+static int scan_string(Lexer *lx, uint32_t s) {
+    const uint8_t *src = lx->src;
+    uint8_t quote = src[s];
+    uint32_t p = s + 1, len = lx->len, lines = 0;
+#ifdef LEX_SIMD
+    // Stop at the first unescaped quote, CR or LF. An escaped CR or LF
+    // is a line continuation, and the LF of an escaped CRLF is part of it.
+    const __m512i vq = _mm512_set1_epi8((char)quote), vbs = _mm512_set1_epi8('\\');
+    const __m512i vlf = _mm512_set1_epi8('\n'), vcr = _mm512_set1_epi8('\r');
+    const __m512i vls = _mm512_set1_epi8((char)0xE2);
+    uint64_t esc_carry = 0, cr_carry = 0;
+    for (;; p += 64) {
+        if (p >= len) return fail(lx, s, "unterminated string");
+        __m512i v = _mm512_loadu_si512(src + p);
+        uint64_t esc = escaped_bits(_mm512_cmpeq_epi8_mask(v, vbs), &esc_carry);
+        uint64_t lf = _mm512_cmpeq_epi8_mask(v, vlf), cr = _mm512_cmpeq_epi8_mask(v, vcr);
+        uint64_t esc_cr = esc & cr;
+        uint64_t crlf = (esc_cr << 1 | cr_carry) & lf;
+        cr_carry = esc_cr >> 63;
+        uint64_t stop = (_mm512_cmpeq_epi8_mask(v, vq) | lf | cr) & ~esc & ~crlf;
+        uint64_t before = stop ? (stop & -stop) - 1 : ~0ULL;
+
+        lines += (uint32_t)__builtin_popcountll(esc & (lf | cr) & before);
+        // Escaped LS/PS are continuations too; rare enough to check one by one
+        for (uint64_t m = esc & _mm512_cmpeq_epi8_mask(v, vls) & before; m; m &= m - 1)
+            lines += is_ls_ps(src + p + __builtin_ctzll(m));
+
+        if (stop) {
+            p += (uint32_t)__builtin_ctzll(stop);
+            if (p >= len || src[p] != quote) return fail(lx, s, "unterminated string");
+            break;
+        }
+    }
+#else
+    for (;;) {
+        if (p >= len) return fail(lx, s, "unterminated string");
+        uint8_t c = src[p];
+        if (c == quote) break;
+        if (c == '\\') {
+            p = skip_escape(src, p, &lines);
+        } else if (c == '\n' || c == '\r') {
+            return fail(lx, s, "unterminated string");
+        } else {
+            p++;
+        }
+    }
+#endif
+    EMIT(lx, NODE_STRING, s, p + 1);
+    lx->line += lines;
+    lx->pos = p + 1;
+    return 0;
+}
+
+// Template text from s, which is on the opening '`' (head) or on the '}'
+// closing a substitution. Ends at '`' (FULL/TAIL) or after "${" (HEAD/MID).
+static int scan_template(Lexer *lx, uint32_t s, int head) {
+    const uint8_t *src = lx->src;
+    uint32_t p = s + 1, len = lx->len, lines = 0;
+    uint8_t kind;
+#ifdef LEX_SIMD
+    // Stop at the first unescaped '`' or "${". Every line terminator in
+    // the text counts, escaped or not, with CRLF as one; the byte after
+    // the block is in the padding when the block runs past len.
+    const __m512i vtick = _mm512_set1_epi8('`'), vdollar = _mm512_set1_epi8('$');
+    const __m512i vbrace = _mm512_set1_epi8('{'), vbs = _mm512_set1_epi8('\\');
+    const __m512i vlf = _mm512_set1_epi8('\n'), vcr = _mm512_set1_epi8('\r');
+    const __m512i vls = _mm512_set1_epi8((char)0xE2);
+    uint64_t esc_carry = 0;
+    for (;; p += 64) {
+        if (p >= len) return fail(lx, s, "unterminated template");
+        __m512i v = _mm512_loadu_si512(src + p);
+        uint64_t esc = escaped_bits(_mm512_cmpeq_epi8_mask(v, vbs), &esc_carry);
+        uint64_t brace = _mm512_cmpeq_epi8_mask(v, vbrace) >> 1 |
+                         (uint64_t)(src[p + 64] == '{') << 63;
+        uint64_t lf = _mm512_cmpeq_epi8_mask(v, vlf);
+        uint64_t lone_cr = _mm512_cmpeq_epi8_mask(v, vcr) &
+                           ~(lf >> 1 | (uint64_t)(src[p + 64] == '\n') << 63);
+        uint64_t stop = (_mm512_cmpeq_epi8_mask(v, vtick) |
+                         (_mm512_cmpeq_epi8_mask(v, vdollar) & brace)) & ~esc;
+        uint64_t before = stop ? (stop & -stop) - 1 : ~0ULL;
+
+        lines += (uint32_t)__builtin_popcountll((lf | lone_cr) & before);
+        for (uint64_t m = _mm512_cmpeq_epi8_mask(v, vls) & before; m; m &= m - 1)
+            lines += is_ls_ps(src + p + __builtin_ctzll(m));
+
+        if (stop) {
+            p += (uint32_t)__builtin_ctzll(stop);
+            if (p >= len) return fail(lx, s, "unterminated template");
+            if (src[p] == '`') {
+                p++;
+                kind = head ? NODE_TEMPLATE_FULL : NODE_TEMPLATE_TAIL;
+            } else {
+                p += 2;
+                kind = head ? NODE_TEMPLATE_HEAD : NODE_TEMPLATE_MID;
+            }
+            break;
+        }
+    }
+#else
+    for (;;) {
+        if (p >= len) return fail(lx, s, "unterminated template");
+        uint8_t c = src[p];
+        if (c == '`') {
+            p++;
+            kind = head ? NODE_TEMPLATE_FULL : NODE_TEMPLATE_TAIL;
+            break;
+        }
+        if (c == '$' && src[p + 1] == '{') {
+            p += 2;
+            kind = head ? NODE_TEMPLATE_HEAD : NODE_TEMPLATE_MID;
+            break;
+        }
+        if (c == '\\') {
+            p = skip_escape(src, p, &lines);
+            continue;
+        }
+        if (c == '\n' || (c == '\r' && src[p + 1] != '\n') || is_ls_ps(src + p))
+            lines++;
+        p++;
+    }
+#endif
+
+    if (kind == NODE_TEMPLATE_HEAD) {
+        if (lx->depth == LEX_TEMPLATE_DEPTH)
+            return fail(lx, s, "template substitutions nested too deeply");
+        lx->saved[lx->depth++] = lx->braces;
+        lx->braces = 0;
+    } else if (kind == NODE_TEMPLATE_TAIL) {
+        lx->braces = lx->saved[--lx->depth];
+    }
+    EMIT(lx, kind, s, p);
+    lx->line += lines;
+    lx->pos = p;
+    return 0;
+}
+
+// Whether a '/' after a token of kind k starts a regex: 0 division (the
+// token ends an expression), 1 regex, 2 regex unless the keyword is a
+// property name after '.' or '?.' (a.return / 2). NODE_EOF stands for
+// the start of input.
+#define REGEX_AFTER_KIND(k) (uint8_t)( \
+    IS_KEYWORD(k) ? 2 : \
+    (k) == NODE_TEMPLATE_HEAD || (k) == NODE_TEMPLATE_MID || (k) == NODE_EOF ? 1 : \
+    IS_LEAF(k) || IS_COMPOUND(k) ? 0 : \
+    (k) == NODE_RPAREN || (k) == NODE_RBRACKET || (k) == NODE_RBRACE || \
+    (k) == NODE_PLUS_PLUS || (k) == NODE_MINUS_MINUS ? 0 : 1)
+#define RA4(k)  REGEX_AFTER_KIND(k), REGEX_AFTER_KIND((k) + 1), \
+                REGEX_AFTER_KIND((k) + 2), REGEX_AFTER_KIND((k) + 3)
+#define RA16(k) RA4(k), RA4((k) + 4), RA4((k) + 8), RA4((k) + 12)
+#define RA64(k) RA16(k), RA16((k) + 16), RA16((k) + 32), RA16((k) + 48)
+
+static const uint8_t REGEX_AFTER[256] = { RA64(0), RA64(64), RA64(128), RA64(192) };
+
+#undef RA64
+#undef RA16
+#undef RA4
+#undef REGEX_AFTER_KIND
+
+// Keyed on the last emitted token; only consulted on a '/'
+static inline int regex_allowed(const Lexer *lx) {
+    const NodeArray *a = &lx->nodes;
+    if (a->count == 1) return 1;
+    uint8_t r = REGEX_AFTER[a->nodes[a->count - 1].kind];
+    if (r == 2 && a->count > 2) {
+        uint8_t before = a->nodes[a->count - 2].kind;
+        r = before != NODE_DOT && before != NODE_QUESTION_DOT;
+    }
+    return r != 0;
+}
+
+// Next position at or after p that a regex body has to look at: '/', '\\',
+// '[', ']', CR, LF, or 0xE2 (lead byte of LS/PS). len if none.
+static inline uint32_t regex_skip(const uint8_t *src, uint32_t p, uint32_t len) {
+#ifdef LEX_SIMD
+    // Bytes past len are zero padding and never match
+    const __m512i slash = _mm512_set1_epi8('/'), bslash = _mm512_set1_epi8('\\');
+    const __m512i open = _mm512_set1_epi8('['), close = _mm512_set1_epi8(']');
+    const __m512i lf = _mm512_set1_epi8('\n'), cr = _mm512_set1_epi8('\r');
+    const __m512i ls = _mm512_set1_epi8((char)0xE2);
+    for (; p < len; p += 64) {
+        __m512i v = _mm512_loadu_si512(src + p);
+        uint64_t m = _mm512_cmpeq_epi8_mask(v, slash) | _mm512_cmpeq_epi8_mask(v, bslash) |
+                     _mm512_cmpeq_epi8_mask(v, open) | _mm512_cmpeq_epi8_mask(v, close) |
+                     _mm512_cmpeq_epi8_mask(v, lf) | _mm512_cmpeq_epi8_mask(v, cr) |
+                     _mm512_cmpeq_epi8_mask(v, ls);
+        if (m) return p + (uint32_t)__builtin_ctzll(m);
+    }
+    return len;
+#else
+    for (; p < len; p++) {
+        uint8_t c = src[p];
+        if (c == '/' || c == '\\' || c == '[' || c == ']' || c == '\n' || c == '\r' || c == 0xE2)
+            return p;
+    }
+    return len;
+#endif
+}
+
+static int scan_regex(Lexer *lx, uint32_t s) {
+    const uint8_t *src = lx->src;
+    uint32_t p = s + 1, len = lx->len;
+    int in_class = 0;
+    for (;;) {
+        p = regex_skip(src, p, len);
+        if (p >= len) return fail(lx, s, "unterminated regex");
+        uint8_t c = src[p];
+        if (c == '\n' || c == '\r' || is_ls_ps(src + p))
+            return fail(lx, s, "unterminated regex");
+        if (c == '\\') {
+            c = src[p + 1];
+            if (p + 1 >= len || c == '\n' || c == '\r' || is_ls_ps(src + p + 1))
+                return fail(lx, s, "unterminated regex");
+            p += 1 + (c >= 0x80 ? utf8_len(c) : 1);
+            continue;
+        }
+        if (c == '[') in_class = 1;
+        else if (c == ']') in_class = 0;
+        else if (c == '/' && !in_class) break;
+        p++;
+    }
+    p++;
+    while (is_ident_part(src[p])) p++;
+    EMIT(lx, NODE_REGEX, s, p);
+    lx->pos = p;
+    return 0;
+}
+
+// Longest-match punctuator or operator at s
+static int scan_punct(Lexer *lx, uint32_t s) {
+    const uint8_t *q = lx->src + s;
+    uint8_t kind;
+    uint32_t n = 1;
+
+#define NEXT(ch, k2, rest) if (q[1] == (ch)) { n = 2; kind = (k2); rest; } else
+#define THIRD(ch, k3) if (q[2] == (ch)) { n = 3; kind = (k3); }
+    switch (q[0]) {
+    case '{': kind = NODE_LBRACE; lx->braces++; break;
+    case '}': kind = NODE_RBRACE; if (lx->braces) lx->braces--; break;
+    case '(': kind = NODE_LPAREN; break;
+    case ')': kind = NODE_RPAREN; break;
+    case '[': kind = NODE_LBRACKET; break;
+    case ']': kind = NODE_RBRACKET; break;
+    case ';': kind = NODE_SEMI; break;
+    case ',': kind = NODE_COMMA; break;
+    case ':': kind = NODE_COLON; break;
+    case '~': kind = NODE_TILDE; break;
+    case '.':
+        if (q[1] == '.' && q[2] == '.') { n = 3; kind = NODE_DOT_DOT_DOT; }
+        else kind = NODE_DOT;
+        break;
+    case '?':
+        if (q[1] == '.' && !is_digit(q[2])) { n = 2; kind = NODE_QUESTION_DOT; }
+        else NEXT('?', NODE_QUESTION_QUESTION, THIRD('=', NODE_QUESTION_QUESTION_EQ))
+        kind = NODE_QUESTION;
+        break;
+    case '=':
+        NEXT('=', NODE_EQ_EQ, THIRD('=', NODE_EQ_EQ_EQ))
+        NEXT('>', NODE_ARROW_TOK, (void)0)
+        kind = NODE_EQ;
+        break;
+    case '!':
+        NEXT('=', NODE_BANG_EQ, THIRD('=', NODE_BANG_EQ_EQ))
+        kind = NODE_BANG;
+        break;
+    case '+':
+        NEXT('+', NODE_PLUS_PLUS, (void)0)
+        NEXT('=', NODE_PLUS_EQ, (void)0)
+        kind = NODE_PLUS;
+        break;
+    case '-':
+        NEXT('-', NODE_MINUS_MINUS, (void)0)
+        NEXT('=', NODE_MINUS_EQ, (void)0)
+        kind = NODE_MINUS;
+        break;
+    case '*':
+        NEXT('*', NODE_STAR_STAR, THIRD('=', NODE_STAR_STAR_EQ))
+        NEXT('=', NODE_STAR_EQ, (void)0)
+        kind = NODE_STAR;
+        break;
+    case '/':
+        NEXT('=', NODE_SLASH_EQ, (void)0)
+        kind = NODE_SLASH;
+        break;
+    case '%':
+        NEXT('=', NODE_PERCENT_EQ, (void)0)
+        kind = NODE_PERCENT;
+        break;
+    case '<':
+        NEXT('<', NODE_LT_LT, THIRD('=', NODE_LT_LT_EQ))
+        NEXT('=', NODE_LT_EQ, (void)0)
+        kind = NODE_LT;
+        break;
+    case '>':
+        if (q[1] == '>' && q[2] == '>') {
+            n = 3;
+            kind = NODE_GT_GT_GT;
+            if (q[3] == '=') { n = 4; kind = NODE_GT_GT_GT_EQ; }
+        } else NEXT('>', NODE_GT_GT, THIRD('=', NODE_GT_GT_EQ))
+        NEXT('=', NODE_GT_EQ, (void)0)
+        kind = NODE_GT;
+        break;
+    case '&':
+        NEXT('&', NODE_AMP_AMP, THIRD('=', NODE_AMP_AMP_EQ))
+        NEXT('=', NODE_AMP_EQ, (void)0)
+        kind = NODE_AMP;
+        break;
+    case '|':
+        NEXT('|', NODE_PIPE_PIPE, THIRD('=', NODE_PIPE_PIPE_EQ))
+        NEXT('=', NODE_PIPE_EQ, (void)0)
+        kind = NODE_PIPE;
+        break;
+    case '^':
+        NEXT('=', NODE_CARET_EQ, (void)0)
+        kind = NODE_CARET;
+        break;
+    default:
+        return fail(lx, s, "unexpected character");
+    }
+#undef NEXT
+#undef THIRD
+
+    EMIT(lx, kind, s, s + n);
+    lx->pos = s + n;
+    return 0;
+}
+
+// The template state change scan_template and scan_punct make for a
+// token of kind k
+static void template_replay(EditSync *s, uint8_t k) {
+    if (k == NODE_TEMPLATE_HEAD) {
+        s->saved[s->depth++] = s->braces;
+        s->braces = 0;
+    } else if (k == NODE_TEMPLATE_TAIL) {
+        s->braces = s->saved[--s->depth];
+    } else if (k == NODE_LBRACE) {
+        s->braces++;
+    } else if (k == NODE_RBRACE && s->braces) {
+        s->braces--;
+    }
+}
+
+// Whether the token just emitted and everything after it will come out
+// as the old tokens shifted by delta: it is past the edit and equals an
+// old token in kind, shifted start and length, after the same kind (the
+// regex context) and in the same template state. From there both lexers
+// read the same bytes in the same state. Outside substitutions braces
+// are never read, nor is saved[0] (only restored there), so neither is
+// compared.
+static int resync(Lexer *lx) {
+    EditSync *s = lx->sync;
+    const NodeArray *a = &lx->nodes;
+    const Node *t = &a->nodes[a->count - 1];
+    if (t->start < s->from) return 0;
+    uint32_t at = t->start - s->delta;
+    while (s->next < s->last && s->old[s->next].start < at)
+        template_replay(s, s->old[s->next++].kind);
+    if (s->next == s->last || s->old[s->next].start != at) return 0;
+    const Node *o = &s->old[s->next++];
+    template_replay(s, o->kind);
+    if (o->kind != t->kind || o->op != t->op ||
+        (o->op == NODE_LEN_OVERFLOW && o->data[1] + s->delta != t->data[1]) ||
+        o[-1].kind != t[-1].kind || s->depth != lx->depth ||
+        (s->depth && (s->braces != lx->braces ||
+                      memcmp(s->saved + 1, lx->saved + 1, (s->depth - 1) * sizeof(uint32_t)))))
+        return 0;
+    s->match = (uint32_t)(o - s->old);
+    return 1;
+}
+
+static int lex_tokens(Lexer *lx) {
+    const uint8_t *src = lx->src;
+    for (;;) {
+        if (skip_trivia(lx) < 0) return -1;
+        uint32_t s = lx->pos;
+        if (s >= lx->len) break;
+
+        uint8_t c = src[s];
+        int rc;
+        if (is_ident_start(c) || c == '\\' || (c >= 0x80 && !is_ls_ps(src + s)))
+            rc = scan_ident(lx, s);
+        else if (is_digit(c) || (c == '.' && is_digit(src[s + 1])))
+            rc = scan_number(lx, s);
+        else if (c == '"' || c == '\'')
+            rc = scan_string(lx, s);
+        else if (c == '`')
+            rc = scan_template(lx, s, 1);
+        else if (c == '}' && lx->depth && !lx->braces)
+            rc = scan_template(lx, s, 0);
+        else if (c == '/' && regex_allowed(lx))
+            rc = scan_regex(lx, s);
+        else if (c == '#')
+            rc = scan_ident(lx, s);
+        else
+            rc = scan_punct(lx, s);
+        if (rc < 0) return -1;
+        if (lx->sync && resync(lx)) return 0;
+    }
+    if (lx->depth) return fail(lx, lx->len, "unterminated template");
+    EMIT(lx, NODE_EOF, lx->len, lx->len);
+    return 0;
+}
+
+#ifndef LEX_REFERENCE
+void comment_table_free(CommentTable *t) {
+    free(t->items);
+    *t = (CommentTable){ 0 };
+}
+#endif
+
+int lex(NodeArray *arr, const char *src, uint32_t len, CommentTable *comments,
+        AtomTable *atoms, LexError *err) {
+    Lexer lx;
+    lx.nodes    = *arr;
+    lx.line     = 1;
+    lx.src      = (const uint8_t *)src;
+    lx.len      = len;
+    lx.pos      = 0;
+    lx.braces   = 0;
+    lx.depth    = 0;
+    lx.comments = comments;
+    lx.atoms    = atoms;
+    lx.sync     = NULL;
+    lx.err      = err;
+    if (comments) comments->count = 0;
+
+    int rc = lex_tokens(&lx);
+    *arr = lx.nodes;
+    if (rc == 0) arr->token_end = arr->count;
+    return rc;
+}
+
+#ifndef LEX_REFERENCE
+static inline uint64_t load64(const char *p) {
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+void lex_diff(const char *old, uint32_t old_len, const char *src, uint32_t len,
+              LexEdit *edit) {
+    uint32_t n = old_len < len ? old_len : len, pre = 0, suf = 0;
+    for (; pre + 8 <= n; pre += 8) {
+        uint64_t x = load64(old + pre) ^ load64(src + pre);
+        if (x) {
+            pre += (uint32_t)__builtin_ctzll(x) / 8;
+            goto suffix;
+        }
+    }
+    while (pre < n && old[pre] == src[pre]) pre++;
+suffix:
+    // The suffix stops at the prefix: "aa" -> "aaa" is one insertion
+    n -= pre;
+    for (; suf + 8 <= n; suf += 8) {
+        uint64_t x = load64(old + old_len - suf - 8) ^ load64(src + len - suf - 8);
+        if (x) {
+            suf += (uint32_t)__builtin_clzll(x) / 8;
+            goto done;
+        }
+    }
+    while (suf < n && old[old_len - suf - 1] == src[len - suf - 1]) suf++;
+done:
+    *edit = (LexEdit){ pre, old_len - suf, len - suf };
+}
+
+// Template state before old[k]. Braces outside substitutions are never
+// read, so the scan only stops there for a substitution opening.
+static void replay_prefix(EditSync *s, const Node *old, uint32_t k) {
+    uint32_t i = 1;
+#ifdef LEX_SIMD
+    // Four nodes per load, kind in the low byte of every fourth dword
+    const __m512i vkind = _mm512_set1_epi32(0xFF), vhead = _mm512_set1_epi32(NODE_TEMPLATE_HEAD);
+    for (;;) {
+        while (!s->depth && i + 4 <= k) {
+            __m512i v = _mm512_and_si512(_mm512_loadu_si512(old + i), vkind);
+            uint32_t m = _mm512_mask_cmpeq_epi32_mask(0x1111, v, vhead);
+            if (m) {
+                i += (uint32_t)__builtin_ctz(m) / 4;
+                break;
+            }
+            i += 4;
+        }
+        if (i == k) return;
+        if (!s->depth && i + 4 > k) break;
+        template_replay(s, old[i++].kind);
+        while (s->depth && i < k) template_replay(s, old[i++].kind);
+    }
+#endif
+    for (; i < k; i++) {
+        uint8_t kind = old[i].kind;
+        if (s->depth || kind == NODE_TEMPLATE_HEAD) template_replay(s, kind);
+    }
+}
+
+// Move n tokens from src to dst (either direction, overlap allowed),
+// shifting offsets by delta and lines by lines
+static void shift_tokens(Node *dst, const Node *src, uint32_t n, uint32_t delta,
+                         uint32_t lines) {
+    if (dst == src && !delta && !lines) return;
+    uint32_t i = 0;
+#ifdef LEX_SIMD
+    // Four nodes per vector as dwords {kind/flags/op, start, line, end};
+    // the end moves only where op is NODE_LEN_OVERFLOW
+    const __m512i vadd = _mm512_set4_epi32(0, (int)lines, (int)delta, 0);
+    const __m512i vend = _mm512_set1_epi32((int)delta), voverflow = _mm512_set1_epi32(0xFFFF);
+    if (dst <= src) {
+        for (; i + 4 <= n; i += 4) {
+            __m512i v = _mm512_add_epi32(_mm512_loadu_si512(src + i), vadd);
+            __mmask16 m = _mm512_mask_cmpeq_epi32_mask(0x1111, _mm512_srli_epi32(v, 16),
+                                                      voverflow);
+            _mm512_storeu_si512(dst + i, _mm512_mask_add_epi32(v, (__mmask16)(m << 3), v, vend));
+        }
+    } else {
+        for (; n - i >= 4; n -= 4) {
+            __m512i v = _mm512_add_epi32(_mm512_loadu_si512(src + n - 4), vadd);
+            __mmask16 m = _mm512_mask_cmpeq_epi32_mask(0x1111, _mm512_srli_epi32(v, 16),
+                                                      voverflow);
+            _mm512_storeu_si512(dst + n - 4,
+                                _mm512_mask_add_epi32(v, (__mmask16)(m << 3), v, vend));
+        }
+    }
+#endif
+    if (dst <= src) {
+        for (; i < n; i++) {
+            Node t = src[i];
+            t.start += delta;
+            t.data[0] += lines;
+            if (t.op == NODE_LEN_OVERFLOW) t.data[1] += delta;
+            dst[i] = t;
+        }
+    } else {
+        while (n-- > i) {
+            Node t = src[n];
+            t.start += delta;
+            t.data[0] += lines;
+            if (t.op == NODE_LEN_OVERFLOW) t.data[1] += delta;
+            dst[n] = t;
+        }
+    }
+}
+
+// Move the comments of the re-lexed range into place: [0, keep) stay,
+// the old ones attached past match follow the re-lexed ones from c_old on
+static void splice_comments(CommentTable *t, uint32_t keep, uint32_t c_old,
+                            const EditSync *s, uint32_t k, uint32_t view_first,
+                            uint32_t shift) {
+    uint32_t fresh = t->count - c_old, tail = c_old;
+    if (s->match)
+        while (tail > keep && t->items[tail - 1].attach > s->match) tail--;
+    uint32_t kept = s->match ? c_old - tail : 0;
+    Comment *moved = NULL;
+    if (fresh) {
+        moved = malloc(fresh * sizeof(Comment));
+        if (!moved) {
+            fprintf(stderr, "jsopt: out of memory\n");
+            abort();
+        }
+        memcpy(moved, t->items + c_old, fresh * sizeof(Comment));
+    }
+    memmove(t->items + keep + fresh, t->items + tail, kept * sizeof(Comment));
+    for (uint32_t i = 0; i < kept; i++) {
+        Comment *c = &t->items[keep + fresh + i];
+        c->start += s->delta;
+        c->end += s->delta;
+        c->attach += shift;
+    }
+    for (uint32_t i = 0; i < fresh; i++) {
+        moved[i].attach = moved[i].attach - view_first + k;
+        t->items[keep + i] = moved[i];
+    }
+    free(moved);
+    t->count = keep + fresh + kept;
+}
+
+int lex_edit(NodeArray *arr, const char *src, uint32_t len, const LexEdit *edit,
+             CommentTable *comments, AtomTable *atoms, LexSplice *splice, LexError *err) {
+    Node *old = arr->nodes;
+    uint32_t count = arr->count;
+    uint32_t old_len = count > 1 ? old[count - 1].start : 0;
+    if (count < 2 || arr->token_end != count || old[count - 1].kind != NODE_EOF ||
+        edit->start > edit->old_end || edit->old_end > old_len ||
+        edit->start > edit->new_end || edit->new_end > len ||
+        len - edit->new_end != old_len - edit->old_end) {
+        *err = (LexError){ edit->start, 0, "edit does not fit the previous tokens" };
+        return -1;
+    }
+    if (arr->capacity - count < 4) {
+        fprintf(stderr, "jsopt: node limit exceeded (%u)\n", arr->capacity);
+        abort();
+    }
+
+    // First token the edit reaches: one ending where it starts may grow
+    uint32_t lo = 1, hi = count - 1;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (TOKEN_END(&old[mid]) < edit->start) lo = mid + 1;
+        else hi = mid;
+    }
+    // Restart on the token before it, whose start line is known: its
+    // lookahead may reach into the edit, and the trivia after it is
+    // rescanned. An edit in the first token starts over, hashbang and all.
+    uint32_t k = lo > 1 ? lo - 1 : 1;
+    uint32_t pos = lo == 1 ? 0 : old[k].start;
+
+    EditSync s = { .old = old, .next = k, .last = count - 1, .from = edit->new_end,
+                   .delta = edit->new_end - edit->old_end };
+    replay_prefix(&s, old, k);
+
+    // The re-lex emits into the free slots past the old tokens, as a
+    // NodeArray of its own behind copies of the (up to) two tokens before
+    // the restart, which regex_allowed reads
+    uint32_t prev = k - 1 < 2 ? k - 1 : 2, view_first = 1 + prev;
+    Lexer lx;
+    lx.nodes    = (NodeArray){ old + count, view_first, arr->capacity - count, 0, 0 };
+    lx.line     = lo == 1 ? 1 : old[k].data[0];
+    lx.src      = (const uint8_t *)src;
+    lx.len      = len;
+    lx.pos      = pos;
+    lx.braces   = s.braces;
+    lx.depth    = s.depth;
+    lx.comments = comments;
+    lx.atoms    = atoms;
+    lx.sync     = &s;
+    lx.err      = err;
+    memcpy(lx.saved, s.saved, s.depth * sizeof(uint32_t));
+    memcpy(old + count + 1, old + k - prev, prev * sizeof(Node));
+
+    uint32_t c_old = 0, c_keep = 0;
+    if (comments) {
+        c_old = comments->count;
+        uint32_t chi = c_old;
+        while (c_keep < chi) {
+            uint32_t mid = c_keep + (chi - c_keep) / 2;
+            if (comments->items[mid].end <= pos) c_keep = mid + 1;
+            else chi = mid;
+        }
+    }
+
+    Node *fresh = old + count + view_first;
+    uint32_t used = count + lx.nodes.count;
+    if (lex_tokens(&lx) < 0) {
+        used = count + lx.nodes.count;
+        memset(old + count, 0, (size_t)(used - count) * sizeof(Node));
+        if (comments) comments->count = c_old;
+        return -1;
+    }
+    used = count + lx.nodes.count;
+
+    uint32_t added = lx.nodes.count - view_first - (s.match != 0);
+    uint32_t kept_from = s.match ? s.match : count;
+    uint32_t removed = kept_from - k, tail = count - kept_from;
+    uint32_t new_count = k + added + tail;
+    uint32_t lines = s.match ? fresh[added].data[0] - old[s.match].data[0] : 0;
+
+    // Tokens after the edit slide into place with their offsets shifted;
+    // re-lexed ones the slide would overwrite go further out first
+    if (new_count > count + view_first) {
+        memmove(old + new_count, fresh, (size_t)added * sizeof(Node));
+        fresh = old + new_count;
+        if (new_count + added > used) used = new_count + added;
+    }
+    shift_tokens(old + k + added, old + kept_from, tail, s.delta, lines);
+    memcpy(old + k, fresh, (size_t)added * sizeof(Node));
+    if (used > new_count)
+        memset(old + new_count, 0, (size_t)(used - new_count) * sizeof(Node));
+
+    if (comments)
+        splice_comments(comments, c_keep, c_old, &s, k, view_first, added - removed);
+    arr->count = arr->token_end = new_count;
+    *splice = (LexSplice){ k, removed, added };
+    return 0;
+}
+#endif
@@ -0,0 +1,548 @@
+#include "jsopt/arena.h"
+#include "jsopt/cache.h"
+#include "jsopt/lex.h"
+#include "jsopt/node.h"
+#include "jsopt/pool.h"
+#include "jsopt/source.h"
+#include "jsopt/stats.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+typedef struct {
+    char    *in;
+    char    *out;  // "-" for stdout
+    uint64_t size;
+} Job;
+
+// Per-worker -b clock: phases and bytes add up without atomics, and whole
+// cache lines keep workers from contending for them
+typedef struct {
+    _Alignas(64) uint64_t phase_ns[PHASE_COUNT];
+    uint64_t bytes;
+} Timing;
+
+typedef struct {
+    Job       *jobs;
+    uint32_t   count;
+    uint32_t   cap;
+    const char *outdir;
+    NodeArray *arrays; // one per worker, recycled across files
+    CommentTable *comments; // legal comments, one table per worker
+    Arena     *arenas; // pass-local data, one per worker, emptied after each file
+    Cache     *cache;  // NULL when caching is off
+    uint32_t   iters;  // passes per file (-b), 1 otherwise
+    int        discard; // -b without -o: time everything but writing
+    Stats     *stats;  // one per worker with --stats, else NULL
+    Timing    *timing; // one per worker with -b, else NULL
+} Batch;
+
+// Mixed into cache keys; fold in every option that changes the output
+#define JSOPT_OPTIONS 0
+
+static void usage(void) {
+    fprintf(stderr,
+        "Usage: jsopt [options] <file.js | dir>...\n"
+        "\n"
+        "Options:\n"
+        "  -o DIR    write outputs under DIR (required unless a single file)\n"
+        "  -l FILE   read input paths from FILE, one per line (- for stdin)\n"
+        "  -j N      worker threads (default: online CPUs)\n"
+        "  -c DIR    reuse outputs cached in DIR across runs\n"
+        "  -M SIZE   cache size cap, with optional K/M/G suffix (default: 1G)\n"
+        "  -v        print a summary (cache hit rate) to stderr\n"
+        "  -b N      benchmark: N passes per file, per-phase MB/s as JSON on\n"
+        "            stdout; outputs are discarded unless -o is given\n"
+        "  --stats   print node counts, faults and peak RSS as JSON to stderr\n"
+        "            at exit (per-phase cycles need a JSOPT_STATS build)\n");
+    exit(1);
+}
+
+static void *xmalloc(size_t n) {
+    void *p = malloc(n);
+    if (!p) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+    return p;
+}
+
+static char *xstrdup(const char *s) {
+    size_t n = strlen(s) + 1;
+    return memcpy(xmalloc(n), s, n);
+}
+
+static char *path_join(const char *a, const char *b) {
+    size_t la = strlen(a), lb = strlen(b);
+    char *p = xmalloc(la + lb + 2);
+    memcpy(p, a, la);
+    p[la] = '/';
+    memcpy(p + la + 1, b, lb + 1);
+    return p;
+}
+
+static int is_js(const char *name) {
+    const char *dot = strrchr(name, '.');
+    return dot && (!strcmp(dot, ".js") || !strcmp(dot, ".mjs") || !strcmp(dot, ".cjs"));
+}
+
+// Whether path has a ".." component, which would climb out of outdir
+static int has_dotdot(const char *path) {
+    for (const char *p = path; (p = strstr(p, "..")); p += 2)
+        if ((p == path || p[-1] == '/') && (p[2] == '/' || p[2] == '\0'))
+            return 1;
+    return 0;
+}
+
+// Output path mirrors rel under outdir; absolute and ./ prefixes dropped
+// (rel never has ".." components, see add_path)
+static char *out_path(const Batch *b, const char *rel) {
+    if (!b->outdir) return xstrdup("-");
+    while (*rel == '/') rel++;
+    while (rel[0] == '.' && rel[1] == '/') rel += 2;
+    return path_join(b->outdir, rel);
+}
+
+static void add_job(Batch *b, const char *in, const char *rel, uint64_t size) {
+    if (b->count == b->cap) {
+        b->cap = b->cap ? b->cap * 2 : 256;
+        Job *grown = realloc(b->jobs, b->cap * sizeof(Job));
+        if (!grown) {
+            fprintf(stderr, "jsopt: out of memory\n");
+            abort();
+        }
+        b->jobs = grown;
+    }
+    b->jobs[b->count++] = (Job){ xstrdup(in), out_path(b, rel), size };
+}
+
+static int add_dir(Batch *b, const char *dir, const char *rel) {
+    DIR *d = opendir(dir);
+    if (!d) {
+        fprintf(stderr, "jsopt: %s: %s\n", dir, strerror(errno));
+        return -1;
+    }
+    int rc = 0;
+    struct dirent *e;
+    while ((e = readdir(d))) {
+        if (e->d_name[0] == '.') continue;
+        char *path = path_join(dir, e->d_name);
+        char *sub  = rel[0] ? path_join(rel, e->d_name) : xstrdup(e->d_name);
+        struct stat st;
+        if (stat(path, &st) < 0) {
+            fprintf(stderr, "jsopt: %s: %s\n", path, strerror(errno));
+            rc = -1;
+        } else if (S_ISDIR(st.st_mode)) {
+            rc |= add_dir(b, path, sub);
+        } else if (S_ISREG(st.st_mode) && is_js(e->d_name)) {
+            add_job(b, path, sub, (uint64_t)st.st_size);
+        }
+        free(path);
+        free(sub);
+    }
+    closedir(d);
+    return rc;
+}
+
+static int add_path(Batch *b, const char *path) {
+    struct stat st;
+    if (stat(path, &st) < 0) {
+        fprintf(stderr, "jsopt: %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    if (b->outdir && has_dotdot(path)) {
+        fprintf(stderr, "jsopt: %s: '..' in path, output would land outside %s\n",
+                path, b->outdir);
+        return -1;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        add_job(b, path, path, (uint64_t)st.st_size);
+        return 0;
+    }
+    // Directories mirror under their own path too, so a/x.js and b/x.js
+    // stay apart
+    char *rel = xstrdup(path);
+    for (size_t n = strlen(rel); n > 1 && rel[n - 1] == '/'; n--) rel[n - 1] = 0;
+    int rc = add_dir(b, rel, strcmp(rel, ".") ? rel : "");
+    free(rel);
+    return rc;
+}
+
+static int add_list(Batch *b, const char *list) {
+    FILE *f = strcmp(list, "-") ? fopen(list, "r") : stdin;
+    if (!f) {
+        fprintf(stderr, "jsopt: %s: %s\n", list, strerror(errno));
+        return -1;
+    }
+    int rc = 0;
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    while ((n = getline(&line, &cap, f)) > 0) {
+        while (n > 0 && (line[n - 1] == '\n' || line[n - 1] == '\r'))
+            line[--n] = 0;
+        if (n) rc |= add_path(b, line);
+    }
+    free(line);
+    if (f != stdin) fclose(f);
+    return rc;
+}
+
+static int by_out(const void *a, const void *b) {
+    return strcmp(((const Job *)a)->out, ((const Job *)b)->out);
+}
+
+// Two inputs writing one output would race and lose one silently
+static int check_outputs(Batch *b) {
+    qsort(b->jobs, b->count, sizeof(Job), by_out);
+    int rc = 0;
+    for (uint32_t i = 1; i < b->count; i++)
+        if (!strcmp(b->jobs[i].out, b->jobs[i - 1].out)) {
+            fprintf(stderr, "jsopt: %s and %s both write %s\n",
+                    b->jobs[i - 1].in, b->jobs[i].in, b->jobs[i].out);
+            rc = -1;
+        }
+    return rc;
+}
+
+static int by_size_desc(const void *a, const void *b) {
+    uint64_t x = ((const Job *)a)->size, y = ((const Job *)b)->size;
+    return (x < y) - (x > y);
+}
+
+static int mkdir_parents(char *path) {
+    for (char *p = strchr(path + 1, '/'); p; p = strchr(p + 1, '/')) {
+        *p = 0;
+        int rc = mkdir(path, 0755);
+        *p = '/';
+        if (rc < 0 && errno != EEXIST) return -1;
+    }
+    return 0;
+}
+
+// Files are written to a temporary beside the target and renamed over it:
+// the target may be the input itself, still mapped by source_open, and
+// truncating it in place would fault the write and leave it empty
+static int write_output(char *path, const char *data, size_t len) {
+    int fd = STDOUT_FILENO;
+    char *tmp = NULL;
+    if (strcmp(path, "-")) {
+        if (mkdir_parents(path) < 0) return -1;
+        size_t n = strlen(path) + 32;
+        tmp = xmalloc(n);
+        snprintf(tmp, n, "%s.tmp-%ld", path, (long)getpid());
+        fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            free(tmp);
+            return -1;
+        }
+    }
+    int rc = 0;
+    while (len) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            rc = -1;
+            break;
+        }
+        data += n;
+        len  -= (size_t)n;
+    }
+    if (tmp) {
+        if (close(fd) < 0) rc = -1;
+        if (rc == 0 && rename(tmp, path) < 0) rc = -1;
+        if (rc < 0) {
+            int err = errno;
+            unlink(tmp);
+            errno = err;
+        }
+        free(tmp);
+    }
+    return rc;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Charge the time since *t to phase and restart the clock
+static void phase_end(Timing *tm, Stats *st, Phase phase, uint64_t *t) {
+    if (tm) {
+        uint64_t now = now_ns();
+        tm->phase_ns[phase] += now - *t;
+        *t = now;
+    }
+    stats_phase(st, phase);
+}
+
+static int emit(Batch *b, Timing *tm, Stats *st, Job *job, const char *data, size_t len,
+                uint64_t *t) {
+    if (b->discard) return 0;
+    *t = now_ns();
+    stats_mark(st);
+    int rc = write_output(job->out, data, len);
+    if (rc < 0)
+        fprintf(stderr, "jsopt: %s: %s\n", job->out, strerror(errno));
+    phase_end(tm, st, PHASE_WRITE, t);
+    return rc;
+}
+
+#ifdef DEBUG
+// Structural invariants after each phase; a failure is a jsopt bug
+static void check_array(const Job *job, const NodeArray *arr, const char *phase) {
+    NodeError err;
+    if (node_array_validate(arr, &err) == 0) return;
+    fprintf(stderr, "jsopt: %s: invalid node array after %s: node %u: %s\n",
+            job->in, phase, err.idx, err.msg);
+    abort();
+}
+#endif
+
+static int minify_file(Batch *b, Job *job, NodeArray *arr, CommentTable *comments,
+                       Timing *tm, Stats *st) {
+    uint64_t t = now_ns();
+    stats_mark(st);
+    Source src;
+    if (source_open(&src, job->in) < 0) {
+        fprintf(stderr, "jsopt: %s: %s\n", job->in, strerror(errno));
+        return -1;
+    }
+    phase_end(tm, st, PHASE_READ, &t);
+    if (tm) tm->bytes += src.len;
+
+    // A hit skips every phase below
+    uint64_t key = 0;
+    CacheEntry hit;
+    int rc;
+    if (b->cache) {
+        key = cache_key(src.data, src.len, JSOPT_OPTIONS);
+        if (cache_get(b->cache, key, src.data, src.len, &hit) == 0) {
+            rc = emit(b, tm, st, job, hit.code, hit.code_len, &t);
+            cache_entry_release(&hit);
+            source_close(&src);
+            return rc;
+        }
+    }
+
+    node_array_reset(arr);
+
+    LexError lerr;
+    if (lex(arr, src.data, src.len, comments, NULL, &lerr) < 0) {
+        fprintf(stderr, "jsopt: %s:%u: %s\n", job->in, lerr.line, lerr.msg);
+        source_close(&src);
+        return -1;
+    }
+    phase_end(tm, st, PHASE_LEX, &t);
+#ifdef DEBUG
+    check_array(job, arr, "lex");
+#endif
+
+    // Parse, optimize and codegen slot in here, with pass-local data in
+    // the worker's arena; until codegen lands the text is written through
+    // unchanged (legal comments included)
+    const char *code = src.data;
+    uint32_t code_len = src.len;
+
+    if (st) stats_record_array(st, arr);
+
+    rc = emit(b, tm, st, job, code, code_len, &t);
+    if (rc == 0 && b->cache && cache_put(b->cache, key, src.data, src.len, code, code_len, NULL, 0) < 0)
+        fprintf(stderr, "jsopt: cache: %s\n", strerror(errno)); // not fatal
+
+    source_close(&src);
+    return rc;
+}
+
+static int minify_one(void *ctx, uint32_t worker, uint32_t idx) {
+    Batch *b = ctx;
+    int rc = 0;
+    for (uint32_t i = 0; i < b->iters && rc == 0; i++) {
+        rc = minify_file(b, &b->jobs[idx], &b->arrays[worker], &b->comments[worker],
+                         b->timing ? &b->timing[worker] : NULL,
+                         b->stats ? &b->stats[worker] : NULL);
+        arena_reset(&b->arenas[worker]);
+    }
+    return rc;
+}
+
+// Phase times are summed over workers, so per-phase MB/s is per thread;
+// the top-level figure is wall-clock throughput
+static void bench_print(Batch *b, uint32_t nthreads, uint64_t wall_ns) {
+    for (uint32_t i = 1; i < nthreads; i++) {
+        for (int p = 0; p < PHASE_COUNT; p++)
+            b->timing[0].phase_ns[p] += b->timing[i].phase_ns[p];
+        b->timing[0].bytes += b->timing[i].bytes;
+    }
+    uint64_t bytes = b->timing[0].bytes;
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    printf("{\n");
+    printf("  \"tool\": \"jsopt\", \"files\": %u, \"iterations\": %u, \"bytes\": %llu,\n",
+           b->count, b->iters, (unsigned long long)bytes);
+    printf("  \"threads\": %u, \"wall_ns\": %llu, \"mb_per_s\": %.2f, \"peak_rss_kb\": %ld,\n",
+           nthreads, (unsigned long long)wall_ns,
+           wall_ns ? (double)bytes * 1e3 / (double)wall_ns : 0.0, ru.ru_maxrss);
+    printf("  \"phases\": {\n");
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        uint64_t ns = b->timing[0].phase_ns[i];
+        const char *sep = i + 1 == PHASE_COUNT ? "" : ",";
+        if (ns == 0)
+            printf("    \"%s\": null%s\n", PHASE_NAMES[i], sep);
+        else
+            printf("    \"%s\": {\"ns\": %llu, \"mb_per_s\": %.2f}%s\n", PHASE_NAMES[i],
+                   (unsigned long long)ns, (double)bytes * 1e3 / (double)ns, sep);
+    }
+    printf("  }\n}\n");
+}
+
+// Size with optional K/M/G suffix
+static uint64_t parse_size(const char *s) {
+    char *end;
+    uint64_t n = strtoull(s, &end, 10);
+    switch (*end) {
+    case 'k': case 'K': n <<= 10; break;
+    case 'm': case 'M': n <<= 20; break;
+    case 'g': case 'G': n <<= 30; break;
+    default: break;
+    }
+    return n;
+}
+
+int main(int argc, char **argv) {
+    Batch b = { .iters = 1 };
+    uint32_t nthreads = pool_cpu_count();
+    int rc = 0, opt, verbose = 0, bench = 0, stats = 0;
+
+    // Inputs are collected after options so -o applies to all of them
+    const char *list = NULL, *cache_dir = NULL;
+    uint64_t cache_max = 1ull << 30;
+    static const struct option longopts[] = {
+        { "stats", no_argument, NULL, 'S' },
+        { NULL, 0, NULL, 0 },
+    };
+    while ((opt = getopt_long(argc, argv, "o:l:j:c:M:vb:h", longopts, NULL)) != -1) {
+        switch (opt) {
+        case 'o': b.outdir = optarg; break;
+        case 'l': list = optarg; break;
+        case 'j': nthreads = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'c': cache_dir = optarg; break;
+        case 'M': cache_max = parse_size(optarg); break;
+        case 'v': verbose = 1; break;
+        case 'S': stats = 1; break;
+        case 'b':
+            bench = 1;
+            b.iters = (uint32_t)strtoul(optarg, NULL, 10);
+            if (b.iters == 0) b.iters = 1;
+            break;
+        default:  usage();
+        }
+    }
+
+    Cache cache;
+    if (cache_dir) {
+        if (cache_open(&cache, cache_dir, cache_max) < 0) {
+            fprintf(stderr, "jsopt: %s: %s\n", cache_dir, strerror(errno));
+            return 1;
+        }
+        b.cache = &cache;
+    }
+    if (nthreads == 0) nthreads = 1;
+
+    if (list) rc |= add_list(&b, list);
+    for (int i = optind; i < argc; i++)
+        rc |= add_path(&b, argv[i]);
+
+    if (b.count == 0 && !rc) usage();
+    if (b.outdir && check_outputs(&b) < 0) return 1;
+    b.discard = bench && !b.outdir;
+    if (!b.outdir && !b.discard && b.count > 1) {
+        fprintf(stderr, "jsopt: -o DIR is required for multiple inputs\n");
+        return 1;
+    }
+
+    // Largest first: big files start early and small ones fill the tail
+    qsort(b.jobs, b.count, sizeof(Job), by_size_desc);
+
+    if (nthreads > b.count) nthreads = b.count ? b.count : 1;
+    if (stats) {
+        stats_start();
+        b.stats = aligned_alloc(_Alignof(Stats), nthreads * sizeof(Stats));
+        if (!b.stats) {
+            fprintf(stderr, "jsopt: out of memory\n");
+            abort();
+        }
+        memset(b.stats, 0, nthreads * sizeof(Stats));
+    }
+    if (bench) {
+        b.timing = aligned_alloc(_Alignof(Timing), nthreads * sizeof(Timing));
+        if (!b.timing) {
+            fprintf(stderr, "jsopt: out of memory\n");
+            abort();
+        }
+        memset(b.timing, 0, nthreads * sizeof(Timing));
+    }
+    b.arrays = xmalloc(nthreads * sizeof(NodeArray));
+    b.comments = xmalloc(nthreads * sizeof(CommentTable));
+    memset(b.comments, 0, nthreads * sizeof(CommentTable));
+    b.arenas = xmalloc(nthreads * sizeof(Arena));
+    for (uint32_t i = 0; i < nthreads; i++) {
+        if (node_array_init(&b.arrays[i], 0) != 0) {
+            fprintf(stderr, "jsopt: cannot reserve node array\n");
+            return 1;
+        }
+        if (arena_init(&b.arenas[i]) != 0) {
+            fprintf(stderr, "jsopt: cannot reserve arena\n");
+            return 1;
+        }
+    }
+
+    uint64_t t0 = now_ns();
+    uint32_t failed = pool_run(nthreads, b.count, minify_one, &b);
+    uint64_t wall_ns = now_ns() - t0;
+    if (failed) {
+        fprintf(stderr, "jsopt: %u of %u files failed\n", failed, b.count);
+        rc = -1;
+    }
+
+    if (b.cache) {
+        cache_prune(b.cache);
+        if (verbose) cache_stats_print(b.cache, stderr);
+        cache_close(b.cache);
+    }
+    if (verbose)
+        fprintf(stderr, "jsopt: %u files, %u threads\n", b.count, nthreads);
+    if (bench)
+        bench_print(&b, nthreads, wall_ns);
+    if (b.stats) {
+        for (uint32_t i = 1; i < nthreads; i++)
+            stats_merge(&b.stats[0], &b.stats[i]);
+        stats_print_json(&b.stats[0], stderr);
+    }
+
+    for (uint32_t i = 0; i < nthreads; i++) {
+        node_array_free(&b.arrays[i]);
+        comment_table_free(&b.comments[i]);
+        arena_free(&b.arenas[i]);
+    }
+    for (uint32_t i = 0; i < b.count; i++) {
+        free(b.jobs[i].in);
+        free(b.jobs[i].out);
+    }
+    free(b.jobs);
+    free(b.arrays);
+    free(b.comments);
+    free(b.arenas);
+    free(b.stats);
+    free(b.timing);
+    return rc ? 1 : 0;
+}
@@ -3,6 +3,10 @@
 #include <string.h>
 #include <stdio.h>
 #include <sys/mman.h>
+#include <unistd.h>
+#ifdef __AVX512BW__
+#include <immintrin.h>
+#endif
 
 #ifndef MAP_HUGE_2MB
 #define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
@@ -34,6 +38,30 @@ void node_array_free(NodeArray *arr) {
     memset(arr, 0, sizeof(*arr));
 }
 
+void node_mem_reset(void *base, size_t used, size_t touched, size_t keep) {
+    char *b = base;
+    if (touched > keep) {
+        // Whole pages past keep go back to the kernel and fault in zeroed;
+        // huge-page mappings may refuse, in which case they are cleared
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t from = (keep + page - 1) & ~(page - 1);
+        size_t to   = (touched + page - 1) & ~(page - 1);
+        if (to > from && madvise(b + from, to - from, MADV_DONTNEED) != 0 && used > from)
+            memset(b + from, 0, used - from);
+        memset(b, 0, used < from ? used : from);
+    } else {
+        memset(b, 0, used);
+    }
+}
+
+void node_array_reset(NodeArray *arr) {
+    size_t used = (size_t)arr->count * sizeof(Node);
+    node_mem_reset(arr->nodes, used, used, (size_t)NODE_RESET_KEEP * sizeof(Node));
+    arr->count     = 1;
+    arr->token_end = 0;
+    arr->root      = 0;
+}
+
 uint32_t node_push_token(NodeArray *arr, NodeKind kind,
                          uint32_t start, uint32_t len, uint32_t line) {
     if (arr->count >= arr->capacity) {
@@ -83,3 +111,337 @@ uint32_t node_reserve(NodeArray *arr, uint32_t count) {
     // mmap pages are already zeroed on first touch
     return first;
 }
+
+uint32_t node_push_ext(NodeArray *arr, NodeKind kind, uint8_t flags,
+                       uint16_t op, uint32_t start, const uint32_t *children) {
+    const NodeLayout *l = &node_layout[kind];
+    uint32_t run = node_reserve(arr, l->ext);
+    for (uint32_t i = 1; i < l->arity; i += 2) {
+        uint32_t second = i + 1 < l->arity ? children[i + 1] : 0;
+        arr->nodes[run + i / 2] = (Node){ NODE_EXT, 0, 0, start, { children[i], second } };
+    }
+    return node_push(arr, kind, flags, op, start, children[0], run);
+}
+
+uint32_t node_list_append(NodeArray *arr, uint32_t first, uint32_t count,
+                          uint32_t src, uint32_t n) {
+    if (first + count != arr->count) {
+        // Relocate once; later appends to this run then grow in place,
+        // so building a list out of k runs copies each element once
+        uint32_t moved = node_reserve(arr, count + n);
+        memcpy(&arr->nodes[moved], &arr->nodes[first], (size_t)count * sizeof(Node));
+        first = moved;
+    } else {
+        node_reserve(arr, n);
+    }
+    memcpy(&arr->nodes[first + count], &arr->nodes[src], (size_t)n * sizeof(Node));
+    return first;
+}
+
+#define SLOTS(k, f0, f1, n, opt, fl) \
+    [k] = { { NODE_FIELD_##f0, NODE_FIELD_##f1 }, n, 0, opt, fl }
+#define EXT(k, n, opt) [k] = { { NODE_FIELD_CHILD, NODE_FIELD_EXT }, n, n / 2, opt, 0 }
+#define LIST(k) [k] = { { NODE_FIELD_LIST, NODE_FIELD_COUNT }, NODE_ARITY_LIST, 0, 0, 0 }
+
+const NodeLayout node_layout[256] = {
+    SLOTS(NODE_BINARY,     CHILD, CHILD, 2, 0,      NODE_LAYOUT_OP),
+    SLOTS(NODE_ASSIGN,     CHILD, CHILD, 2, 0,      NODE_LAYOUT_OP),
+    SLOTS(NODE_UNARY,      CHILD, NONE,  1, 0,      NODE_LAYOUT_OP),
+    SLOTS(NODE_EXPR_STMT,  CHILD, NONE,  1, 0,      0),
+    SLOTS(NODE_DECLARATOR, CHILD, CHILD, 2, 1 << 1, 0),
+    SLOTS(NODE_IMPORT_SPEC, CHILD, CHILD, 2, 0,     0),
+    SLOTS(NODE_EXPORT,     CHILD, NONE,  1, 0,      0),
+    EXT(NODE_IF,      3, 1 << 2),
+    EXT(NODE_TERNARY, 3, 0),
+    EXT(NODE_FOR,     4, 1 << 0 | 1 << 1 | 1 << 2),
+    EXT(NODE_TRY,     3, 1 << 1 | 1 << 2),
+    LIST(NODE_BLOCK), LIST(NODE_PROGRAM), LIST(NODE_SEQUENCE), LIST(NODE_VAR_DECL),
+    LIST(NODE_IMPORT),
+};
+
+#undef SLOTS
+#undef EXT
+#undef LIST
+
+#define FOR_EACH_CHILD(arr, n, c, body) do { \
+    uint32_t _k = node_child_count(n); \
+    for (uint32_t _i = 0; _i < _k; _i++) { \
+        uint32_t c = node_child((arr), (n), _i); \
+        body; \
+    } \
+} while (0)
+
+static uint32_t *alloc_stack(uint32_t count) {
+    uint32_t *stack = malloc((size_t)count * sizeof(uint32_t));
+    if (!stack) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+    return stack;
+}
+
+typedef struct {
+    uint8_t  *live;
+    uint32_t *stack;
+    uint32_t  sp;
+    uint32_t  bound;
+} LiveMark;
+
+// Children above bound were already passed by the sweep (relinked runs
+// follow their owner) and are finished off from the stack instead
+static void mark_one(LiveMark *m, uint32_t idx) {
+    if (m->live[idx]) return;
+    m->live[idx] = 1;
+    if (idx > m->bound) m->stack[m->sp++] = idx;
+}
+
+static void mark_children(const NodeArray *arr, LiveMark *m, uint32_t idx) {
+    const Node *n = &arr->nodes[idx];
+    FOR_EACH_CHILD(arr, n, c, mark_one(m, c));
+    // The extension run is storage of idx: live, but nothing to descend into
+    for (uint32_t i = 0; i < node_layout[n->kind].ext; i++)
+        m->live[n->data[1] + i] = 1;
+}
+
+void node_mark_live(const NodeArray *arr, uint8_t *live) {
+    if (!NODE_VALID(arr->root)) return;
+
+    // Each node is pushed at most once, when it is first marked
+    LiveMark m = { live, alloc_stack(arr->count), 0, arr->root };
+
+    // Children precede parents: one reverse sweep marks everything
+    live[arr->root] = 1;
+    for (uint32_t i = arr->root; i > 0; i--) {
+        if (!live[i]) continue;
+        m.bound = i;
+        mark_children(arr, &m, i);
+        while (m.sp)
+            mark_children(arr, &m, m.stack[--m.sp]);
+    }
+    live[NODE_NULL_IDX] = 0;
+    free(m.stack);
+}
+
+typedef struct {
+    uint32_t *parent;
+    uint32_t *stack;
+    uint32_t  sp;
+    uint32_t  bound;
+} ParentLink;
+
+static void link_children(const NodeArray *arr, ParentLink *p, uint32_t idx) {
+    FOR_EACH_CHILD(arr, &arr->nodes[idx], c, {
+        if (NODE_VALID(c) && !p->parent[c]) {
+            p->parent[c] = idx;
+            if (c > p->bound) {
+                if (!p->stack) p->stack = alloc_stack(arr->count);
+                p->stack[p->sp++] = c;
+            }
+        }
+    });
+}
+
+void node_build_parents(const NodeArray *arr, uint32_t *parent) {
+    memset(parent, 0, (size_t)arr->count * sizeof(uint32_t));
+    if (!NODE_VALID(arr->root)) return;
+
+    // Same sweep as node_mark_live with parent[] as the mark. Only runs
+    // relinked past their owner need the stack, allocated on first use.
+    ParentLink p = { parent, NULL, 0, arr->root };
+    for (uint32_t i = arr->root; i > 0; i--) {
+        if (i != arr->root && !parent[i]) continue;
+        p.bound = i;
+        link_children(arr, &p, i);
+        while (p.sp)
+            link_children(arr, &p, p.stack[--p.sp]);
+    }
+    free(p.stack);
+}
+
+void node_build_siblings(const NodeArray *arr, const uint32_t *parent, uint32_t *next) {
+    memset(next, 0, (size_t)arr->count * sizeof(uint32_t));
+    for (uint32_t i = 1; i < arr->count; i++) {
+        if (i != arr->root && !parent[i]) continue;
+        uint32_t prev = 0;
+        FOR_EACH_CHILD(arr, &arr->nodes[i], c, {
+            if (NODE_VALID(c)) {
+                if (prev) next[prev] = c;
+                prev = c;
+            }
+        });
+    }
+}
+
+static int fail(NodeError *err, uint32_t idx, const char *msg) {
+    err->idx = idx;
+    err->msg = msg;
+    return -1;
+}
+
+// Per-slot checks; token says which side of token_end the slot is on
+static const char *slot_error(const Node *n, int token) {
+    if (token && !IS_TOKEN(n->kind)) return "non-token kind below token_end";
+    if (!token && !IS_LEAF(n->kind) && !IS_COMPOUND(n->kind))
+        return "keyword, punctuation or operator token past token_end";
+    if (n->kind >= NODE_COUNT) return "unknown node kind";
+    if (IS_TOKEN(n->kind) && n->op == NODE_LEN_OVERFLOW && n->data[1] <= n->start)
+        return "overflowed token does not end past its start";
+    return NULL;
+}
+
+static int scan_slots(const Node *nodes, uint32_t from, uint32_t to, int token,
+                      NodeError *err) {
+    uint32_t i = from;
+#ifdef __AVX512BW__
+    // Four nodes per 512-bit load, one per 128-bit lane: dword 0 of a lane
+    // is kind | flags << 8 | op << 16, dword 1 start, dword 3 data[1]
+    const __m512i byte = _mm512_set1_epi32(0xFF);
+    for (; i < to; i += 4) {
+        __mmask16 lanes = (__mmask16)(to - i >= 4 ? 0xFFFF : (1u << 4 * (to - i)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi32(lanes, &nodes[i]);
+        __m512i kind = _mm512_and_si512(v, byte);
+        __mmask16 head = lanes & 0x1111;
+        __mmask16 tok = _mm512_mask_cmplt_epu32_mask(head, kind, _mm512_set1_epi32(128));
+        __mmask16 bad;
+        if (token) {
+            bad = head & ~tok;
+        } else {
+            bad = _mm512_mask_cmpge_epu32_mask(tok, kind, _mm512_set1_epi32(16)) |
+                  _mm512_mask_cmpge_epu32_mask(head, kind, _mm512_set1_epi32(NODE_COUNT));
+        }
+        __mmask16 ovf = _mm512_mask_cmpeq_epi32_mask(tok, _mm512_srli_epi32(v, 16),
+                                                     _mm512_set1_epi32(NODE_LEN_OVERFLOW));
+        __m512i end = _mm512_shuffle_epi32(v, _MM_PERM_DDDD);
+        __m512i start = _mm512_shuffle_epi32(v, _MM_PERM_BBBB);
+        bad |= _mm512_mask_cmple_epu32_mask(ovf, end, start);
+        if (bad) {
+            // Name the first culprit with the scalar checks
+            i += (uint32_t)__builtin_ctz(bad) / 4;
+            return fail(err, i, slot_error(&nodes[i], token));
+        }
+    }
+#else
+    for (; i < to; i++) {
+        const char *msg = slot_error(&nodes[i], token);
+        if (msg) return fail(err, i, msg);
+    }
+#endif
+    return 0;
+}
+
+typedef struct {
+    const NodeArray *arr;
+    uint8_t   *seen;
+    uint32_t  *stack;
+    uint32_t   sp;
+    uint32_t   bound;
+    NodeError *err;
+} Validate;
+
+// One child of parent: in range, ordered, not a bare token, reached once
+static int check_child_slow(Validate *v, uint32_t parent, uint32_t c, int optional) {
+    const NodeArray *arr = v->arr;
+    if (!NODE_VALID(c)) return optional ? 0 : fail(v->err, parent, "required child missing");
+    if (c >= arr->count) return fail(v->err, parent, "child index out of range");
+    if (c >= parent && c <= arr->root) return fail(v->err, parent, "child does not precede its parent");
+    uint8_t kind = arr->nodes[c].kind;
+    if (IS_TOKEN(kind) && !IS_LEAF(kind)) return fail(v->err, c, "token kind used as an AST child");
+    if (kind == NODE_EXT) return fail(v->err, c, "extension slot used as a child");
+    if (v->seen[c]) return fail(v->err, c, "node reached twice");
+    v->seen[c] = 1;
+    if (c > v->bound) {
+        if (!v->stack) v->stack = alloc_stack(arr->count);
+        v->stack[v->sp++] = c;
+    }
+    return 0;
+}
+
+// The common case inline: a first sighting below the sweep position (so
+// in range and before its parent) of a leaf or a compound
+static inline int check_child(Validate *v, uint32_t parent, uint32_t c, int optional) {
+    if (c - 1 < v->bound - 1 && !v->seen[c]) {
+        uint8_t kind = v->arr->nodes[c].kind;
+        if (IS_LEAF(kind) || (IS_COMPOUND(kind) && kind != NODE_EXT)) {
+            v->seen[c] = 1;
+            return 0;
+        }
+    }
+    return check_child_slow(v, parent, c, optional);
+}
+
+// Operator kinds plus the keywords that parse as unary or binary operators
+static int is_op(uint16_t op) {
+    return IS_OPERATOR(op) || op == NODE_KW_IN || op == NODE_KW_INSTANCEOF ||
+           op == NODE_KW_TYPEOF || op == NODE_KW_VOID || op == NODE_KW_DELETE;
+}
+
+static int check_node(Validate *v, uint32_t idx) {
+    const NodeArray *arr = v->arr;
+    const Node *n = &arr->nodes[idx];
+    const NodeLayout *l = &node_layout[n->kind];
+    if ((l->flags & NODE_LAYOUT_OP) && !is_op(n->op))
+        return fail(v->err, idx, "op is not an operator");
+
+    if (l->arity == NODE_ARITY_LIST) {
+        uint32_t first = n->data[0], count = n->data[1];
+        if (count && (first == 0 || first >= arr->count || count > arr->count - first))
+            return fail(v->err, idx, "list run out of range");
+        for (uint32_t i = 0; i < count; i++)
+            if (check_child(v, idx, first + i, 0) < 0) return -1;
+        return 0;
+    }
+    if (l->ext) {
+        uint32_t run = n->data[1];
+        if (run == 0 || run >= arr->count || l->ext > arr->count - run)
+            return fail(v->err, idx, "extension run out of range");
+        if (run + l->ext > idx && run <= arr->root)
+            return fail(v->err, idx, "extension run does not precede its owner");
+        for (uint32_t i = 0; i < l->ext; i++)
+            if (arr->nodes[run + i].kind != NODE_EXT)
+                return fail(v->err, run + i, "extension run slot is not NODE_EXT");
+    }
+    if (!l->ext) {
+        for (uint32_t i = 0; i < l->arity; i++)
+            if (check_child(v, idx, n->data[i], l->optional >> i & 1) < 0) return -1;
+        return 0;
+    }
+    for (uint32_t i = 0; i < l->arity; i++)
+        if (check_child(v, idx, node_child(arr, n, i), l->optional >> i & 1) < 0) return -1;
+    return 0;
+}
+
+int node_array_validate(const NodeArray *arr, NodeError *err) {
+    static const Node zero;
+    if (arr->count == 0 || arr->count > arr->capacity) return fail(err, 0, "count out of range");
+    if (memcmp(&arr->nodes[0], &zero, sizeof(Node)) != 0)
+        return fail(err, 0, "sentinel node 0 is not zero");
+    if (arr->token_end > arr->count) return fail(err, 0, "token_end past count");
+    uint32_t split = arr->token_end > 1 ? arr->token_end : 1;
+    if (scan_slots(arr->nodes, 1, split, 1, err) < 0 ||
+        scan_slots(arr->nodes, split, arr->count, 0, err) < 0)
+        return -1;
+
+    if (!NODE_VALID(arr->root)) return 0;
+    if (arr->root >= arr->count) return fail(err, 0, "root out of range");
+    if (arr->nodes[arr->root].kind == NODE_EXT) return fail(err, arr->root, "root is an extension slot");
+
+    // The node_mark_live sweep: descending, so memory is read in order;
+    // only nodes appended past the root go through the stack
+    Validate v = { arr, calloc(arr->count, 1), NULL, 0, arr->root, err };
+    if (!v.seen) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+    v.seen[arr->root] = 1;
+    int rc = 0;
+    for (uint32_t i = arr->root; i > 0 && rc == 0; i--) {
+        if (!v.seen[i]) continue;
+        v.bound = i;
+        rc = check_node(&v, i);
+        while (v.sp && rc == 0)
+            rc = check_node(&v, v.stack[--v.sp]);
+    }
+    free(v.seen);
+    free(v.stack);
+    return rc;
+}
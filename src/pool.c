@@ -0,0 +1,69 @@
+#include "jsopt/pool.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+typedef struct {
+    PoolFn           fn;
+    void            *ctx;
+    uint32_t         njobs;
+    _Atomic uint32_t next;
+    _Atomic uint32_t failed;
+} Pool;
+
+typedef struct {
+    Pool    *pool;
+    uint32_t id;
+} Worker;
+
+// Each claim is one fetch_add on a shared line: negligible next to a
+// whole file, and unlike per-worker queues it keeps global size order
+static void *worker_main(void *arg) {
+    Worker *w = arg;
+    Pool *p = w->pool;
+    uint32_t failed = 0;
+    for (;;) {
+        uint32_t job = atomic_fetch_add_explicit(&p->next, 1, memory_order_relaxed);
+        if (job >= p->njobs) break;
+        if (p->fn(p->ctx, w->id, job) != 0) failed++;
+    }
+    atomic_fetch_add_explicit(&p->failed, failed, memory_order_relaxed);
+    return NULL;
+}
+
+uint32_t pool_run(uint32_t nthreads, uint32_t njobs, PoolFn fn, void *ctx) {
+    if (nthreads > njobs) nthreads = njobs;
+    if (nthreads == 0) nthreads = 1;
+
+    Pool pool = { fn, ctx, njobs, 0, 0 };
+    Worker   *workers = malloc(nthreads * sizeof(Worker));
+    pthread_t *threads = malloc(nthreads * sizeof(pthread_t));
+    if (!workers || !threads) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+
+    // Fall back to fewer threads if creation fails; worker 0 always runs
+    uint32_t started = 1;
+    for (uint32_t i = 1; i < nthreads; i++) {
+        workers[i] = (Worker){ &pool, i };
+        if (pthread_create(&threads[i], NULL, worker_main, &workers[i]) != 0)
+            break;
+        started++;
+    }
+    workers[0] = (Worker){ &pool, 0 };
+    worker_main(&workers[0]);
+    for (uint32_t i = 1; i < started; i++)
+        pthread_join(threads[i], NULL);
+
+    free(threads);
+    free(workers);
+    return atomic_load(&pool.failed);
+}
+
+uint32_t pool_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (uint32_t)n : 1;
+}
@@ -0,0 +1,215 @@
+#include "jsopt/sink.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+// Two entries: one write in flight plus headroom
+#define SINK_RING_DEPTH 2
+
+struct SinkRing {
+    int                  fd;
+    unsigned            *sq_tail, *sq_mask, *sq_array;
+    unsigned            *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void                *sq_map, *cq_map;
+    size_t               sq_size, cq_size, sqes_size;
+};
+
+static void ring_free(SinkRing *r) {
+    if (r->sqes) munmap(r->sqes, r->sqes_size);
+    if (r->cq_map && r->cq_map != r->sq_map) munmap(r->cq_map, r->cq_size);
+    if (r->sq_map) munmap(r->sq_map, r->sq_size);
+    if (r->fd >= 0) close(r->fd);
+    free(r);
+}
+
+// NULL when io_uring is missing, disabled (seccomp, sysctl) or too old to
+// write at the current file position
+static SinkRing *ring_init(void) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    int fd = (int)syscall(__NR_io_uring_setup, SINK_RING_DEPTH, &p);
+    if (fd < 0) return NULL;
+
+    SinkRing *r = calloc(1, sizeof(*r));
+    if (!r) {
+        close(fd);
+        return NULL;
+    }
+    r->fd = fd;
+    if (!(p.features & IORING_FEAT_RW_CUR_POS)) goto fail;
+
+    r->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    r->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (r->cq_size > r->sq_size) r->sq_size = r->cq_size;
+        r->cq_size = r->sq_size;
+    }
+    r->sq_map = mmap(NULL, r->sq_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (r->sq_map == MAP_FAILED) {
+        r->sq_map = NULL;
+        goto fail;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        r->cq_map = r->sq_map;
+    } else {
+        r->cq_map = mmap(NULL, r->cq_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (r->cq_map == MAP_FAILED) {
+            r->cq_map = NULL;
+            goto fail;
+        }
+    }
+    r->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    r->sqes = mmap(NULL, r->sqes_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (r->sqes == MAP_FAILED) {
+        r->sqes = NULL;
+        goto fail;
+    }
+
+    char *sq = r->sq_map, *cq = r->cq_map;
+    r->sq_tail  = (unsigned *)(sq + p.sq_off.tail);
+    r->sq_mask  = (unsigned *)(sq + p.sq_off.ring_mask);
+    r->sq_array = (unsigned *)(sq + p.sq_off.array);
+    r->cq_head  = (unsigned *)(cq + p.cq_off.head);
+    r->cq_tail  = (unsigned *)(cq + p.cq_off.tail);
+    r->cq_mask  = (unsigned *)(cq + p.cq_off.ring_mask);
+    r->cqes     = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return r;
+
+fail:
+    ring_free(r);
+    return NULL;
+}
+
+static int ring_submit_write(SinkRing *r, int fd, const void *buf, uint32_t len) {
+    unsigned tail = *r->sq_tail, idx = tail & *r->sq_mask;
+    struct io_uring_sqe *sqe = &r->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd     = fd;
+    sqe->addr   = (uint64_t)(uintptr_t)buf;
+    sqe->len    = len;
+    sqe->off    = (uint64_t)-1; // current position; ignored for pipes
+    r->sq_array[idx] = idx;
+    __atomic_store_n(r->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    for (;;) {
+        long n = syscall(__NR_io_uring_enter, r->fd, 1, 0, 0, NULL, 0);
+        if (n == 1) return 0;
+        if (n < 0 && errno == EINTR) continue;
+        // Not consumed: take the entry back so no completion is awaited
+        // and a later enter cannot submit it behind the sync write
+        __atomic_store_n(r->sq_tail, tail, __ATOMIC_RELEASE);
+        return -1;
+    }
+}
+
+// Result of the single write in flight: bytes written or -errno
+static int ring_wait(SinkRing *r) {
+    unsigned head = *r->cq_head;
+    while (head == __atomic_load_n(r->cq_tail, __ATOMIC_ACQUIRE)) {
+        long n = syscall(__NR_io_uring_enter, r->fd, 0, 1,
+                         IORING_ENTER_GETEVENTS, NULL, 0);
+        if (n < 0 && errno != EINTR) return -errno;
+    }
+    int res = r->cqes[head & *r->cq_mask].res;
+    __atomic_store_n(r->cq_head, head + 1, __ATOMIC_RELEASE);
+    return res;
+}
+
+static void write_sync(Sink *s, const char *p, size_t len) {
+    while (len && !s->err) {
+        ssize_t n = write(s->fd, p, len);
+        if (n < 0) {
+            if (errno != EINTR) s->err = errno;
+            continue;
+        }
+        p         += n;
+        len       -= (size_t)n;
+        s->written += (uint64_t)n;
+    }
+}
+
+// Retire the write in flight; a short completion is finished inline
+static void sink_wait(Sink *s) {
+    if (!s->inflight) return;
+    uint32_t len = s->inflight;
+    s->inflight = 0;
+    int res = ring_wait(s->ring);
+    if (res < 0) {
+        if (!s->err) s->err = -res;
+        return;
+    }
+    s->written += (uint64_t)res;
+    if ((uint32_t)res < len)
+        write_sync(s, s->buf[s->cur ^ 1] + res, len - (uint32_t)res);
+}
+
+int sink_open(Sink *s, int fd, unsigned flags) {
+    memset(s, 0, sizeof(*s));
+    char *bufs = mmap(NULL, 2 * (size_t)SINK_CHUNK, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (bufs == MAP_FAILED) return -1;
+    s->fd     = fd;
+    s->buf[0] = bufs;
+    s->buf[1] = bufs + SINK_CHUNK;
+    if (!(flags & SINK_SYNC))
+        s->ring = ring_init();
+    return 0;
+}
+
+// Hand the full buffer to the kernel and switch to the other one, which
+// must first finish its own write
+void sink_rotate(Sink *s) {
+    if (!s->len) return;
+    if (!s->ring || s->err) {
+        write_sync(s, s->buf[s->cur], s->len);
+        s->len = 0;
+        return;
+    }
+    sink_wait(s);
+    if (ring_submit_write(s->ring, s->fd, s->buf[s->cur], s->len) < 0) {
+        write_sync(s, s->buf[s->cur], s->len);
+    } else {
+        s->inflight = s->len;
+        s->cur ^= 1;
+    }
+    s->len = 0;
+}
+
+void sink_write(Sink *s, const void *data, size_t len) {
+    const char *p = data;
+    while (len) {
+        if (s->len == SINK_CHUNK) sink_rotate(s);
+        size_t n = SINK_CHUNK - s->len;
+        if (n > len) n = len;
+        memcpy(s->buf[s->cur] + s->len, p, n);
+        s->len += (uint32_t)n;
+        p      += n;
+        len    -= n;
+    }
+}
+
+int sink_close(Sink *s) {
+    sink_rotate(s);
+    if (s->ring) {
+        sink_wait(s);
+        ring_free(s->ring);
+    }
+    munmap(s->buf[0], 2 * (size_t)SINK_CHUNK);
+    int err = s->err;
+    memset(s, 0, sizeof(*s));
+    s->fd = -1;
+    if (err) {
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "jsopt/source.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Initial read buffer; doubles with mremap
+#define SOURCE_READ_INIT (1u << 16)
+
+static size_t page_round(size_t n) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return (n + page - 1) & ~(page - 1);
+}
+
+static int source_map(Source *src, int fd, size_t len) {
+    // Reserve file + padding as zero pages, then map the file over the
+    // front. The kernel zero-fills the tail of the last file page and the
+    // remaining reservation stays anonymous, so reads up to
+    // len + SOURCE_PADDING never fault, even for page-sized files.
+    size_t total = page_round(len + SOURCE_PADDING);
+    void *base = mmap(NULL, total, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return -1;
+    if (len && mmap(base, len, PROT_READ, MAP_PRIVATE | MAP_FIXED | MAP_POPULATE,
+                    fd, 0) == MAP_FAILED) {
+        int err = errno;
+        munmap(base, total);
+        errno = err;
+        return -1;
+    }
+    madvise(base, total, MADV_SEQUENTIAL);
+
+    src->data     = base;
+    src->len      = (uint32_t)len;
+    src->map      = base;
+    src->map_size = total;
+    return 0;
+}
+
+int source_read_fd(Source *src, int fd) {
+    size_t cap = SOURCE_READ_INIT, len = 0;
+    char *buf = mmap(NULL, cap, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buf == MAP_FAILED) return -1;
+
+    for (;;) {
+        if (cap - len < SOURCE_PADDING + 1) {
+            char *grown = mremap(buf, cap, cap * 2, MREMAP_MAYMOVE);
+            if (grown == MAP_FAILED) goto fail;
+            buf = grown;
+            cap *= 2;
+        }
+        ssize_t n = read(fd, buf + len, cap - len - SOURCE_PADDING);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            goto fail;
+        }
+        if (n == 0) break;
+        len += (size_t)n;
+        if (len > SOURCE_MAX_LEN) {
+            errno = EFBIG;
+            goto fail;
+        }
+    }
+
+    // Anonymous pages are zero and never written past len: padding holds
+    mprotect(buf, cap, PROT_READ);
+    src->data     = buf;
+    src->len      = (uint32_t)len;
+    src->map      = buf;
+    src->map_size = cap;
+    return 0;
+
+fail:;
+    int err = errno;
+    munmap(buf, cap);
+    errno = err;
+    return -1;
+}
+
+int source_open(Source *src, const char *path) {
+    memset(src, 0, sizeof(*src));
+    if (strcmp(path, "-") == 0)
+        return source_read_fd(src, STDIN_FILENO);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    struct stat st;
+    int rc;
+    if (fstat(fd, &st) < 0) {
+        rc = -1;
+    } else if (!S_ISREG(st.st_mode)) {
+        rc = source_read_fd(src, fd);
+    } else if ((uint64_t)st.st_size > SOURCE_MAX_LEN) {
+        errno = EFBIG;
+        rc = -1;
+    } else {
+        rc = source_map(src, fd, (size_t)st.st_size);
+    }
+
+    int err = errno;
+    close(fd); // the mapping keeps its own reference
+    errno = err;
+    return rc;
+}
+
+void source_close(Source *src) {
+    if (src->map)
+        munmap(src->map, src->map_size);
+    memset(src, 0, sizeof(*src));
+}
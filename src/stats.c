@@ -0,0 +1,91 @@
+#include "jsopt/stats.h"
+#include <time.h>
+#include <x86intrin.h>
+#include <sys/resource.h>
+
+const char *const PHASE_NAMES[PHASE_COUNT] = {
+    "read", "lex", "parse", "scope", "mangle", "codegen", "write",
+};
+
+static const char *const CLASS_NAMES[NODE_CLASS_COUNT] = {
+    "leaf", "keyword", "punct", "operator", "compound",
+};
+
+static uint64_t start_tsc, start_ns;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void stats_start(void) {
+    start_ns  = now_ns();
+    start_tsc = __rdtsc();
+}
+
+static NodeClass node_class(uint8_t kind) {
+    if (IS_LEAF(kind))     return NODE_CLASS_LEAF;
+    if (IS_KEYWORD(kind))  return NODE_CLASS_KEYWORD;
+    if (IS_OPERATOR(kind)) return NODE_CLASS_OPERATOR;
+    if (IS_COMPOUND(kind)) return NODE_CLASS_COMPOUND;
+    return NODE_CLASS_PUNCT;
+}
+
+void stats_record_array(Stats *s, const NodeArray *arr) {
+    uint64_t counts[NODE_CLASS_COUNT] = {0};
+    for (uint32_t i = 1; i < arr->count; i++)
+        counts[node_class(arr->nodes[i].kind)]++;
+    for (int c = 0; c < NODE_CLASS_COUNT; c++)
+        s->nodes[c] += counts[c];
+    s->node_bytes += (uint64_t)arr->count * sizeof(Node);
+    if (arr->count > s->peak_nodes) s->peak_nodes = arr->count;
+    s->files++;
+}
+
+void stats_merge(Stats *dst, const Stats *src) {
+    for (int p = 0; p < PHASE_COUNT; p++)
+        dst->phase_cycles[p] += src->phase_cycles[p];
+    for (int c = 0; c < NODE_CLASS_COUNT; c++)
+        dst->nodes[c] += src->nodes[c];
+    dst->node_bytes += src->node_bytes;
+    if (src->peak_nodes > dst->peak_nodes) dst->peak_nodes = src->peak_nodes;
+    dst->files += src->files;
+}
+
+void stats_print_json(const Stats *s, FILE *out) {
+    uint64_t ns = now_ns() - start_ns;
+#ifdef JSOPT_STATS
+    // TSC rate over the whole run; constant-rate TSCs make this exact
+    uint64_t cycles = __rdtsc() - start_tsc;
+    double ns_per_cycle = cycles ? (double)ns / (double)cycles : 0.0;
+#endif
+
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+
+    fprintf(out, "{\n  \"files\": %u,\n  \"phases\": {\n", s->files);
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        const char *sep = p + 1 == PHASE_COUNT ? "" : ",";
+#ifdef JSOPT_STATS
+        if (s->phase_cycles[p]) {
+            fprintf(out, "    \"%s\": {\"cycles\": %llu, \"ns\": %.0f}%s\n", PHASE_NAMES[p],
+                    (unsigned long long)s->phase_cycles[p],
+                    (double)s->phase_cycles[p] * ns_per_cycle, sep);
+            continue;
+        }
+#endif
+        fprintf(out, "    \"%s\": null%s\n", PHASE_NAMES[p], sep);
+    }
+    fprintf(out, "  },\n  \"nodes\": {");
+    for (int c = 0; c < NODE_CLASS_COUNT; c++)
+        fprintf(out, "%s\"%s\": %llu", c ? ", " : "", CLASS_NAMES[c],
+                (unsigned long long)s->nodes[c]);
+    fprintf(out, "},\n");
+    fprintf(out, "  \"node_bytes\": %llu,\n  \"peak_nodes\": %u,\n",
+            (unsigned long long)s->node_bytes, s->peak_nodes);
+    fprintf(out, "  \"minor_faults\": %ld,\n  \"major_faults\": %ld,\n",
+            ru.ru_minflt, ru.ru_majflt);
+    fprintf(out, "  \"peak_rss_kb\": %ld,\n  \"wall_ns\": %llu\n}\n",
+            ru.ru_maxrss, (unsigned long long)ns);
+}
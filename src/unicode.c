@@ -0,0 +1,651 @@
+// Generated by tools/gen_unicode.py; do not edit
+// Source: Python unicodedata 14.0.0 (UAX #31 derivation)
+#include "jsopt/unicode.h"
+
+_Static_assert(UNICODE_ID_LIMIT == 0xE0200, "regenerate unicode.h");
+_Static_assert(UNICODE_ID_BLOCKS == 186, "regenerate unicode.h");
+
+const uint8_t unicode_id_start[UNICODE_ID_LIMIT >> 8] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+    17, 2, 18, 19, 20, 2, 21, 22, 23, 24, 25, 26, 27, 28, 2, 29,
+    30, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 32, 33, 0, 0,
+    34, 35, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 28, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 36, 2, 37, 38, 39, 40, 41, 42, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 43, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 44, 45, 2, 46, 47, 48,
+    49, 50, 51, 52, 53, 54, 2, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 0, 75, 76, 77, 78,
+    2, 2, 2, 79, 80, 81, 0, 0, 0, 0, 0, 0, 0, 0, 0, 82,
+    2, 2, 2, 2, 83, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 2, 84, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 85, 86, 0, 0, 87, 88,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 89, 2, 2, 2, 2, 90, 91, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 92,
+    2, 93, 94, 0, 0, 0, 0, 0, 0, 0, 0, 0, 95, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 96, 97, 98, 99, 0, 0, 0, 0, 0, 0, 0, 100,
+    0, 101, 102, 0, 0, 0, 0, 103, 104, 105, 0, 0, 0, 0, 106, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 107, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 108, 109, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 110, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 111, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 112, 0, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 113, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0,
+};
+
+const uint8_t unicode_id_continue[UNICODE_ID_LIMIT >> 8] = {
+    114, 2, 3, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127,
+    128, 2, 18, 129, 20, 2, 21, 130, 131, 132, 133, 134, 135, 2, 2, 29,
+    136, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 137, 138, 0, 0,
+    139, 35, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 28, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 36, 2, 140, 38, 141, 142, 143, 144, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 43, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 44, 145, 2, 46, 146, 147,
+    49, 148, 149, 150, 151, 54, 2, 55, 56, 57, 152, 59, 60, 153, 154, 155,
+    156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 0, 167, 168, 169, 78,
+    2, 2, 2, 79, 80, 81, 0, 0, 0, 0, 0, 0, 0, 0, 0, 82,
+    2, 2, 2, 2, 83, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 2, 84, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 170, 171, 0, 0, 87, 172,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 89, 2, 2, 2, 2, 90, 91, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 92,
+    2, 93, 94, 0, 0, 0, 0, 0, 0, 0, 0, 0, 173, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 174,
+    0, 175, 176, 0, 96, 97, 98, 177, 0, 0, 178, 0, 0, 0, 0, 100,
+    179, 180, 181, 0, 0, 0, 0, 103, 182, 183, 0, 0, 0, 0, 106, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 184, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 107, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 108, 109, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 110, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 111, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 112, 0, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 113, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 185,
+};
+
+const uint64_t unicode_id_blocks[UNICODE_ID_BLOCKS][4] = {
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0420040000000000ULL, 0xFF7FFFFFFF7FFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x0000501F0003FFC3ULL },
+    { 0x0000000000000000ULL, 0xBCDF000000000000ULL, 0xFFFFFFFBFFFFD740ULL, 0xFFBFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFC03ULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFEFFFFFFFFFFFFULL, 0xFFFFFFFF027FFFFFULL, 0x00000000000001FFULL, 0x000787FFFFFF0000ULL },
+    { 0xFFFFFFFF00000000ULL, 0xFFFEC000000007FFULL, 0xFFFFFFFFFFFFFFFFULL, 0x9C00C060002FFFFFULL },
+    { 0x0000FFFFFFFD0000ULL, 0xFFFFFFFFFFFFE000ULL, 0x0002003FFFFFFFFFULL, 0x043007FFFFFFFC00ULL },
+    { 0x00000110043FFFFFULL, 0xFFFF07FF01FFFFFFULL, 0xFFFFFFFF00007EFFULL, 0x00000000000003FFULL },
+    { 0x23FFFFFFFFFFFFF0ULL, 0xFFFE0003FF010000ULL, 0x23C5FDFFFFF99FE1ULL, 0x10030003B0004000ULL },
+    { 0x036DFDFFFFF987E0ULL, 0x001C00005E000000ULL, 0x23EDFDFFFFFBBFE0ULL, 0x0200000300010000ULL },
+    { 0x23EDFDFFFFF99FE0ULL, 0x00020003B0000000ULL, 0x03FFC718D63DC7E8ULL, 0x0000000000010000ULL },
+    { 0x23FFFDFFFFFDDFE0ULL, 0x0000000327000000ULL, 0x23EFFDFFFFFDDFE1ULL, 0x0006000360000000ULL },
+    { 0x27FFFFFFFFFDDFF0ULL, 0xFC00000380704000ULL, 0x2FFBFFFFFC7FFFE0ULL, 0x000000000000007FULL },
+    { 0x000DFFFFFFFFFFFEULL, 0x000000000000007FULL, 0x200DFFAFFFFFF7D6ULL, 0x00000000F000005FULL },
+    { 0x0000000000000001ULL, 0x00001FFFFFFFFEFFULL, 0x0000000000001F00ULL, 0x0000000000000000ULL },
+    { 0x800007FFFFFFFFFFULL, 0xFFE1C0623C3F0000ULL, 0xFFFFFFFF00004003ULL, 0xF7FFFFFFFFFF20BFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFF3D7F3DFFULL, 0x7F3DFFFFFFFF3DFFULL, 0xFFFFFFFFFF7FFF3DULL },
+    { 0xFFFFFFFFFF3DFFFFULL, 0x0000000007FFFFFFULL, 0xFFFFFFFF0000FFFFULL, 0x3F3FFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFF9FFFFFFFFFFFULL, 0xFFFFFFFF07FFFFFEULL, 0x01FFC7FFFFFFFFFFULL },
+    { 0x0003FFFF8003FFFFULL, 0x0001DFFF0003FFFFULL, 0x000FFFFFFFFFFFFFULL, 0x0000000010800000ULL },
+    { 0xFFFFFFFF00000000ULL, 0x01FFFFFFFFFFFFFFULL, 0xFFFF05FFFFFFFFFFULL, 0x003FFFFFFFFFFFFFULL },
+    { 0x000000007FFFFFFFULL, 0x001F3FFFFFFF0000ULL, 0xFFFF0FFFFFFFFFFFULL, 0x00000000000003FFULL },
+    { 0xFFFFFFFF007FFFFFULL, 0x00000000001FFFFFULL, 0x0000008000000000ULL, 0x0000000000000000ULL },
+    { 0x000FFFFFFFFFFFE0ULL, 0x0000000000001FE0ULL, 0xFC00C001FFFFFFF8ULL, 0x0000003FFFFFFFFFULL },
+    { 0x0000000FFFFFFFFFULL, 0x3FFFFFFFFC00E000ULL, 0xE7FFFFFFFFFF01FFULL, 0x046FDE0000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFF3F3FFFFFULL, 0x3FFFFFFFAAFF3F3FULL, 0x5FDFFFFFFFFFFFFFULL, 0x1FDC1FFF0FCF1FDCULL },
+    { 0x0000000000000000ULL, 0x8002000000000000ULL, 0x000000001FFF0000ULL, 0x0000000000000000ULL },
+    { 0xF3FFFD503F2FFC84ULL, 0xFFFFFFFF000043E0ULL, 0x00000000000001FFULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x000C781FFFFFFFFFULL },
+    { 0xFFFF20BFFFFFFFFFULL, 0x000080FFFFFFFFFFULL, 0x7F7F7F7F007FFFFFULL, 0x000000007F7F7F7FULL },
+    { 0x1F3E03FE000000E0ULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFEF87FFFFFULL, 0xF7FFFFFFFFFFFFFFULL },
+    { 0xFFFEFFFFFFFFFFE0ULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFF00007FFFULL, 0xFFFF000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x0000000000001FFFULL, 0x3FFFFFFFFFFF0000ULL },
+    { 0x00000C00FFFF1FFFULL, 0x80007FFFFFFFFFFFULL, 0xFFFFFFFF3FFFFFFFULL, 0x0000FFFFFFFFFFFFULL },
+    { 0xFFFFFFFCFF800000ULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFF9FFULL, 0xFFFC000003EB07FFULL },
+    { 0x00000007FFFFF7BBULL, 0x000FFFFFFFFFFFFFULL, 0x000FFFFFFFFFFFFCULL, 0x68FC000000000000ULL },
+    { 0xFFFF003FFFFFFC00ULL, 0x1FFFFFFF0000007FULL, 0x0007FFFFFFFFFFF0ULL, 0x7C00FFDF00008000ULL },
+    { 0x000001FFFFFFFFFFULL, 0xC47FFFFF00000FF7ULL, 0x3E62FFFFFFFFFFFFULL, 0x001C07FF38000005ULL },
+    { 0xFFFF7F7F007E7E7EULL, 0xFFFF03FFF7FFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x00000007FFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFF000FFFFFFFFFULL, 0x0FFFFFFFFFFFF87FULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFF3FFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x0000000003FFFFFFULL },
+    { 0x5F7FFDFFA0F8007FULL, 0xFFFFFFFFFFFFFFDBULL, 0x0003FFFFFFFFFFFFULL, 0xFFFFFFFFFFF80000ULL },
+    { 0x3FFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFF0000ULL, 0xFFFFFFFFFFFCFFFFULL, 0x0FFF0000000000FFULL },
+    { 0x0000000000000000ULL, 0xFFDF000000000000ULL, 0xFFFFFFFFFFFFFFFFULL, 0x1FFFFFFFFFFFFFFFULL },
+    { 0x07FFFFFE00000000ULL, 0xFFFFFFC007FFFFFEULL, 0x7FFFFFFFFFFFFFFFULL, 0x000000001CFCFCFCULL },
+    { 0xB7FFFF7FFFFFEFFFULL, 0x000000003FFF3FFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x07FFFFFFFFFFFFFFULL },
+    { 0x0000000000000000ULL, 0x001FFFFFFFFFFFFFULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0xFFFFFFFF1FFFFFFFULL, 0x000000000001FFFFULL },
+    { 0xFFFFE000FFFFFFFFULL, 0x003FFFFFFFFF07FFULL, 0xFFFFFFFF3FFFFFFFULL, 0x00000000003EFF0FULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFF00003FFFFFFFULL, 0x0FFFFFFFFF0FFFFFULL },
+    { 0xFFFF00FFFFFFFFFFULL, 0xF7FF000FFFFFFFFFULL, 0x1BFBFFFBFFB7F7FFULL, 0x0000000000000000ULL },
+    { 0x007FFFFFFFFFFFFFULL, 0x000000FF003FFFFFULL, 0x07FDFFFFFFFFFFBFULL, 0x0000000000000000ULL },
+    { 0x91BFFFFFFFFFFD3FULL, 0x007FFFFF003FFFFFULL, 0x000000007FFFFFFFULL, 0x0037FFFF00000000ULL },
+    { 0x03FFFFFF003FFFFFULL, 0x0000000000000000ULL, 0xC0FFFFFFFFFFFFFFULL, 0x0000000000000000ULL },
+    { 0x003FFFFFFEEF0001ULL, 0x1FFFFFFF00000000ULL, 0x000000001FFFFFFFULL, 0x0000001FFFFFFEFFULL },
+    { 0x003FFFFFFFFFFFFFULL, 0x0007FFFF003FFFFFULL, 0x000000000003FFFFULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x00000000000001FFULL, 0x0007FFFFFFFFFFFFULL, 0x0007FFFFFFFFFFFFULL },
+    { 0x0000000FFFFFFFFFULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x000303FFFFFFFFFFULL, 0x0000000000000000ULL },
+    { 0xFFFF00801FFFFFFFULL, 0xFFFF00000000003FULL, 0xFFFF000000000003ULL, 0x007FFFFF0000001FULL },
+    { 0x00FFFFFFFFFFFFF8ULL, 0x0026000000000000ULL, 0x0000FFFFFFFFFFF8ULL, 0x000001FFFFFF0000ULL },
+    { 0x0000007FFFFFFFF8ULL, 0x0047FFFFFFFF0090ULL, 0x0007FFFFFFFFFFF8ULL, 0x000000001400001EULL },
+    { 0x00000FFFFFFBFFFFULL, 0x0000000000000000ULL, 0xFFFF01FFBFFFBD7FULL, 0x000000007FFFFFFFULL },
+    { 0x23EDFDFFFFF99FE0ULL, 0x00000003E0010000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x001FFFFFFFFFFFFFULL, 0x0000000380000780ULL, 0x0000FFFFFFFFFFFFULL, 0x00000000000000B0ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00007FFFFFFFFFFFULL, 0x000000000F000000ULL },
+    { 0x0000FFFFFFFFFFFFULL, 0x0000000000000010ULL, 0x010007FFFFFFFFFFULL, 0x0000000000000000ULL },
+    { 0x0000000007FFFFFFULL, 0x000000000000007FULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x00000FFFFFFFFFFFULL, 0x0000000000000000ULL, 0xFFFFFFFF00000000ULL, 0x80000000FFFFFFFFULL },
+    { 0x8000FFFFFF6FF27FULL, 0x0000000000000002ULL, 0xFFFFFCFF00000000ULL, 0x0000000A0001FFFFULL },
+    { 0x0407FFFFFFFFF801ULL, 0xFFFFFFFFF0010000ULL, 0xFFFF0000200003FFULL, 0x01FFFFFFFFFFFFFFULL },
+    { 0x00007FFFFFFFFDFFULL, 0xFFFC000000000001ULL, 0x000000000000FFFFULL, 0x0000000000000000ULL },
+    { 0x0001FFFFFFFFFB7FULL, 0xFFFFFDBF00000040ULL, 0x00000000010003FFULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0007FFFF00000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0001000000000000ULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x0000000003FFFFFFULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x00007FFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x000000000000000FULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0xFFFFFFFFFFFF0000ULL, 0x0001FFFFFFFFFFFFULL },
+    { 0x00007FFFFFFFFFFFULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x000000000000007FULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x01FFFFFFFFFFFFFFULL, 0xFFFF00007FFFFFFFULL, 0x7FFFFFFFFFFFFFFFULL, 0x00003FFFFFFF0000ULL },
+    { 0x0000FFFFFFFFFFFFULL, 0xE0FFFFF80000000FULL, 0x000000000000FFFFULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0xFFFFFFFFFFFFFFFFULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x00000000000107FFULL, 0x00000000FFF80000ULL, 0x0000000B00000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x00FFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x00000000003FFFFFULL },
+    { 0x00000000000001FFULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x6FEF000000000000ULL },
+    { 0x00000007FFFFFFFFULL, 0xFFFF00F000070000ULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x0FFFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x1FFF07FFFFFFFFFFULL, 0x0000000003FF01FFULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFDFFFFFULL, 0xEBFFDE64DFFFFFFFULL, 0xFFFFFFFFFFFFFFEFULL },
+    { 0x7BFFFFFFDFDFE7BFULL, 0xFFFFFFFFFFFDFC5FULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFF3FFFFFFFFFULL, 0xF7FFFFFFF7FFFFFDULL },
+    { 0xFFDFFFFFFFDFFFFFULL, 0xFFFF7FFFFFFF7FFFULL, 0xFFFFFDFFFFFFFDFFULL, 0x0000000000000FF7ULL },
+    { 0x000000007FFFFFFFULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x3F801FFFFFFFFFFFULL, 0x0000000000004000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00003FFFFFFF0000ULL, 0x00000FFFFFFFFFFFULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x7FFF6F7F00000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x000000000000001FULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x000000000000080FULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0AF7FE96FFFFFFEFULL, 0x5EF7F796AA96EA84ULL, 0x0FFFFBEE0FFFFBFFULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x00000000FFFFFFFFULL },
+    { 0x01FFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFF3FFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFF0003FFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x00000001FFFFFFFFULL },
+    { 0x000000003FFFFFFFULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x00000000000007FFULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x04A0040000000000ULL, 0xFF7FFFFFFF7FFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xBCDFFFFFFFFFFFFFULL, 0xFFFFFFFBFFFFD7C0ULL, 0xFFBFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFCFBULL, 0xFFFFFFFFFFFFFFFFULL },
+    { 0xFFFEFFFFFFFFFFFFULL, 0xFFFFFFFF027FFFFFULL, 0xBFFFFFFFFFFE01FFULL, 0x000787FFFFFF00B6ULL },
+    { 0xFFFFFFFF07FF0000ULL, 0xFFFFC3FFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x9FFFFDFF9FEFFFFFULL },
+    { 0xFFFFFFFFFFFF0000ULL, 0xFFFFFFFFFFFFE7FFULL, 0x0003FFFFFFFFFFFFULL, 0x243FFFFFFFFFFFFFULL },
+    { 0x00003FFFFFFFFFFFULL, 0xFFFF07FF0FFFFFFFULL, 0xFFFFFFFFFF007EFFULL, 0xFFFFFFFBFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFEFFCFFFFFFFFFULL, 0xF3C5FDFFFFF99FEFULL, 0x5003FFCFB080799FULL },
+    { 0xD36DFDFFFFF987EEULL, 0x003FFFC05E023987ULL, 0xF3EDFDFFFFFBBFEEULL, 0xFE00FFCF00013BBFULL },
+    { 0xF3EDFDFFFFF99FEEULL, 0x0002FFCFB0E0399FULL, 0xC3FFC718D63DC7ECULL, 0x0000FFC000813DC7ULL },
+    { 0xF3FFFDFFFFFDDFFFULL, 0x0000FFCF27603DDFULL, 0xF3EFFDFFFFFDDFEFULL, 0x0006FFCF60603DDFULL },
+    { 0xFFFFFFFFFFFDDFFFULL, 0xFC00FFCF80F07DDFULL, 0x2FFBFFFFFC7FFFEEULL, 0x000CFFC0FF5F847FULL },
+    { 0x07FFFFFFFFFFFFFEULL, 0x0000000003FF7FFFULL, 0x3FFFFFAFFFFFF7D6ULL, 0x00000000F3FF3F5FULL },
+    { 0xC2A003FF03000001ULL, 0xFFFE1FFFFFFFFEFFULL, 0x1FFFFFFFFEFFFFDFULL, 0x0000000000000040ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFF03FFULL, 0xFFFFFFFF3FFFFFFFULL, 0xF7FFFFFFFFFF20BFULL },
+    { 0xFFFFFFFFFF3DFFFFULL, 0x0003FE00E7FFFFFFULL, 0xFFFFFFFF0000FFFFULL, 0x3F3FFFFFFFFFFFFFULL },
+    { 0x001FFFFF803FFFFFULL, 0x000DDFFF000FFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x000003FF308FFFFFULL },
+    { 0xFFFFFFFF03FFB800ULL, 0x01FFFFFFFFFFFFFFULL, 0xFFFF07FFFFFFFFFFULL, 0x003FFFFFFFFFFFFFULL },
+    { 0x0FFF0FFF7FFFFFFFULL, 0x001F3FFFFFFFFFC0ULL, 0xFFFF0FFFFFFFFFFFULL, 0x0000000007FF03FFULL },
+    { 0xFFFFFFFF0FFFFFFFULL, 0x9FFFFFFF7FFFFFFFULL, 0xBFFF008003FF03FFULL, 0x0000000000007FFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x000FF80003FF1FFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x000FFFFFFFFFFFFFULL },
+    { 0x00FFFFFFFFFFFFFFULL, 0x3FFFFFFFFFFFE3FFULL, 0xE7FFFFFFFFFF01FFULL, 0x07FFFFFFFFF70000ULL },
+    { 0x8000000000000000ULL, 0x8002000000100001ULL, 0x000000001FFF0000ULL, 0x0001FFE21FFF0000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x000FF81FFFFFFFFFULL },
+    { 0xFFFF20BFFFFFFFFFULL, 0x800080FFFFFFFFFFULL, 0x7F7F7F7F007FFFFFULL, 0xFFFFFFFF7F7F7F7FULL },
+    { 0x1F3EFFFE000000E0ULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFEFE7FFFFFULL, 0xF7FFFFFFFFFFFFFFULL },
+    { 0x00000FFFFFFF1FFFULL, 0xBFF0FFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x0003FFFFFFFFFFFFULL },
+    { 0x000010FFFFFFFFFFULL, 0x000FFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xE8FFFFFF03FF003FULL },
+    { 0xFFFF3FFFFFFFFFFFULL, 0x1FFFFFFF000FFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x7FFFFFFF03FF8001ULL },
+    { 0x007FFFFFFFFFFFFFULL, 0xFC7FFFFF03FF3FFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x007CFFFF38000007ULL },
+    { 0xFFFF7F7F007E7E7EULL, 0xFFFF03FFF7FFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x03FF37FFFFFFFFFFULL },
+    { 0x5F7FFDFFE0F8007FULL, 0xFFFFFFFFFFFFFFDBULL, 0x0003FFFFFFFFFFFFULL, 0xFFFFFFFFFFF80000ULL },
+    { 0x0018FFFF0000FFFFULL, 0xFFDF00000000E000ULL, 0xFFFFFFFFFFFFFFFFULL, 0x1FFFFFFFFFFFFFFFULL },
+    { 0x87FFFFFE03FF0000ULL, 0xFFFFFFC007FFFFFEULL, 0x7FFFFFFFFFFFFFFFULL, 0x000000001CFCFCFCULL },
+    { 0x0000000000000000ULL, 0x001FFFFFFFFFFFFFULL, 0x0000000000000000ULL, 0x2000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0xFFFFFFFF1FFFFFFFULL, 0x000000010001FFFFULL },
+    { 0xFFFFE000FFFFFFFFULL, 0x07FFFFFFFFFF07FFULL, 0xFFFFFFFF3FFFFFFFULL, 0x00000000003EFF0FULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFF03FF3FFFFFFFULL, 0x0FFFFFFFFF0FFFFFULL },
+    { 0x873FFFFFFEEFF06FULL, 0x1FFFFFFF00000000ULL, 0x000000001FFFFFFFULL, 0x0000007FFFFFFEFFULL },
+    { 0x03FF00FFFFFFFFFFULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00031BFFFFFFFFFFULL, 0x0000000000000000ULL },
+    { 0xFFFF00801FFFFFFFULL, 0xFFFF00000001FFFFULL, 0xFFFF00000000003FULL, 0x007FFFFF0000001FULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x803FFFC00000007FULL, 0x07FFFFFFFFFFFFFFULL, 0x03FF01FFFFFF0004ULL },
+    { 0xFFDFFFFFFFFFFFFFULL, 0x004FFFFFFFFF00F0ULL, 0xFFFFFFFFFFFFFFFFULL, 0x0000000017FFDE1FULL },
+    { 0x40FFFFFFFFFBFFFFULL, 0x0000000000000000ULL, 0xFFFF01FFBFFFBD7FULL, 0x03FF07FFFFFFFFFFULL },
+    { 0xFBEDFDFFFFF99FEFULL, 0x001F1FCFE081399FULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x00000003C3FF07FFULL, 0xFFFFFFFFFFFFFFFFULL, 0x0000000003FF00BFULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0xFF3FFFFFFFFFFFFFULL, 0x000000003F000001ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x0000000003FF0011ULL, 0x01FFFFFFFFFFFFFFULL, 0x00000000000003FFULL },
+    { 0x03FF0FFFE7FFFFFFULL, 0x000000000000007FULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x07FFFFFFFFFFFFFFULL, 0x0000000000000000ULL, 0xFFFFFFFF00000000ULL, 0x800003FFFFFFFFFFULL },
+    { 0xF9BFFFFFFF6FF27FULL, 0x0000000003FF000FULL, 0xFFFFFCFF00000000ULL, 0x0000001BFCFFFFFFULL },
+    { 0x7FFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFF0080ULL, 0xFFFF000023FFFFFFULL, 0x01FFFFFFFFFFFFFFULL },
+    { 0xFF7FFFFFFFFFFDFFULL, 0xFFFC000003FF0001ULL, 0x007FFEFFFFFCFFFFULL, 0x0000000000000000ULL },
+    { 0xB47FFFFFFFFFFB7FULL, 0xFFFFFDBF03FF00FFULL, 0x000003FF01FB7FFFULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x007FFFFF00000000ULL },
+    { 0x01FFFFFFFFFFFFFFULL, 0xFFFF03FF7FFFFFFFULL, 0x7FFFFFFFFFFFFFFFULL, 0x001F3FFFFFFF03FFULL },
+    { 0x007FFFFFFFFFFFFFULL, 0xE0FFFFF803FF000FULL, 0x000000000000FFFFULL, 0x0000000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFF87FFULL, 0x00000000FFFF80FFULL, 0x0003001B00000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x1FFF07FFFFFFFFFFULL, 0x0000000063FF01FFULL, 0x0000000000000000ULL },
+    { 0xFFFF3FFFFFFFFFFFULL, 0x000000000000007FULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0xF807E3E000000000ULL, 0x00003C0000000FE7ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x000000000000001CULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0xFFDFFFFFFFDFFFFFULL, 0xFFFF7FFFFFFF7FFFULL, 0xFFFFFDFFFFFFFDFFULL, 0xFFFFFFFFFFFFCFF7ULL },
+    { 0xF87FFFFFFFFFFFFFULL, 0x00201FFFFFFFFFFFULL, 0x0000FFFEF8000010ULL, 0x0000000000000000ULL },
+    { 0x000007DBF9FFFF7FULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x3FFF1FFFFFFFFFFFULL, 0x00000000000043FFULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x00007FFFFFFF0000ULL, 0x03FFFFFFFFFFFFFFULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x00000000007F001FULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0x0000000003FF0FFFULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+    { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x03FF000000000000ULL },
+    { 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x0000FFFFFFFFFFFFULL },
+};
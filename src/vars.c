@@ -0,0 +1,130 @@
+#include "jsopt/vars.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+// Bound on the `in` search; deeper initializers are never hoisted
+#define IN_MAX_DEPTH 32
+
+#define DECL_KIND(n) ((n)->flags & (NODE_FLAG_CONST | NODE_FLAG_LET))
+
+// 0 only when the expression provably has no bare `in` operator, which
+// would turn a hoisted `for (var a = b in c;;)` into a for-in
+static int may_contain_in(const NodeArray *arr, uint32_t idx, int depth) {
+    if (!NODE_VALID(idx)) return 0;
+    const Node *n = &arr->nodes[idx];
+    if (IS_LEAF(n->kind)) return 0;
+    if (depth == 0) return 1;
+    switch (n->kind) {
+    case NODE_BINARY:
+    case NODE_ASSIGN:
+        if (n->kind == NODE_BINARY && n->op == NODE_KW_IN) return 1;
+        return may_contain_in(arr, n->data[0], depth - 1) ||
+               may_contain_in(arr, n->data[1], depth - 1);
+    case NODE_UNARY:
+        return may_contain_in(arr, n->data[0], depth - 1);
+    case NODE_TERNARY: {
+        const Node *e = &arr->nodes[n->data[1]];
+        return may_contain_in(arr, n->data[0], depth - 1) ||
+               may_contain_in(arr, e->data[0], depth - 1) ||
+               may_contain_in(arr, e->data[1], depth - 1);
+    }
+    default:
+        return 1;
+    }
+}
+
+static int decl_hoistable(const NodeArray *arr, const Node *decl) {
+    for (uint32_t i = 0; i < decl->data[1]; i++) {
+        const Node *d = &arr->nodes[decl->data[0] + i];
+        // Patterns can hide `in` inside defaults
+        if (!IS_LEAF(arr->nodes[d->data[0]].kind)) return 0;
+        if (may_contain_in(arr, d->data[1], IN_MAX_DEPTH)) return 0;
+    }
+    return 1;
+}
+
+// Move a var declaration into the init of the for statement at idx
+static int hoist_into_for(NodeArray *arr, const Node *decl, uint32_t idx) {
+    if (arr->nodes[idx].kind != NODE_FOR || !decl_hoistable(arr, decl)) return 0;
+
+    uint32_t init = arr->nodes[idx].data[0];
+    if (!NODE_VALID(init)) {
+        uint32_t d = node_push(arr, NODE_VAR_DECL, decl->flags, decl->op,
+                               decl->start, decl->data[0], decl->data[1]);
+        arr->nodes[idx].data[0] = d;
+        return 1;
+    }
+
+    Node *in = &arr->nodes[init];
+    if (in->kind != NODE_VAR_DECL || DECL_KIND(in)) return 0;
+    // Hoisted declarators run before the loop's own
+    uint32_t first = node_list_append(arr, decl->data[0], decl->data[1],
+                                      in->data[0], in->data[1]);
+    in->data[0] = first;
+    in->data[1] += decl->data[1];
+    in->start = decl->start;
+    return 1;
+}
+
+// Rewrite one statement list in place, compacting it towards its head
+static uint32_t merge_list(NodeArray *arr, uint32_t owner) {
+    Node *p = &arr->nodes[owner];
+    uint32_t first = p->data[0], end = first + p->data[1];
+    uint32_t w = first, r = first;
+
+    while (r < end) {
+        const Node *s = &arr->nodes[r];
+        if (s->kind != NODE_VAR_DECL) {
+            arr->nodes[w++] = arr->nodes[r++];
+            continue;
+        }
+
+        uint32_t e = r + 1;
+        while (e < end && arr->nodes[e].kind == NODE_VAR_DECL &&
+               DECL_KIND(&arr->nodes[e]) == DECL_KIND(s))
+            e++;
+
+        // Slot r may be overwritten by compaction, so build in a copy
+        Node decl = *s;
+        for (uint32_t k = r + 1; k < e; k++) {
+            const Node *d = &arr->nodes[k];
+            decl.data[0] = node_list_append(arr, decl.data[0], decl.data[1],
+                                            d->data[0], d->data[1]);
+            decl.data[1] += d->data[1];
+        }
+        r = e;
+
+        if (r < end && !DECL_KIND(&decl) && hoist_into_for(arr, &decl, r)) {
+            arr->nodes[w++] = arr->nodes[r++];
+            continue;
+        }
+        arr->nodes[w++] = decl;
+    }
+
+    p->data[1] = w - first;
+    return end - w;
+}
+
+uint32_t vars_merge(NodeArray *arr) {
+    if (!NODE_VALID(arr->root)) return 0;
+
+    // Dead originals of copied blocks share their list run with the live copy
+    uint8_t *live = calloc(arr->count, 1);
+    if (!live) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+    node_mark_live(arr, live);
+
+    // Runs relinked by this pass land past end and hold no statement lists
+    uint32_t end = arr->count, removed = 0;
+    for (uint32_t i = 1; i < end; i++) {
+        if (!live[i]) continue;
+        NodeKind k = arr->nodes[i].kind;
+        if (k == NODE_BLOCK || k == NODE_PROGRAM)
+            removed += merge_list(arr, i);
+    }
+
+    free(live);
+    return removed;
+}
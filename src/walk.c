@@ -0,0 +1,101 @@
+#include "jsopt/walk.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t idx;
+    uint32_t next;  // child position to enter next
+    uint32_t count; // children (list length, or the arity)
+    uint32_t list;  // first list element, 0 for slot children
+} Frame;
+
+typedef struct {
+    Frame   *frames;
+    uint32_t sp;
+    uint32_t cap;
+    Frame    inline_frames[WALK_INLINE_DEPTH];
+} Stack;
+
+// Spill to the heap, doubling; depth is bounded by the compound count
+static void stack_grow(Stack *s) {
+    uint32_t cap = s->cap * 2;
+    Frame *frames = s->frames == s->inline_frames ? malloc(cap * sizeof(Frame))
+                                                  : realloc(s->frames, cap * sizeof(Frame));
+    if (!frames) {
+        fprintf(stderr, "jsopt: out of memory\n");
+        abort();
+    }
+    if (s->frames == s->inline_frames) memcpy(frames, s->inline_frames, sizeof(s->inline_frames));
+    s->frames = frames;
+    s->cap = cap;
+}
+
+#define STOP_IF(call) do { if ((call) == WALK_STOP) { stopped = 1; goto done; } } while (0)
+
+int walk(NodeArray *arr, uint32_t root, WalkFn pre, WalkFn post, void *ctx) {
+    if (!NODE_VALID(root)) return 0;
+
+    Stack s;
+    s.frames = s.inline_frames;
+    s.sp = 0;
+    s.cap = WALK_INLINE_DEPTH;
+    // The innermost open frame lives in top, out of memory, so the step to
+    // the next child carries no store-to-load dependency; frames[] holds
+    // its ancestors. top.idx == 0 means no frame is open.
+    Frame top = { 0, 0, 0, 0 };
+    uint32_t idx = root;
+    int stopped = 0;
+
+    for (;;) {
+        // Enter idx: nodes with children open a frame, others finish here
+        WalkAction act = pre ? pre(arr, idx, top.idx, ctx) : WALK_CONTINUE;
+        if (act == WALK_STOP) {
+            stopped = 1;
+            break;
+        }
+        const Node *n = &arr->nodes[idx];
+        const NodeLayout *l = &node_layout[n->kind];
+        uint8_t arity = l->arity;
+        if (act == WALK_CONTINUE && arity) {
+            // Children past data[0] sit in the extension run; start its
+            // load now, the first child's subtree hides the latency
+            if (l->ext) __builtin_prefetch(&arr->nodes[n->data[1]]);
+            if (top.idx) {
+                if (s.sp == s.cap) stack_grow(&s);
+                s.frames[s.sp++] = top;
+            }
+            int list = arity == NODE_ARITY_LIST;
+            top = (Frame){ idx, 0, list ? n->data[1] : arity, list ? n->data[0] : 0 };
+        } else if (post) {
+            STOP_IF(post(arr, idx, top.idx, ctx));
+        }
+
+        // Next child of the innermost open frame; finished frames are left
+        // on the way up
+        for (;;) {
+            if (!top.idx) goto done;
+            if (top.next < top.count) {
+                uint32_t i = top.next++;
+                // Slot kinds with more than two children are exactly the
+                // ones with an extension run (node_layout guarantees it)
+                const Node *p = &arr->nodes[top.idx];
+                if (top.list)
+                    idx = top.list + i;
+                else if (top.count <= 2 || i == 0)
+                    idx = p->data[i];
+                else
+                    idx = arr->nodes[p->data[1] + ((i - 1) >> 1)].data[(i - 1) & 1];
+                if (NODE_VALID(idx)) break;
+                continue;
+            }
+            uint32_t done_idx = top.idx;
+            top = s.sp ? s.frames[--s.sp] : (Frame){ 0, 0, 0, 0 };
+            if (post) STOP_IF(post(arr, done_idx, top.idx, ctx));
+        }
+    }
+
+done:
+    if (s.frames != s.inline_frames) free(s.frames);
+    return stopped;
+}
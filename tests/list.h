@@ -0,0 +1,13 @@
+#pragma once
+
+#include "jsopt/node.h"
+
+// Parser make_list: contiguous copies of the elements, parent in last slot
+static inline uint32_t make_list(NodeArray *arr, NodeKind kind, uint8_t flags, uint16_t op,
+                                 const uint32_t *elems, uint32_t n) {
+    uint32_t first = node_reserve(arr, n + 1);
+    for (uint32_t i = 0; i < n; i++)
+        arr->nodes[first + i] = arr->nodes[elems[i]];
+    arr->nodes[first + n] = (Node){ kind, flags, op, 0, { first, n } };
+    return first + n;
+}
@@ -0,0 +1,162 @@
+#include "jsopt/arena.h"
+#include "jsopt/pool.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+static int all_zero(const void *p, size_t n) {
+    const uint8_t *b = p;
+    for (size_t i = 0; i < n; i++)
+        if (b[i]) return 0;
+    return 1;
+}
+
+static void test_alloc(void) {
+    Arena a;
+    ASSERT(arena_init(&a) == 0, "init");
+    char *x = arena_alloc(&a, 3), *y = arena_alloc(&a, 40);
+    uint32_t *z = ARENA_NEW(&a, uint32_t, 1000);
+    ASSERT((uintptr_t)x % ARENA_ALIGN == 0 && (uintptr_t)y % ARENA_ALIGN == 0 &&
+           (uintptr_t)z % ARENA_ALIGN == 0, "aligned");
+    ASSERT(y >= x + 3 && (char *)z >= y + 40, "allocations do not overlap");
+    ASSERT(all_zero(x, 3) && all_zero(y, 40) && all_zero(z, 4000), "zeroed");
+    ASSERT(arena_alloc(&a, 0) != NULL, "empty allocation");
+    arena_free(&a);
+    ASSERT(a.base == NULL, "freed");
+}
+
+// Scratch data past a mark goes away and its memory comes back zeroed
+static void test_rewind(void) {
+    Arena a;
+    ASSERT(arena_init(&a) == 0, "init");
+    uint32_t *keep = ARENA_NEW(&a, uint32_t, 4);
+    keep[0] = 7;
+    size_t mark = arena_mark(&a);
+    uint32_t *scratch = ARENA_NEW(&a, uint32_t, 256);
+    memset(scratch, 0xAB, 256 * sizeof(uint32_t));
+    size_t inner = arena_mark(&a);
+    ARENA_NEW(&a, uint8_t, 100)[99] = 1;
+    arena_rewind(&a, inner);
+    ASSERT(arena_mark(&a) == inner, "nested rewind");
+    arena_rewind(&a, mark);
+    ASSERT(arena_mark(&a) == mark && keep[0] == 7, "rewind keeps earlier data");
+    uint32_t *again = ARENA_NEW(&a, uint32_t, 256);
+    ASSERT(again == scratch, "memory reused");
+    ASSERT(all_zero(again, 256 * sizeof(uint32_t)), "reused memory zeroed");
+    arena_free(&a);
+}
+
+// Worklists grow in place while they are the last allocation
+static void test_grow(void) {
+    Arena a;
+    ASSERT(arena_init(&a) == 0, "init");
+    uint32_t cap = 4, *list = ARENA_NEW(&a, uint32_t, cap), *first = list;
+    int in_place = 1, kept = 1;
+    for (uint32_t i = 0; i < 10000; i++) {
+        if (i == cap) {
+            list = arena_grow(&a, list, cap * sizeof(uint32_t), 2 * cap * sizeof(uint32_t));
+            in_place &= list == first;
+            kept &= all_zero(list + cap, cap * sizeof(uint32_t));
+            cap *= 2;
+        }
+        list[i] = i;
+    }
+    ASSERT(in_place, "grew in place");
+    ASSERT(kept && list[9999] == 9999 && list[5000] == 5000, "grown list intact");
+
+    uint8_t *other = arena_alloc(&a, 1);
+    list = arena_grow(&a, list, cap * sizeof(uint32_t), 2 * cap * sizeof(uint32_t));
+    ASSERT(list != first && (uint8_t *)list > other, "moved past a later allocation");
+    ASSERT(list[0] == 0 && list[9999] == 9999 && all_zero(list + cap, cap * sizeof(uint32_t)),
+           "moved list intact");
+
+    size_t before = arena_mark(&a);
+    list = arena_grow(&a, list, 2 * cap * sizeof(uint32_t), 8);
+    ASSERT(arena_mark(&a) < before && list[1] == 1, "shrinks in place");
+    uint32_t *next = ARENA_NEW(&a, uint32_t, 16);
+    ASSERT(all_zero(next, 16 * sizeof(uint32_t)), "shrunk bytes zeroed");
+    ASSERT(arena_grow(&a, NULL, 0, 8) != NULL, "grow from nothing");
+    arena_free(&a);
+}
+
+// After reset the arena starts over, zeroed, past the resident part too
+static void test_reset(void) {
+    Arena a;
+    ASSERT(arena_init(&a) == 0, "init");
+    size_t big = 3 * ARENA_RESET_KEEP;
+    uint8_t *p = arena_alloc(&a, big);
+    memset(p, 0xFF, big);
+    arena_reset(&a);
+    ASSERT(arena_mark(&a) == 0, "empty");
+    uint8_t *q = arena_alloc(&a, big);
+    ASSERT(q == p && all_zero(q, big), "same memory, zeroed");
+    arena_reset(&a);
+    arena_reset(&a);
+    ASSERT(all_zero(arena_alloc(&a, 64), 64), "reset twice");
+    arena_free(&a);
+}
+
+// Workers each own an arena, reused and emptied per job as batch mode does
+#define WORKERS 8
+#define JOBS    64
+
+typedef struct {
+    Arena    arenas[WORKERS];
+    uint64_t sums[JOBS];
+} Batch;
+
+static int batch_job(void *ctx, uint32_t worker, uint32_t job) {
+    Batch *b = ctx;
+    Arena *a = &b->arenas[worker];
+    int ok = arena_mark(a) == 0;
+    uint32_t n = 1000 + job * 100, cap = 16, *stack = ARENA_NEW(a, uint32_t, cap);
+    for (uint32_t i = 0; i < n; i++) {
+        if (i == cap) {
+            stack = arena_grow(a, stack, cap * sizeof(uint32_t), 2 * cap * sizeof(uint32_t));
+            cap *= 2;
+        }
+        ok &= stack[i] == 0;
+        stack[i] = i;
+    }
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < n; i++) sum += stack[i];
+    b->sums[job] = sum;
+    arena_reset(a);
+    return ok ? 0 : 1;
+}
+
+static void test_workers(void) {
+    static Batch b;
+    int ok = 1;
+    for (int i = 0; i < WORKERS; i++) ok &= arena_init(&b.arenas[i]) == 0;
+    ASSERT(ok, "init");
+    ASSERT(pool_run(WORKERS, JOBS, batch_job, &b) == 0, "every job saw a fresh arena");
+    for (uint32_t j = 0; j < JOBS; j++) {
+        uint64_t n = 1000 + j * 100;
+        ok &= b.sums[j] == n * (n - 1) / 2;
+    }
+    ASSERT(ok, "per-worker data intact");
+    for (int i = 0; i < WORKERS; i++) arena_free(&b.arenas[i]);
+}
+
+int main(void) {
+    test_alloc();
+    test_rewind();
+    test_grow();
+    test_reset();
+    test_workers();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+#include "jsopt/astfile.h"
+#include "jsopt/hash.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+static const char SRC[] = "a + b;";
+
+// tokens a + b ; then BINARY, EXPR_STMT, PROGRAM
+static void build(NodeArray *arr) {
+    node_array_init(arr, 0);
+    uint32_t a = node_push_token(arr, NODE_IDENT, 0, 1, 1);
+    node_push_token(arr, NODE_PLUS, 2, 1, 1);
+    uint32_t b = node_push_token(arr, NODE_IDENT, 4, 1, 1);
+    node_push_token(arr, NODE_SEMI, 5, 1, 1);
+    arr->token_end = arr->count;
+    uint32_t bin = node_push(arr, NODE_BINARY, 0, NODE_PLUS, 0, a, b);
+    uint32_t first = node_reserve(arr, 1);
+    *NODE(arr, first) = (Node){ NODE_EXPR_STMT, 0, 0, 0, { bin, 0 } };
+    arr->root = node_push(arr, NODE_PROGRAM, 0, 0, 0, first, 1);
+}
+
+static int same_array(const NodeArray *x, const NodeArray *y) {
+    return x->count == y->count && x->token_end == y->token_end &&
+           x->root == y->root &&
+           memcmp(x->nodes, y->nodes, (size_t)x->count * sizeof(Node)) == 0;
+}
+
+static void tmp_path(char *path) {
+    strcpy(path, "/tmp/jsopt_test_ast_XXXXXX");
+    close(mkstemp(path));
+}
+
+// save, map back, identical nodes and metadata
+static void test_roundtrip(void) {
+    NodeArray arr;
+    build(&arr);
+    char path[64];
+    tmp_path(path);
+
+    ASSERT(astfile_save(&arr, SRC, 6, path) == 0, "save returns 0");
+    AstFile f;
+    ASSERT(astfile_open(&f, path, 0) == 0, "open returns 0");
+    ASSERT(same_array(&f.arr, &arr), "nodes and header fields match");
+    ASSERT(f.arr.capacity == f.arr.count, "view is not growable");
+    ASSERT(f.src_len == 6 && f.src_hash == hash64(SRC, 6, 0), "source identity");
+    ASSERT(NODE_KIND(&f.arr, f.arr.root) == NODE_PROGRAM, "root kind");
+    ASSERT(((uintptr_t)f.arr.nodes % 16) == 0, "nodes aligned");
+
+    NodeArray thawed;
+    ASSERT(astfile_thaw(&f, &thawed) == 0, "thaw returns 0");
+    ASSERT(same_array(&thawed, &arr), "thawed copy matches");
+    ASSERT(node_push(&thawed, NODE_EMPTY, 0, 0, 0, 0, 0) == arr.count, "thawed copy grows");
+    node_array_free(&thawed);
+
+    astfile_close(&f);
+    ASSERT(f.map == NULL && f.arr.nodes == NULL, "close clears struct");
+    node_array_free(&arr);
+    unlink(path);
+}
+
+// pipes take the streamed path
+static void test_pipe(void) {
+    NodeArray arr;
+    build(&arr);
+    int fds[2];
+    ASSERT(pipe(fds) == 0, "pipe");
+    ASSERT(astfile_write_fd(&arr, SRC, 6, fds[1]) == 0, "write to pipe");
+    close(fds[1]);
+
+    AstFile f;
+    ASSERT(astfile_open_fd(&f, fds[0], 0) == 0, "open from pipe");
+    ASSERT(same_array(&f.arr, &arr), "piped nodes match");
+    astfile_close(&f);
+    close(fds[0]);
+    node_array_free(&arr);
+}
+
+// flipped payload byte fails the checksum unless trusted, and so does a
+// re-signed payload with a bad child index; bad headers and truncation
+// always fail
+static void test_reject(void) {
+    NodeArray arr;
+    build(&arr);
+    char path[64];
+    tmp_path(path);
+    astfile_save(&arr, SRC, 6, path);
+
+    AstFile f;
+    int fd = open(path, O_RDWR);
+    off_t at = (off_t)sizeof(AstHeader) + 2 * (off_t)sizeof(Node) + 4;
+    ASSERT(pwrite(fd, "\x7f", 1, at) == 1, "corrupt payload");
+    errno = 0;
+    ASSERT(astfile_open(&f, path, 0) == -1 && errno == EINVAL, "checksum mismatch rejected");
+    ASSERT(astfile_open(&f, path, ASTFILE_TRUST) == 0, "trusted load skips checksum");
+    astfile_close(&f);
+
+    uint32_t bad = NODE_KIND_VERSION + 1;
+    ASSERT(pwrite(fd, &bad, 4, offsetof(AstHeader, kind_version)) == 4, "bump kind version");
+    ASSERT(astfile_open(&f, path, ASTFILE_TRUST) == -1, "kind version mismatch rejected");
+    close(fd);
+
+    // Well signed but malformed: BINARY's left child out of range
+    arr.nodes[5].data[0] = 99;
+    astfile_save(&arr, SRC, 6, path);
+    errno = 0;
+    ASSERT(astfile_open(&f, path, 0) == -1 && errno == EINVAL, "invalid tree rejected");
+    arr.nodes[5].data[0] = 1;
+
+    astfile_save(&arr, SRC, 6, path);
+    ASSERT(truncate(path, (off_t)sizeof(AstHeader) + 16) == 0, "truncate");
+    ASSERT(astfile_open(&f, path, ASTFILE_TRUST) == -1, "truncated file rejected");
+    ASSERT(f.map == NULL, "nothing mapped on failure");
+
+    node_array_free(&arr);
+    unlink(path);
+}
+
+int main(void) {
+    test_roundtrip();
+    test_pipe();
+    test_reject();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
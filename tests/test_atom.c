@@ -0,0 +1,126 @@
+#include "jsopt/atom.h"
+#include "jsopt/pool.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+static uint32_t intern(AtomTable *t, const char *s) {
+    return atom_intern(t, s, (uint32_t)strlen(s));
+}
+
+static int name_is(const AtomTable *t, uint32_t atom, const char *s) {
+    uint32_t len;
+    const char *name = atom_name(t, atom, &len);
+    return len == strlen(s) && !memcmp(name, s, len) && name[len] == '\0';
+}
+
+static void test_intern(void) {
+    AtomTable t;
+    ASSERT(atom_table_init(&t, 1000) == 0, "init");
+    ASSERT(atom_find(&t, "a", 1) == ATOM_NULL, "empty table finds nothing");
+    ASSERT(atom_count(&t) == 0 && atom_limit(&t) == 1, "empty counts");
+
+    uint32_t a = intern(&t, "a"), b = intern(&t, "b"), ab = intern(&t, "ab");
+    ASSERT(a != ATOM_NULL && b != ATOM_NULL && ab != ATOM_NULL, "atoms are nonzero");
+    ASSERT(a != b && a != ab && b != ab, "distinct names, distinct atoms");
+    ASSERT(intern(&t, "a") == a && intern(&t, "ab") == ab, "interning again dedupes");
+    ASSERT(atom_find(&t, "b", 1) == b, "find after intern");
+    ASSERT(atom_find(&t, "abc", 3) == ATOM_NULL, "find misses unknown names");
+    ASSERT(atom_find(&t, "ab", 1) == a, "length, not NUL, ends the name");
+    ASSERT(name_is(&t, a, "a") && name_is(&t, ab, "ab"), "names round-trip");
+
+    uint32_t empty = atom_intern(&t, "", 0);
+    ASSERT(empty != ATOM_NULL && name_is(&t, empty, ""), "empty name is an atom");
+    ASSERT(atom_count(&t) == 4, "four names");
+    ASSERT(a < atom_limit(&t) && b < atom_limit(&t) && ab < atom_limit(&t) &&
+           empty < atom_limit(&t), "atoms below the limit");
+    atom_table_free(&t);
+}
+
+// Fill to capacity: every name keeps its atom and its text
+static void test_many(void) {
+    enum { N = 20000 };
+    AtomTable t;
+    ASSERT(atom_table_init(&t, N) == 0, "init");
+    static uint32_t atoms[N];
+    char name[16];
+    int ok = 1;
+    for (uint32_t i = 0; i < N; i++) {
+        int len = snprintf(name, sizeof(name), "v%u", i);
+        atoms[i] = atom_intern(&t, name, (uint32_t)len);
+    }
+    uint8_t *seen = calloc(atom_limit(&t), 1);
+    for (uint32_t i = 0; i < N; i++) {
+        int len = snprintf(name, sizeof(name), "v%u", i);
+        ok &= atom_find(&t, name, (uint32_t)len) == atoms[i];
+        ok &= name_is(&t, atoms[i], name);
+        ok &= atoms[i] < atom_limit(&t) && !seen[atoms[i]]++;
+    }
+    ASSERT(ok, "every name finds its own atom");
+    ASSERT(atom_count(&t) == N, "count matches");
+    free(seen);
+    atom_table_free(&t);
+}
+
+// Workers intern overlapping name sets at once, as lexer workers do
+#define SHARED_JOBS  16
+#define SHARED_NAMES 4000
+
+typedef struct {
+    AtomTable *t;
+    uint32_t   atoms[SHARED_JOBS][SHARED_NAMES];
+} Shared;
+
+static int intern_job(void *ctx, uint32_t worker, uint32_t job) {
+    (void)worker;
+    Shared *s = ctx;
+    char name[16];
+    // Each job walks the same names from a different start
+    for (uint32_t k = 0; k < SHARED_NAMES; k++) {
+        uint32_t i = (k + job * 997) % SHARED_NAMES;
+        int len = snprintf(name, sizeof(name), "n%u", i);
+        s->atoms[job][i] = atom_intern(s->t, name, (uint32_t)len);
+    }
+    return 0;
+}
+
+static void test_concurrent(void) {
+    AtomTable t;
+    ASSERT(atom_table_init(&t, SHARED_NAMES) == 0, "init");
+    static Shared s;
+    s.t = &t;
+    ASSERT(pool_run(8, SHARED_JOBS, intern_job, &s) == 0, "jobs run");
+
+    int same = 1, named = 1;
+    char name[16];
+    for (uint32_t i = 0; i < SHARED_NAMES; i++) {
+        for (uint32_t j = 1; j < SHARED_JOBS; j++) same &= s.atoms[j][i] == s.atoms[0][i];
+        snprintf(name, sizeof(name), "n%u", i);
+        named &= name_is(&t, s.atoms[0][i], name);
+    }
+    ASSERT(same, "every worker got the same atom for a name");
+    ASSERT(named, "atoms name what was interned");
+    ASSERT(atom_count(&t) == SHARED_NAMES, "each name interned once");
+    atom_table_free(&t);
+}
+
+int main(void) {
+    test_intern();
+    test_many();
+    test_concurrent();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
@@ -0,0 +1,232 @@
+#include "jsopt/bundle.h"
+#include "list.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+#define MAX_MODULES 4
+
+static AtomTable atoms;
+static NodeArray mods[MAX_MODULES], out;
+static BundleModule in[MAX_MODULES];
+static BundleError err;
+
+static uint32_t atom(const char *name) {
+    return atom_intern(&atoms, name, (uint32_t)strlen(name));
+}
+
+// Identifier lexed with the shared table; start is its position in a
+// notional source
+static uint32_t ident(NodeArray *arr, const char *name, uint32_t start) {
+    uint32_t i = node_push_token(arr, NODE_IDENT, start, (uint32_t)strlen(name), 1);
+    arr->nodes[i].data[1] = atom(name);
+    return i;
+}
+
+static uint32_t decl(NodeArray *arr, uint8_t flags, const char *name) {
+    uint32_t d = node_push(arr, NODE_DECLARATOR, 0, 0, 0, ident(arr, name, 0), 0);
+    return make_list(arr, NODE_VAR_DECL, flags, 0, &d, 1);
+}
+
+static uint32_t use(NodeArray *arr, const char *name, uint32_t start) {
+    return node_push(arr, NODE_EXPR_STMT, 0, 0, start, ident(arr, name, start), 0);
+}
+
+// import { imported as local } from module
+static uint32_t import(NodeArray *arr, uint16_t module, const char *imported, const char *local) {
+    uint32_t spec = node_push(arr, NODE_IMPORT_SPEC, 0, 0, 0, ident(arr, imported, 0),
+                              ident(arr, local, 0));
+    return make_list(arr, NODE_IMPORT, 0, module, &spec, 1);
+}
+
+static uint32_t export(NodeArray *arr, uint32_t decl) {
+    return node_push(arr, NODE_EXPORT, 0, 0, 0, decl, 0);
+}
+
+static void program(uint32_t m, const uint32_t *stmts, uint32_t n, uint32_t len) {
+    mods[m].root = make_list(&mods[m], NODE_PROGRAM, 0, 0, stmts, n);
+    in[m] = (BundleModule){ &mods[m], len };
+}
+
+static void reset(uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) node_array_reset(&mods[i]);
+    node_array_reset(&out);
+}
+
+static int run(uint32_t count) {
+    memset(&err, 0, sizeof(err));
+    return bundle_concat(&out, in, count, &atoms, &err);
+}
+
+static uint32_t stmt(uint32_t i) {
+    return out.nodes[out.root].data[0] + i;
+}
+
+// Atom of statement i's identifier: the expression, or the first binding
+static uint32_t stmt_atom(uint32_t i) {
+    const Node *s = &out.nodes[stmt(i)];
+    if (s->kind == NODE_VAR_DECL) s = &out.nodes[s->data[0]];
+    return out.nodes[s->data[0]].data[1];
+}
+
+static int valid(void) {
+    NodeError verr;
+    return node_array_validate(&out, &verr) == 0;
+}
+
+// 0: export var a;  1: import { a as b } from 0; var a; b; a;
+static void test_rename(void) {
+    reset(2);
+    uint32_t s0[1] = { export(&mods[0], decl(&mods[0], 0, "a")) };
+    program(0, s0, 1, 100);
+    uint32_t s1[4] = { import(&mods[1], 0, "a", "b"), decl(&mods[1], 0, "a"),
+                       use(&mods[1], "b", 10), use(&mods[1], "a", 20) };
+    program(1, s1, 4, 50);
+
+    ASSERT(run(2) == 1, "one binding renamed");
+    ASSERT(valid(), "output validates");
+    ASSERT(out.nodes[out.root].kind == NODE_PROGRAM && out.nodes[out.root].data[1] == 4,
+           "one flat program without the import");
+    ASSERT(out.nodes[stmt(0)].kind == NODE_VAR_DECL && stmt_atom(0) == atom("a"),
+           "export unwrapped, first declaration keeps its name");
+    uint32_t renamed = stmt_atom(1), len;
+    const char *name = atom_name(&atoms, renamed, &len);
+    ASSERT(renamed != atom("a") && len > 2 && !memcmp(name, "a$", 2), "conflict renamed a$N");
+    ASSERT(stmt_atom(2) == atom("a"), "import rewritten to the exporting binding");
+    ASSERT(stmt_atom(3) == renamed, "reference follows its renamed binding");
+
+    const Node *b = &out.nodes[out.nodes[stmt(2)].data[0]];
+    ASSERT(b->start == 110, "token offsets rebased past earlier sources");
+}
+
+// Modules run after their imports; cycles run in discovery order
+static void test_order(void) {
+    reset(3);
+    uint32_t s0[2] = { import(&mods[0], 2, "c", "c"), use(&mods[0], "c", 0) };
+    program(0, s0, 2, 10);
+    uint32_t s1[1] = { use(&mods[1], "x", 0) };
+    program(1, s1, 1, 10);
+    uint32_t s2[2] = { import(&mods[2], 0, "z", "z"), export(&mods[2], decl(&mods[2], 0, "c")) };
+    program(2, s2, 2, 10);
+    // 2 imports z, which 0 does not export
+    ASSERT(run(3) < 0 && err.module == 2 && !strcmp(err.msg, "imported name is not exported"),
+           "unexported import rejected");
+
+    reset(3);
+    uint32_t u0[2] = { import(&mods[0], 2, "c", "c"), use(&mods[0], "c", 0) };
+    program(0, u0, 2, 10);
+    uint32_t u1[1] = { use(&mods[1], "x", 0) };
+    program(1, u1, 1, 10);
+    uint32_t u2[1] = { export(&mods[2], decl(&mods[2], 0, "c")) };
+    program(2, u2, 1, 10);
+    ASSERT(run(3) == 0 && valid(), "bundles");
+    ASSERT(out.nodes[stmt(0)].kind == NODE_VAR_DECL && stmt_atom(1) == atom("c") &&
+           stmt_atom(2) == atom("x"), "dependency first, then input order");
+}
+
+// Globals read anywhere and block-scoped names are never taken over
+static void test_capture(void) {
+    reset(2);
+    uint32_t inner[2] = { decl(&mods[0], NODE_FLAG_LET, "x"), use(&mods[0], "x", 0) };
+    uint32_t block = make_list(&mods[0], NODE_BLOCK, 0, 0, inner, 2);
+    uint32_t s0[3] = { decl(&mods[0], 0, "x"), block, use(&mods[0], "x", 0) };
+    program(0, s0, 3, 10);
+    uint32_t s1[2] = { decl(&mods[1], NODE_FLAG_CONST, "console"), use(&mods[1], "x", 0) };
+    program(1, s1, 2, 10);
+
+    ASSERT(run(2) == 1, "x renamed for the block's let");
+    ASSERT(valid(), "output validates");
+    uint32_t x = stmt_atom(0);
+    ASSERT(x != atom("x") && stmt_atom(2) == x, "top-level x and its reference renamed");
+    const Node *b = &out.nodes[stmt(1)];
+    const Node *let = &out.nodes[b->data[0]];
+    ASSERT(out.nodes[out.nodes[let->data[0]].data[0]].data[1] == atom("x") &&
+           out.nodes[out.nodes[b->data[0] + 1].data[0]].data[1] == atom("x"),
+           "block-scoped x untouched");
+    ASSERT(stmt_atom(3) == atom("console"), "uncontested const keeps its name");
+    ASSERT(stmt_atom(4) == atom("x"), "global read stays global");
+
+    // The global read claims the name from the declaration
+    reset(2);
+    uint32_t t0[1] = { decl(&mods[0], 0, "console") };
+    program(0, t0, 1, 10);
+    uint32_t t1[1] = { use(&mods[1], "console", 0) };
+    program(1, t1, 1, 10);
+    ASSERT(run(2) == 1 && stmt_atom(0) != atom("console") && stmt_atom(1) == atom("console"),
+           "declaration renamed away from a global");
+}
+
+static void test_errors(void) {
+    reset(1);
+    uint32_t s[1] = { import(&mods[0], 3, "a", "a") };
+    program(0, s, 1, 10);
+    ASSERT(run(1) < 0 && !strcmp(err.msg, "import from a module outside the bundle"),
+           "unknown module");
+
+    reset(1);
+    uint32_t call = node_push(&mods[0], NODE_CALL, 0, 0, 7, 0, 0);
+    uint32_t e = node_push(&mods[0], NODE_EXPR_STMT, 0, 0, 7, call, 0);
+    program(0, &e, 1, 10);
+    ASSERT(run(1) < 0 && err.pos == 7 && !strcmp(err.msg, "unsupported node in module code"),
+           "opaque compounds rejected");
+
+    reset(1);
+    uint32_t id = node_push_token(&mods[0], NODE_IDENT, 3, 1, 1);
+    e = node_push(&mods[0], NODE_EXPR_STMT, 0, 0, 3, id, 0);
+    program(0, &e, 1, 10);
+    ASSERT(run(1) < 0 && err.pos == 3, "identifier without an atom");
+
+    reset(1);
+    uint32_t late = node_push(&mods[0], NODE_EXPR_STMT, 0, 0, 5, 0, 0);
+    uint32_t a = ident(&mods[0], "a", 5);
+    mods[0].nodes[late].data[0] = a;
+    program(0, &late, 1, 10);
+    ASSERT(run(1) < 0 && !strcmp(err.msg, "module not in parser order"), "child after parent");
+
+    reset(1);
+    mods[0].root = node_push(&mods[0], NODE_BLOCK, 0, 0, 0, 0, 0);
+    in[0] = (BundleModule){ &mods[0], 0 };
+    ASSERT(run(1) < 0 && !strcmp(err.msg, "module root is not a program"), "root kind");
+
+    // Room for the copied module but not the merged statement list: an
+    // error, not an abort in node_reserve
+    reset(1);
+    uint32_t s2[2] = { decl(&mods[0], 0, "x"), use(&mods[0], "x", 0) };
+    program(0, s2, 2, 10);
+    uint32_t cap = out.capacity, need = mods[0].count - 1 + 2 + 1;
+    out.capacity = out.count + need - 1;
+    ASSERT(run(1) < 0 && !strcmp(err.msg, "bundle exceeds the node limit"), "node limit");
+    node_array_reset(&out);
+    out.capacity = out.count + need;
+    ASSERT(run(1) == 0, "exactly at the node limit");
+    out.capacity = cap;
+}
+
+int main(void) {
+    atom_table_init(&atoms, 1000);
+    node_array_init(&out, 0);
+    for (int i = 0; i < MAX_MODULES; i++) node_array_init(&mods[i], 0);
+
+    test_rename();
+    test_order();
+    test_capture();
+    test_errors();
+
+    for (int i = 0; i < MAX_MODULES; i++) node_array_free(&mods[i]);
+    node_array_free(&out);
+    atom_table_free(&atoms);
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+#include "jsopt/cache.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+static void rm_tree(const char *path) {
+    DIR *d = opendir(path);
+    if (!d) {
+        unlink(path);
+        return;
+    }
+    struct dirent *e;
+    while ((e = readdir(d))) {
+        if (!strcmp(e->d_name, ".") || !strcmp(e->d_name, "..")) continue;
+        char sub[4096];
+        snprintf(sub, sizeof(sub), "%s/%s", path, e->d_name);
+        rm_tree(sub);
+    }
+    closedir(d);
+    rmdir(path);
+}
+
+static void open_tmp(Cache *c, char *dir, uint64_t max_bytes) {
+    strcpy(dir, "/tmp/jsopt_test_cache_XXXXXX");
+    if (!mkdtemp(dir)) fprintf(stderr, "mkdtemp failed\n");
+    cache_open(c, dir, max_bytes);
+}
+
+static void entry_file(const Cache *c, uint64_t key, char *buf, size_t n) {
+    snprintf(buf, n, "%s/%02x/%014llx", c->dir, (unsigned)(key >> 56),
+             (unsigned long long)(key & 0x00FFFFFFFFFFFFFFULL));
+}
+
+// miss, store, then hit with identical bytes
+static void test_roundtrip(void) {
+    char dir[64];
+    Cache c;
+    open_tmp(&c, dir, 0);
+
+    const char *src = "var a = 1 ;";
+    uint64_t key = cache_key(src, 11, 0);
+    CacheEntry e;
+    ASSERT(cache_get(&c, key, src, 11, &e) == -1, "empty cache misses");
+    ASSERT(cache_put(&c, key, src, 11, "var a=1", 7, "{}", 2) == 0, "put succeeds");
+    ASSERT(cache_get(&c, key, src, 11, &e) == 0, "hit after put");
+    ASSERT(e.code_len == 7 && memcmp(e.code, "var a=1", 7) == 0, "code matches");
+    ASSERT(e.map_len == 2 && memcmp(e.map, "{}", 2) == 0, "map matches");
+    cache_entry_release(&e);
+    ASSERT(e.base == NULL, "release clears entry");
+
+    ASSERT(c.hits == 1 && c.misses == 1 && c.stores == 1, "counters");
+
+    cache_close(&c);
+    rm_tree(dir);
+}
+
+// options and source both feed the key
+static void test_key(void) {
+    ASSERT(cache_key("a", 1, 0) != cache_key("a", 1, 1), "options change key");
+    ASSERT(cache_key("a", 1, 0) != cache_key("b", 1, 0), "source changes key");
+    ASSERT(cache_key("a", 1, 0) == cache_key("a", 1, 0), "key is stable");
+}
+
+// a stored length that disagrees with the source is a miss
+static void test_len_mismatch(void) {
+    char dir[64];
+    Cache c;
+    open_tmp(&c, dir, 0);
+
+    uint64_t key = cache_key("x", 1, 0);
+    cache_put(&c, key, "x", 1, "x", 1, NULL, 0);
+    CacheEntry e;
+    ASSERT(cache_get(&c, key, "x", 2, &e) == -1, "src_len mismatch misses");
+
+    cache_close(&c);
+    rm_tree(dir);
+}
+
+// sources differing only in swapped 64-byte stripes key apart, and a
+// source that lands on another's key (a forced collision) still misses
+static void test_collision(void) {
+    char dir[64], a[128], b[128];
+    Cache c;
+    open_tmp(&c, dir, 0);
+
+    memset(a, 'a', 64);
+    memset(a + 64, 'b', 64);
+    memcpy(b, a + 64, 64);
+    memcpy(b + 64, a, 64);
+    uint64_t key = cache_key(a, 128, 0);
+    ASSERT(key != cache_key(b, 128, 0), "swapped stripes key apart");
+
+    cache_put(&c, key, a, 128, "var a=1", 7, NULL, 0);
+    CacheEntry e;
+    ASSERT(cache_get(&c, key, b, 128, &e) == -1, "same key, other source misses");
+    ASSERT(cache_get(&c, key, a, 128, &e) == 0, "own source hits");
+    cache_entry_release(&e);
+
+    cache_close(&c);
+    rm_tree(dir);
+}
+
+// truncated and corrupt entries are misses, and a put replaces them
+static void test_corrupt(void) {
+    char dir[64], path[4096];
+    Cache c;
+    open_tmp(&c, dir, 0);
+
+    uint64_t key = cache_key("y", 1, 0);
+    cache_put(&c, key, "y", 1, "output", 6, NULL, 0);
+    entry_file(&c, key, path, sizeof(path));
+
+    CacheEntry e;
+    ASSERT(truncate(path, 34) == 0, "truncate");
+    ASSERT(cache_get(&c, key, "y", 1, &e) == -1, "truncated entry misses");
+
+    cache_put(&c, key, "y", 1, "output", 6, NULL, 0);
+    int fd = open(path, O_WRONLY);
+    ASSERT(write(fd, "XXXX", 4) == 4, "clobber magic");
+    close(fd);
+    ASSERT(cache_get(&c, key, "y", 1, &e) == -1, "bad magic misses");
+
+    ASSERT(cache_put(&c, key, "y", 1, "output", 6, NULL, 0) == 0, "put over corrupt");
+    ASSERT(cache_get(&c, key, "y", 1, &e) == 0, "hit after replace");
+    cache_entry_release(&e);
+
+    cache_close(&c);
+    rm_tree(dir);
+}
+
+// prune evicts the least recently used entries first
+static void test_prune(void) {
+    char dir[64], path[4096];
+    char body[1000];
+    memset(body, 'z', sizeof(body));
+    Cache c;
+    open_tmp(&c, dir, 2500); // room for two ~1KB entries
+
+    uint64_t keys[4];
+    const char *srcs = "0123";
+    for (int i = 0; i < 4; i++) {
+        keys[i] = cache_key(srcs + i, 1, 0);
+        cache_put(&c, keys[i], srcs + i, 1, body, sizeof(body), NULL, 0);
+        // distinct mtimes, oldest first, without sleeping
+        entry_file(&c, keys[i], path, sizeof(path));
+        struct timespec ts[2] = { { 1000 + i, 0 }, { 1000 + i, 0 } };
+        utimensat(AT_FDCWD, path, ts, 0);
+    }
+
+    cache_prune(&c);
+    ASSERT(c.evictions == 2, "two entries evicted");
+    CacheEntry e;
+    ASSERT(cache_get(&c, keys[0], srcs + 0, 1, &e) == -1, "oldest evicted");
+    ASSERT(cache_get(&c, keys[1], srcs + 1, 1, &e) == -1, "second oldest evicted");
+    ASSERT(cache_get(&c, keys[3], srcs + 3, 1, &e) == 0, "newest kept");
+    cache_entry_release(&e);
+
+    cache_close(&c);
+    rm_tree(dir);
+}
+
+int main(void) {
+    test_roundtrip();
+    test_key();
+    test_len_mismatch();
+    test_collision();
+    test_corrupt();
+    test_prune();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
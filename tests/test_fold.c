@@ -0,0 +1,396 @@
+#include "jsopt/fold.h"
+#include "list.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Single-character leaves at their offset in SRC
+static const char SRC[] = "a b c x y 0 1";
+#define AT_A 0
+#define AT_B 2
+#define AT_C 4
+#define AT_X 6
+#define AT_Y 8
+#define AT_0 10
+#define AT_1 12
+
+static uint32_t leaf(NodeArray *arr, NodeKind k, uint32_t start) {
+    return node_push_token(arr, k, start, 1, 1);
+}
+
+static uint32_t expr_stmt(NodeArray *arr, uint32_t e) {
+    return node_push(arr, NODE_EXPR_STMT, 0, 0, 0, e, 0);
+}
+
+static uint32_t bang(NodeArray *arr, uint32_t e) {
+    return node_push(arr, NODE_UNARY, 0, NODE_BANG, 0, e, 0);
+}
+
+static uint32_t three(NodeArray *arr, NodeKind k, uint32_t test,
+                      uint32_t cons, uint32_t alt) {
+    uint32_t parts[3] = { test, cons, alt };
+    return node_push_ext(arr, k, 0, 0, 0, parts);
+}
+
+// Wrap one statement in a program and return the live (copied) statement
+static uint32_t program(NodeArray *arr, uint32_t stmt) {
+    arr->token_end = arr->count;
+    arr->root = make_list(arr, NODE_PROGRAM, 0, 0, &stmt, 1);
+    return arr->nodes[arr->root].data[0];
+}
+
+static const Node *child(const NodeArray *arr, uint32_t idx, int i) {
+    return &arr->nodes[arr->nodes[idx].data[i]];
+}
+
+// !0 -> true, !1 -> false
+static void test_bang_literals(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t t = bang(&arr, leaf(&arr, NODE_NUMBER, AT_0));
+    arr.nodes[t].start = AT_0 - 1;
+    uint32_t f = bang(&arr, leaf(&arr, NODE_NUMBER, AT_1));
+    arr.nodes[f].start = AT_1 - 1;
+    uint32_t stmts[2] = { expr_stmt(&arr, t), expr_stmt(&arr, f) };
+    arr.root = make_list(&arr, NODE_PROGRAM, 0, 0, stmts, 2);
+
+    uint32_t n = fold_conditionals(&arr, SRC);
+    ASSERT(n == 2, "two rewrites");
+    ASSERT(arr.nodes[t].kind == NODE_TRUE, "!0 -> true");
+    ASSERT(arr.nodes[t].op == 2, "true leaf spans !0");
+    ASSERT(arr.nodes[f].kind == NODE_FALSE, "!1 -> false");
+
+    node_array_free(&arr);
+}
+
+// !x is left alone
+static void test_bang_other(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t u = bang(&arr, leaf(&arr, NODE_IDENT, AT_X));
+    program(&arr, expr_stmt(&arr, u));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 0, "no rewrites");
+    ASSERT(arr.nodes[u].kind == NODE_UNARY, "!x unchanged");
+
+    node_array_free(&arr);
+}
+
+// if (a) b  ->  a && b
+static void test_if_and(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t b = leaf(&arr, NODE_IDENT, AT_B);
+    uint32_t s = program(&arr, three(&arr, NODE_IF, a, expr_stmt(&arr, b), 0));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 1, "one rewrite");
+    ASSERT(arr.nodes[s].kind == NODE_EXPR_STMT, "if -> expression statement");
+    const Node *e = child(&arr, s, 0);
+    ASSERT(e->kind == NODE_BINARY && e->op == NODE_AMP_AMP, "a && b");
+    ASSERT(e->data[0] == a && e->data[1] == b, "a && b operands");
+    ASSERT(e->data[0] < arr.nodes[s].data[0], "children precede parent");
+
+    node_array_free(&arr);
+}
+
+// if (!a) { b }  ->  a || b
+static void test_if_not_or(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t b = leaf(&arr, NODE_IDENT, AT_B);
+    uint32_t inner = expr_stmt(&arr, b);
+    uint32_t block = make_list(&arr, NODE_BLOCK, 0, 0, &inner, 1);
+    uint32_t s = program(&arr, three(&arr, NODE_IF, bang(&arr, a), block, 0));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 1, "one rewrite");
+    const Node *e = child(&arr, s, 0);
+    ASSERT(e->kind == NODE_BINARY && e->op == NODE_PIPE_PIPE, "a || b");
+    ASSERT(e->data[0] == a && e->data[1] == b, "a || b operands");
+
+    node_array_free(&arr);
+}
+
+// if (a) b; else c;  ->  a ? b : c
+static void test_if_else_ternary(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t b = leaf(&arr, NODE_IDENT, AT_B);
+    uint32_t c = leaf(&arr, NODE_IDENT, AT_C);
+    uint32_t sb = expr_stmt(&arr, b), sc = expr_stmt(&arr, c);
+    uint32_t s = program(&arr, three(&arr, NODE_IF, a, sb, sc));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 1, "one rewrite");
+    ASSERT(arr.nodes[s].kind == NODE_EXPR_STMT, "if -> expression statement");
+    uint32_t t = arr.nodes[s].data[0];
+    ASSERT(arr.nodes[t].kind == NODE_TERNARY, "ternary");
+    ASSERT(arr.nodes[t].data[0] == a, "ternary test");
+    const Node *e = child(&arr, t, 1);
+    ASSERT(e->kind == NODE_EXT, "ternary payload");
+    ASSERT(e->data[0] == b && e->data[1] == c, "ternary branches");
+    ASSERT(arr.nodes[t].data[1] < t, "payload precedes ternary");
+
+    node_array_free(&arr);
+}
+
+// if (!a) b; else c;  ->  a ? c : b
+static void test_if_else_not_swaps(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t b = leaf(&arr, NODE_IDENT, AT_B);
+    uint32_t c = leaf(&arr, NODE_IDENT, AT_C);
+    uint32_t na = bang(&arr, a);
+    uint32_t sb = expr_stmt(&arr, b), sc = expr_stmt(&arr, c);
+    uint32_t s = program(&arr, three(&arr, NODE_IF, na, sb, sc));
+
+    fold_conditionals(&arr, SRC);
+    uint32_t t = arr.nodes[s].data[0];
+    ASSERT(arr.nodes[t].data[0] == a, "negation dropped");
+    const Node *e = child(&arr, t, 1);
+    ASSERT(e->data[0] == c && e->data[1] == b, "branches swapped");
+
+    node_array_free(&arr);
+}
+
+// if (a) b; else { c; c; } is not an expression: untouched
+static void test_if_else_statements(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t sb = expr_stmt(&arr, leaf(&arr, NODE_IDENT, AT_B));
+    uint32_t two[2] = { expr_stmt(&arr, leaf(&arr, NODE_IDENT, AT_C)),
+                        expr_stmt(&arr, leaf(&arr, NODE_IDENT, AT_C)) };
+    uint32_t block = make_list(&arr, NODE_BLOCK, 0, 0, two, 2);
+    uint32_t s = program(&arr, three(&arr, NODE_IF, a, sb, block));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 0, "no rewrites");
+    ASSERT(arr.nodes[s].kind == NODE_IF, "if unchanged");
+
+    node_array_free(&arr);
+}
+
+// if (!0) b; else c;  ->  b;   if (!1) b;  ->  ;
+static void test_if_constant(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t t = bang(&arr, leaf(&arr, NODE_NUMBER, AT_0));
+    uint32_t b = leaf(&arr, NODE_IDENT, AT_B);
+    uint32_t sb = expr_stmt(&arr, b);
+    uint32_t sc = expr_stmt(&arr, leaf(&arr, NODE_IDENT, AT_C));
+    uint32_t if1 = three(&arr, NODE_IF, t, sb, sc);
+    uint32_t f = bang(&arr, leaf(&arr, NODE_NUMBER, AT_1));
+    uint32_t sy = expr_stmt(&arr, leaf(&arr, NODE_IDENT, AT_Y));
+    uint32_t if2 = three(&arr, NODE_IF, f, sy, 0);
+    uint32_t stmts[2] = { if1, if2 };
+    arr.root = make_list(&arr, NODE_PROGRAM, 0, 0, stmts, 2);
+    uint32_t first = arr.nodes[arr.root].data[0];
+
+    ASSERT(fold_conditionals(&arr, SRC) == 4, "two bangs, two ifs");
+    ASSERT(arr.nodes[first].kind == NODE_EXPR_STMT, "true branch kept");
+    ASSERT(arr.nodes[first].data[0] == b, "true branch is b");
+    ASSERT(arr.nodes[first + 1].kind == NODE_EMPTY, "false if -> empty");
+
+    node_array_free(&arr);
+}
+
+static uint32_t var_x(NodeArray *arr, uint32_t at) {
+    uint32_t d = node_push(arr, NODE_DECLARATOR, 0, 0, at, leaf(arr, NODE_IDENT, at),
+                           leaf(arr, NODE_NUMBER, AT_1));
+    return make_list(arr, NODE_VAR_DECL, 0, 0, &d, 1);
+}
+
+// if (!1) { var x = 1 }  ->  var x;   (x stays declared, reads undefined)
+static void test_if_constant_keeps_var(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t f = bang(&arr, leaf(&arr, NODE_NUMBER, AT_1));
+    uint32_t v = var_x(&arr, AT_X);
+    uint32_t block = make_list(&arr, NODE_BLOCK, 0, 0, &v, 1);
+    uint32_t s = program(&arr, three(&arr, NODE_IF, f, block, 0));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 2, "bang and if folded");
+    const Node *d = &arr.nodes[s];
+    ASSERT(d->kind == NODE_VAR_DECL && d->flags == 0 && d->data[1] == 1, "var left behind");
+    const Node *x = &arr.nodes[d->data[0]];
+    ASSERT(x->kind == NODE_DECLARATOR && x->data[1] == 0, "declarator without initializer");
+    ASSERT(arr.nodes[x->data[0]].kind == NODE_IDENT && arr.nodes[x->data[0]].start == AT_X,
+           "declares x");
+    ASSERT(d->data[0] > arr.root, "new nodes appended past the root");
+
+    node_array_free(&arr);
+}
+
+// if (!0) a; else { var y = 1 }  ->  { a; var y; }
+static void test_if_constant_keeps_else_var(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t t = bang(&arr, leaf(&arr, NODE_NUMBER, AT_0));
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t sa = expr_stmt(&arr, a);
+    uint32_t v = var_x(&arr, AT_Y);
+    uint32_t block = make_list(&arr, NODE_BLOCK, 0, 0, &v, 1);
+    uint32_t s = program(&arr, three(&arr, NODE_IF, t, sa, block));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 2, "bang and if folded");
+    const Node *b = &arr.nodes[s];
+    ASSERT(b->kind == NODE_BLOCK && b->data[1] == 2, "taken branch and var in a block");
+    const Node *first = &arr.nodes[b->data[0]], *second = &arr.nodes[b->data[0] + 1];
+    ASSERT(first->kind == NODE_EXPR_STMT && first->data[0] == a, "taken branch first");
+    ASSERT(second->kind == NODE_VAR_DECL && second->data[1] == 1 &&
+           arr.nodes[arr.nodes[second->data[0]].data[0]].start == AT_Y, "then var y");
+    ASSERT(b->data[0] > arr.root, "new nodes appended past the root");
+
+    node_array_free(&arr);
+}
+
+// if (!1) { function f() {} } keeps the if: Annex B hoists f
+static void test_if_constant_keeps_function(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t f = bang(&arr, leaf(&arr, NODE_NUMBER, AT_1));
+    uint32_t fn = node_push(&arr, NODE_FUNC_DECL, 0, 0, AT_C, 0, 0);
+    uint32_t block = make_list(&arr, NODE_BLOCK, 0, 0, &fn, 1);
+    uint32_t s = program(&arr, three(&arr, NODE_IF, f, block, 0));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 1, "only the bang folded");
+    ASSERT(arr.nodes[s].kind == NODE_IF, "if kept");
+
+    node_array_free(&arr);
+}
+
+// a ? (b ? x : y) : y  ->  a && b ? x : y
+static void test_nested_ternary_and(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t b = leaf(&arr, NODE_IDENT, AT_B);
+    uint32_t x = leaf(&arr, NODE_IDENT, AT_X);
+    uint32_t y1 = leaf(&arr, NODE_IDENT, AT_Y);
+    uint32_t inner = three(&arr, NODE_TERNARY, b, x, y1);
+    uint32_t y2 = leaf(&arr, NODE_IDENT, AT_Y);
+    uint32_t outer = three(&arr, NODE_TERNARY, a, inner, y2);
+    program(&arr, expr_stmt(&arr, outer));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 1, "one rewrite");
+    const Node *test = child(&arr, outer, 0);
+    ASSERT(test->kind == NODE_BINARY && test->op == NODE_AMP_AMP, "test is a && b");
+    ASSERT(test->data[0] == a && test->data[1] == b, "a && b operands");
+    const Node *e = child(&arr, outer, 1);
+    ASSERT(e->data[0] == x && e->data[1] == y2, "branches x : y");
+
+    node_array_free(&arr);
+}
+
+// a ? x : (b ? x : y)  ->  a || b ? x : y
+static void test_nested_ternary_or(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t x1 = leaf(&arr, NODE_IDENT, AT_X);
+    uint32_t b = leaf(&arr, NODE_IDENT, AT_B);
+    uint32_t x2 = leaf(&arr, NODE_IDENT, AT_X);
+    uint32_t y = leaf(&arr, NODE_IDENT, AT_Y);
+    uint32_t inner = three(&arr, NODE_TERNARY, b, x2, y);
+    uint32_t outer = three(&arr, NODE_TERNARY, a, x1, inner);
+    program(&arr, expr_stmt(&arr, outer));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 1, "one rewrite");
+    const Node *test = child(&arr, outer, 0);
+    ASSERT(test->kind == NODE_BINARY && test->op == NODE_PIPE_PIPE, "test is a || b");
+    const Node *e = child(&arr, outer, 1);
+    ASSERT(e->data[0] == x1 && e->data[1] == y, "branches x : y");
+
+    node_array_free(&arr);
+}
+
+// a ? (b ? x : y) : x has no shared branch: untouched
+static void test_nested_ternary_differs(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t b = leaf(&arr, NODE_IDENT, AT_B);
+    uint32_t inner = three(&arr, NODE_TERNARY, b, leaf(&arr, NODE_IDENT, AT_X),
+                           leaf(&arr, NODE_IDENT, AT_Y));
+    uint32_t outer = three(&arr, NODE_TERNARY, a, inner, leaf(&arr, NODE_IDENT, AT_X));
+    program(&arr, expr_stmt(&arr, outer));
+
+    ASSERT(fold_conditionals(&arr, SRC) == 0, "no rewrites");
+    ASSERT(arr.nodes[outer].data[0] == a, "test unchanged");
+
+    node_array_free(&arr);
+}
+
+// Dead originals left behind by make_list are never visited
+static void test_dead_nodes_skipped(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = leaf(&arr, NODE_IDENT, AT_A);
+    uint32_t b = leaf(&arr, NODE_IDENT, AT_B);
+    uint32_t orig = three(&arr, NODE_IF, a, expr_stmt(&arr, b), 0);
+    uint32_t s = program(&arr, orig);
+
+    ASSERT(fold_conditionals(&arr, SRC) == 1, "only the live copy is folded");
+    ASSERT(arr.nodes[orig].kind == NODE_IF, "dead original untouched");
+    ASSERT(arr.nodes[s].kind == NODE_EXPR_STMT, "live copy folded");
+
+    node_array_free(&arr);
+}
+
+// Empty tree
+static void test_no_root(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+    ASSERT(fold_conditionals(&arr, SRC) == 0, "no root, no rewrites");
+    node_array_free(&arr);
+}
+
+int main(void) {
+    test_bang_literals();
+    test_bang_other();
+    test_if_and();
+    test_if_not_or();
+    test_if_else_ternary();
+    test_if_else_not_swaps();
+    test_if_else_statements();
+    test_if_constant();
+    test_if_constant_keeps_var();
+    test_if_constant_keeps_else_var();
+    test_if_constant_keeps_function();
+    test_nested_ternary_and();
+    test_nested_ternary_or();
+    test_nested_ternary_differs();
+    test_dead_nodes_skipped();
+    test_no_root();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
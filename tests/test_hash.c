@@ -0,0 +1,101 @@
+#include "jsopt/hash.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+static unsigned char *pattern(size_t len) {
+    unsigned char *buf = malloc(len + 1);
+    uint32_t x = 12345;
+    for (size_t i = 0; i < len; i++) {
+        x = x * 1103515245u + 12345u;
+        buf[i] = (unsigned char)(x >> 16);
+    }
+    return buf;
+}
+
+// dispatching hash matches the scalar reference at every length around
+// stripe and block boundaries
+static void test_scalar_matches(void) {
+    size_t max = HASH_STRIPE * HASH_BLOCK_STRIPES * 2 + 200;
+    unsigned char *buf = pattern(max);
+    int mismatches = 0;
+    for (size_t len = 0; len <= max; len++)
+        if (hash64(buf, len, 7) != hash64_scalar(buf, len, 7)) mismatches++;
+    ASSERT(mismatches == 0, "hash64 == hash64_scalar for all lengths");
+    free(buf);
+}
+
+// same input, same hash; unaligned start does not matter
+static void test_deterministic(void) {
+    unsigned char *buf = pattern(1001);
+    unsigned char *copy = malloc(1001 + 1);
+    memcpy(copy + 1, buf, 1000);
+    ASSERT(hash64(buf, 1000, 0) == hash64(buf, 1000, 0), "repeatable");
+    ASSERT(hash64(buf, 1000, 0) == hash64(copy + 1, 1000, 0), "alignment independent");
+    free(buf);
+    free(copy);
+}
+
+// seed, length and single-bit changes all move the hash
+static void test_sensitivity(void) {
+    unsigned char *buf = pattern(2048);
+    uint64_t h = hash64(buf, 2048, 0);
+    ASSERT(h != hash64(buf, 2048, 1), "seed changes hash");
+    ASSERT(h != hash64(buf, 2047, 0), "length changes hash");
+    ASSERT(hash64(buf, 0, 0) != hash64(buf, 0, 1), "seed changes empty hash");
+
+    int same = 0;
+    for (size_t i = 0; i < 2048; i += 61) {
+        buf[i] ^= 1;
+        if (hash64(buf, 2048, 0) == h) same++;
+        buf[i] ^= 1;
+    }
+    ASSERT(same == 0, "single bit flips change hash");
+
+    // trailing zeros are not the same as a shorter input
+    unsigned char z[65] = {0};
+    ASSERT(hash64(z, 64, 0) != hash64(z, 65, 0), "zero tail length-sensitive");
+    free(buf);
+}
+
+// stripes are keyed by position: swapping two 64-byte stripes of one
+// block, or of a block and the tail, changes the hash in both paths
+static void test_stripe_order(void) {
+    size_t len = HASH_STRIPE * HASH_BLOCK_STRIPES + HASH_STRIPE;
+    unsigned char *buf = pattern(len);
+    unsigned char *swapped = malloc(len);
+    int same = 0;
+    for (size_t a = 0; a < HASH_BLOCK_STRIPES; a++) {
+        size_t b = a + 1 < HASH_BLOCK_STRIPES ? a + 1 : HASH_BLOCK_STRIPES;
+        memcpy(swapped, buf, len);
+        memcpy(swapped + a * HASH_STRIPE, buf + b * HASH_STRIPE, HASH_STRIPE);
+        memcpy(swapped + b * HASH_STRIPE, buf + a * HASH_STRIPE, HASH_STRIPE);
+        if (hash64(swapped, len, 0) == hash64(buf, len, 0)) same++;
+        if (hash64_scalar(swapped, len, 0) == hash64_scalar(buf, len, 0)) same++;
+    }
+    ASSERT(same == 0, "swapped stripes change hash");
+    free(buf);
+    free(swapped);
+}
+
+int main(void) {
+    test_scalar_matches();
+    test_deterministic();
+    test_sensitivity();
+    test_stripe_order();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
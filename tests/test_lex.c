@@ -0,0 +1,442 @@
+#include "jsopt/lex.h"
+#include "jsopt/source.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+static NodeArray arr;
+static CommentTable comments;
+static LexError err;
+static AtomTable *atoms; // set by test_atoms only
+static char *buf;
+
+// Lex text from a padded copy, as source_open would provide it
+static int run_len(const char *text, uint32_t len) {
+    free(buf);
+    buf = calloc(1, len + SOURCE_PADDING);
+    memcpy(buf, text, len);
+    node_array_reset(&arr);
+    memset(&err, 0, sizeof(err));
+    return lex(&arr, buf, len, &comments, atoms, &err);
+}
+
+static int run(const char *text) {
+    return run_len(text, (uint32_t)strlen(text));
+}
+
+// Token kinds of the last run match want (EOF implied)
+static int kinds_are(const uint8_t *want, uint32_t n) {
+    if (arr.token_end != n + 2) return 0;
+    for (uint32_t i = 0; i < n; i++)
+        if (arr.nodes[i + 1].kind != want[i]) return 0;
+    return arr.nodes[n + 1].kind == NODE_EOF;
+}
+
+// Text of token i (1-based) equals s
+static int text_is(uint32_t i, const char *s) {
+    const Node *n = &arr.nodes[i];
+    return NODE_LEN(n) == strlen(s) && !memcmp(buf + n->start, s, NODE_LEN(n));
+}
+
+static void test_basic(void) {
+    ASSERT(run("var a = b.c;") == 0, "lexes");
+    const uint8_t want[] = { NODE_KW_VAR, NODE_IDENT, NODE_EQ, NODE_IDENT,
+                             NODE_DOT, NODE_IDENT, NODE_SEMI };
+    ASSERT(kinds_are(want, COUNT(want)), "var statement kinds");
+    ASSERT(text_is(4, "b") && arr.nodes[4].start == 8, "ident span");
+    ASSERT(arr.nodes[8].start == 12 && NODE_LEN(&arr.nodes[8]) == 0, "EOF at len");
+
+    ASSERT(run("") == 0 && arr.token_end == 2, "empty input is just EOF");
+    ASSERT(run("#!/usr/bin/env node\nx") == 0 && arr.token_end == 3, "hashbang skipped");
+    ASSERT(arr.nodes[1].data[0] == 2, "hashbang line counted");
+}
+
+static void test_keywords(void) {
+    ASSERT(run("instanceof this typeofx in if_ null yield") == 0, "lexes");
+    const uint8_t want[] = { NODE_KW_INSTANCEOF, NODE_THIS, NODE_IDENT,
+                             NODE_KW_IN, NODE_IDENT, NODE_NULL, NODE_KW_YIELD };
+    ASSERT(kinds_are(want, COUNT(want)), "keywords and near misses");
+
+    ASSERT(run("v\\u0061r \\u{61}b #priv") == 0, "escapes lex");
+    const uint8_t esc[] = { NODE_IDENT, NODE_IDENT, NODE_IDENT };
+    ASSERT(kinds_are(esc, COUNT(esc)), "escaped keyword is an identifier");
+    ASSERT(text_is(3, "#priv"), "private name keeps '#'");
+
+    ASSERT(run("caf\xc3\xa9 \xe2\x84\xa6") == 0 && arr.token_end == 4, "non-ASCII identifiers");
+    ASSERT(text_is(1, "caf\xc3\xa9"), "UTF-8 identifier span");
+    ASSERT(run("\xf0\x9d\x90\x80x a\\u200Cb \\u{1D400} _\xd9\xa0") == 0 && arr.token_end == 6,
+           "astral start, escaped ZWNJ, Arabic-Indic digit continue");
+    ASSERT(run("a\xe2\x82\xac") < 0 && err.pos == 1, "currency sign is not an identifier");
+    ASSERT(run("\xf0\x9f\x98\x80") < 0 && err.pos == 0, "emoji is not an identifier");
+    ASSERT(run("\xc3x") < 0 && err.pos == 0, "malformed UTF-8");
+    ASSERT(run("\\u0030x") < 0 && run("a\\u{110000}") < 0, "escape outside ID_Start / range");
+    ASSERT(run("3\xcf\x80") < 0 && err.pos == 1, "identifier start directly after number");
+
+    // Long identifiers with non-ASCII at and around the block boundary
+    char id[160];
+    int ok = 1;
+    for (uint32_t at = 56; at < 72; at++) {
+        memset(id, 'a', sizeof(id));
+        memcpy(id + at, "\xc3\xa9", 2);
+        id[150] = ' ';
+        if (run_len(id, 152) != 0 || arr.token_end != 4 || NODE_END(&arr.nodes[1]) != 150)
+            ok = 0;
+    }
+    ASSERT(ok, "long UTF-8 identifiers");
+}
+
+static void test_punct(void) {
+    ASSERT(run("a>>>=b?.c?\?=d...e=>f!==g**=h?.5:i") == 0, "lexes");
+    const uint8_t want[] = {
+        NODE_IDENT, NODE_GT_GT_GT_EQ, NODE_IDENT, NODE_QUESTION_DOT, NODE_IDENT,
+        NODE_QUESTION_QUESTION_EQ, NODE_IDENT, NODE_DOT_DOT_DOT, NODE_IDENT,
+        NODE_ARROW_TOK, NODE_IDENT, NODE_BANG_EQ_EQ, NODE_IDENT, NODE_STAR_STAR_EQ,
+        NODE_IDENT, NODE_QUESTION, NODE_NUMBER, NODE_COLON, NODE_IDENT,
+    };
+    ASSERT(kinds_are(want, COUNT(want)), "longest match, ?. before digit");
+    ASSERT(run("a @ b") < 0 && err.pos == 2, "unexpected character");
+}
+
+static void test_numbers(void) {
+    ASSERT(run("0 1.5 .5 1e-3 0x1F 0b10n 1_000 12n 1..a") == 0, "lexes");
+    const uint8_t want[] = { NODE_NUMBER, NODE_NUMBER, NODE_NUMBER, NODE_NUMBER,
+                             NODE_NUMBER, NODE_NUMBER, NODE_NUMBER, NODE_NUMBER,
+                             NODE_NUMBER, NODE_DOT, NODE_IDENT };
+    ASSERT(kinds_are(want, COUNT(want)), "numeric forms");
+    ASSERT(text_is(4, "1e-3") && text_is(9, "1."), "number spans");
+    ASSERT(run("3in x") < 0 && err.pos == 1, "identifier after number");
+    ASSERT(run("1e+") < 0, "missing exponent");
+    ASSERT(run("0b12") < 0 && err.pos == 3, "binary digit out of range");
+}
+
+static void test_strings(void) {
+    ASSERT(run("'a\\'b' \"c\\\nd\" x") == 0, "lexes");
+    ASSERT(text_is(1, "'a\\'b'") && text_is(2, "\"c\\\nd\""), "string spans");
+    ASSERT(arr.nodes[3].data[0] == 2, "line continuation counted");
+    ASSERT(run("'abc") < 0 && err.pos == 0, "unterminated string");
+    ASSERT(run("'a\nb'") < 0, "newline ends string");
+
+    // Backslash runs and escaped CRLF straddling 64-byte blocks: an odd
+    // run escapes the quote, so the string runs on to the final one (an
+    // even run leaves that one unterminated, which fails after token 1)
+    char str[160];
+    int ok = 1, lines_ok = 1;
+    for (uint32_t at = 56; at < 72; at++) {
+        for (uint32_t k = 0; k < 6; k++) {
+            memset(str, 'x', sizeof(str));
+            str[0] = '\'';
+            memset(str + at, '\\', k);
+            str[at + k] = '\'';
+            str[150] = '\'';
+            uint32_t end = k % 2 ? 151 : at + k + 1;
+            run_len(str, 151);
+            if (arr.count < 2 || arr.nodes[1].kind != NODE_STRING ||
+                NODE_END(&arr.nodes[1]) != end)
+                ok = 0;
+        }
+        memset(str, 'x', sizeof(str));
+        str[0] = '"';
+        memcpy(str + at, "\\\r\n", 3);
+        memcpy(str + 140, "\"\ny", 3);
+        if (run_len(str, 143) != 0 || NODE_END(&arr.nodes[1]) != 141 ||
+            arr.nodes[2].data[0] != 3)
+            lines_ok = 0;
+    }
+    ASSERT(ok, "escaped quotes across blocks");
+    ASSERT(lines_ok, "escaped CRLF across blocks");
+
+    // 70000-byte string: length spills into data[1]
+    uint32_t n = 70000;
+    char *big = malloc(n);
+    memset(big, 'x', n);
+    big[0] = big[n - 1] = '"';
+    ASSERT(run_len(big, n) == 0, "long string lexes");
+    ASSERT(arr.nodes[1].op == NODE_LEN_OVERFLOW && NODE_LEN(&arr.nodes[1]) == n,
+           "overflow length");
+    free(big);
+}
+
+static void test_regex(void) {
+    ASSERT(run("x = a / b / c; y = /[/]\\//g.test(s)") == 0, "lexes");
+    ASSERT(arr.nodes[4].kind == NODE_SLASH && arr.nodes[6].kind == NODE_SLASH, "division");
+    ASSERT(arr.nodes[11].kind == NODE_REGEX && text_is(11, "/[/]\\//g"), "regex with class");
+
+    ASSERT(run("return /a/; a.return / 2; i++ / 2; (a) / 2") == 0, "lexes");
+    ASSERT(arr.nodes[2].kind == NODE_REGEX, "regex after keyword");
+    ASSERT(arr.nodes[7].kind == NODE_SLASH, "division after member keyword");
+    ASSERT(arr.nodes[12].kind == NODE_SLASH, "division after postfix");
+    ASSERT(arr.nodes[18].kind == NODE_SLASH, "division after paren");
+    ASSERT(run("/abc\n/") < 0, "unterminated regex");
+
+    ASSERT(run("/a/.test(b) / `${/c/}` / {} / d") == 0, "lexes");
+    const uint8_t want[] = {
+        NODE_REGEX, NODE_DOT, NODE_IDENT, NODE_LPAREN, NODE_IDENT, NODE_RPAREN,
+        NODE_SLASH, NODE_TEMPLATE_HEAD, NODE_REGEX, NODE_TEMPLATE_TAIL, NODE_SLASH,
+        NODE_LBRACE, NODE_RBRACE, NODE_SLASH, NODE_IDENT,
+    };
+    ASSERT(kinds_are(want, COUNT(want)), "regex at start and in substitution");
+
+    // Bodies longer than one 64-byte block, specials on both sides of it
+    char re[256];
+    memset(re, 'x', sizeof(re));
+    memcpy(re, "x=/", 3);
+    memcpy(re + 70, "[/\\]]", 5);
+    memcpy(re + 130, "\\//gi;", 6);
+    ASSERT(run_len(re, 136) == 0 && arr.nodes[3].kind == NODE_REGEX, "long regex lexes");
+    ASSERT(NODE_END(&arr.nodes[3]) == 135 && arr.nodes[4].kind == NODE_SEMI, "long regex span");
+    re[100] = '\n';
+    ASSERT(run_len(re, 136) < 0 && err.pos == 2, "newline deep in a regex");
+}
+
+static void test_templates(void) {
+    ASSERT(run("`a${b}c${ {d}.e + `f${g}` }h` / 2") == 0, "lexes");
+    const uint8_t want[] = {
+        NODE_TEMPLATE_HEAD, NODE_IDENT, NODE_TEMPLATE_MID, NODE_LBRACE, NODE_IDENT,
+        NODE_RBRACE, NODE_DOT, NODE_IDENT, NODE_PLUS, NODE_TEMPLATE_HEAD, NODE_IDENT,
+        NODE_TEMPLATE_TAIL, NODE_TEMPLATE_TAIL, NODE_SLASH, NODE_NUMBER,
+    };
+    ASSERT(kinds_are(want, COUNT(want)), "nested templates and braces");
+    ASSERT(text_is(1, "`a${") && text_is(3, "}c${") && text_is(13, "}h`"), "template spans");
+
+    ASSERT(run("`a\nb` x") == 0 && arr.nodes[1].kind == NODE_TEMPLATE_FULL, "full template");
+    ASSERT(arr.nodes[2].data[0] == 2, "template newline counted");
+    ASSERT(run("`a${b") < 0, "unterminated substitution");
+    ASSERT(run("`a") < 0, "unterminated template");
+    ASSERT(run("`\\`$\\{$}\\${`") == 0 && arr.token_end == 3, "escaped '`' and \"${\"");
+    ASSERT(run("`a\r\n\\\r\nb\r\xe2\x80\xa9` x") == 0 && arr.nodes[2].data[0] == 5,
+           "template line terminators");
+
+    // "${", escapes and CRLF straddling 64-byte blocks
+    char t[160];
+    int ok = 1;
+    for (uint32_t at = 56; at < 72; at++) {
+        for (uint32_t k = 0; k < 4; k++) {
+            memset(t, 'x', sizeof(t));
+            t[0] = '`';
+            memset(t + at, '\\', k);
+            memcpy(t + at + k, "${y}", 4);
+            memcpy(t + 150, "`\r\nz", 4);
+            int sub = k % 2 == 0;
+            if (run_len(t, 154) != 0 ||
+                arr.nodes[1].kind != (sub ? NODE_TEMPLATE_HEAD : NODE_TEMPLATE_FULL) ||
+                NODE_END(&arr.nodes[1]) != (sub ? at + k + 2 : 151) ||
+                arr.nodes[sub ? 5 : 2].data[0] != 2)
+                ok = 0;
+        }
+        memset(t, 'x', sizeof(t));
+        t[0] = '`';
+        memcpy(t + at, "\r\n\r$", 4);
+        memcpy(t + 150, "`\nz", 3);
+        if (run_len(t, 153) != 0 || arr.nodes[2].data[0] != 4) ok = 0;
+    }
+    ASSERT(ok, "template specials across blocks");
+
+    // One level past the inline stack
+    char deep[3 * LEX_TEMPLATE_DEPTH + 8];
+    uint32_t n = 0;
+    for (uint32_t i = 0; i <= LEX_TEMPLATE_DEPTH; i++) n += (uint32_t)sprintf(deep + n, "`${");
+    ASSERT(run_len(deep, n) < 0 && err.pos == 3 * LEX_TEMPLATE_DEPTH, "nesting limit");
+}
+
+static void test_trivia(void) {
+    ASSERT(run("a /* x\n y */ b // c\r\nd\xe2\x80\xa8" "e\xc2\xa0" "f") == 0, "lexes");
+    ASSERT(arr.token_end == 7, "comments and unicode spaces skipped");
+    ASSERT(arr.nodes[2].data[0] == 2 && arr.nodes[3].data[0] == 3, "comment lines");
+    ASSERT(arr.nodes[4].data[0] == 4 && text_is(5, "f"), "LS is a line terminator");
+    ASSERT(run("a /* b") < 0 && err.pos == 2, "unterminated comment");
+}
+
+static void test_comments(void) {
+    ASSERT(run("/*! (c) A */ a /* @lic */ b // @license MIT\nc //! x") == 0, "lexes");
+    ASSERT(arr.token_end == 5 && comments.count == 3, "legal comments kept, others not");
+    ASSERT(comments.items[0].start == 0 && comments.items[0].end == 12 &&
+           comments.items[0].attach == 1, "block comment span and attach");
+    ASSERT(comments.items[1].start == 28 && comments.items[1].end == 43 &&
+           comments.items[1].attach == 3, "line comment ends at the line terminator");
+    ASSERT(comments.items[2].attach == 4 && arr.nodes[4].kind == NODE_EOF,
+           "trailing comment attaches to EOF");
+    ASSERT(run("/**\n * @param x\n * @preserve\n */\nx") == 0 && comments.count == 1 &&
+           arr.nodes[1].data[0] == 5, "tag after other tags; lines counted");
+    ASSERT(run("a") == 0 && comments.count == 0, "table emptied per run");
+
+    // Tags and the closing "*/" straddling 64-byte blocks
+    char c[200];
+    int ok = 1;
+    for (uint32_t at = 50; at < 72; at++) {
+        memset(c, ' ', sizeof(c));
+        memcpy(c, "/*", 2);
+        memcpy(c + at, "@license", 8);
+        memcpy(c + at + 12, "*/x", 3);
+        if (run_len(c, at + 15) != 0 || comments.count != 1 ||
+            comments.items[0].end != at + 14 || arr.token_end != 3)
+            ok = 0;
+        memcpy(c, "//", 2);
+        memcpy(c + at + 12, "\r x", 3);
+        if (run_len(c, at + 15) != 0 || comments.count != 1 ||
+            comments.items[0].end != at + 12 || arr.nodes[1].data[0] != 2)
+            ok = 0;
+    }
+    ASSERT(ok, "comments across blocks");
+}
+
+// Identifier tokens carry their cooked name's atom in data[1]
+static void test_atoms(void) {
+    AtomTable t;
+    ASSERT(atom_table_init(&t, 100) == 0, "init");
+    atoms = &t;
+    ASSERT(run("ab = \\u0061b + a\\u{62} + #ab + \\u00e9 + \xc3\xa9 + this") == 0, "lexes");
+    uint32_t ab = atom_find(&t, "ab", 2);
+    ASSERT(ab != ATOM_NULL && arr.nodes[1].data[1] == ab, "plain identifier interned");
+    ASSERT(arr.nodes[3].data[1] == ab && arr.nodes[5].data[1] == ab,
+           "escapes decoded to the plain spelling");
+    ASSERT(arr.nodes[7].data[1] == atom_find(&t, "#ab", 3) && arr.nodes[7].data[1] != ab,
+           "private name keeps its '#'");
+    ASSERT(arr.nodes[9].data[1] == arr.nodes[11].data[1] &&
+           arr.nodes[9].data[1] == atom_find(&t, "\xc3\xa9", 2), "escape cooked to UTF-8");
+    ASSERT(arr.nodes[13].kind == NODE_THIS && arr.nodes[13].data[1] == 0,
+           "keywords are not interned");
+    ASSERT(atom_count(&t) == 3, "three names");
+
+    // Longer than the stack buffer, escapes included
+    static char longname[1200];
+    for (uint32_t i = 0; i < 200; i++) memcpy(longname + 6 * i, "\\u0078", 6);
+    ASSERT(run_len(longname, 1200) == 0 && arr.nodes[1].kind == NODE_IDENT, "long ident");
+    uint32_t len;
+    const char *name = atom_name(&t, arr.nodes[1].data[1], &len);
+    ASSERT(len == 200 && name[0] == 'x' && name[199] == 'x', "long escaped ident cooked");
+
+    atoms = NULL;
+    ASSERT(run("ab") == 0 && arr.nodes[1].data[1] == 0, "no table, no atoms");
+    atom_table_free(&t);
+}
+
+// Lex before, apply the diff to after with lex_edit, and check it equals
+// lexing after from scratch, comments and atoms included
+static LexSplice splice;
+
+static int edit_matches(const char *before, const char *after) {
+    uint32_t old_len = (uint32_t)strlen(before), len = (uint32_t)strlen(after);
+    if (run(before) != 0) return 0;
+    char *old = buf, *src = calloc(1, len + SOURCE_PADDING);
+    memcpy(src, after, len);
+    LexEdit edit;
+    lex_diff(old, old_len, src, len, &edit);
+    int rc = lex_edit(&arr, src, len, &edit, &comments, atoms, &splice, &err);
+
+    NodeArray full;
+    CommentTable full_comments = { 0 };
+    LexError full_err;
+    node_array_init(&full, 0);
+    int want = lex(&full, src, len, &full_comments, atoms, &full_err);
+    int same = rc == want;
+    if (same && rc == 0)
+        same = arr.count == full.count && arr.token_end == full.token_end &&
+               !memcmp(arr.nodes, full.nodes, (size_t)(full.count + 4) * sizeof(Node)) &&
+               comments.count == full_comments.count &&
+               (!comments.count ||
+                !memcmp(comments.items, full_comments.items, comments.count * sizeof(Comment)));
+    else if (same)
+        same = err.pos == full_err.pos && err.line == full_err.line && err.msg == full_err.msg;
+    node_array_free(&full);
+    comment_table_free(&full_comments);
+    buf = src;
+    free(old);
+    return same;
+}
+
+static void test_edit(void) {
+    AtomTable t;
+    ASSERT(atom_table_init(&t, 100) == 0, "init");
+    atoms = &t;
+    ASSERT(edit_matches("let a = b + c;\nf(x);\ng(y);", "let a = bb + c;\nf(x);\ng(y);"),
+           "identifier grows");
+    ASSERT(splice.first == 3 && splice.removed == 2 && splice.added == 2,
+           "re-lexed from the token before the edit to the first equal one");
+    ASSERT(edit_matches("a;\nb;\nc;", "a;\n\n\nb;\nc;"), "lines shift after the edit");
+    ASSERT(edit_matches("a = b\n/c/g.x", "a = (b\n/c/g).x"), "division becomes regex");
+    ASSERT(edit_matches("x = `a${b}c` + d", "x = `a${b} ${e}c` + d"), "template parts");
+    ASSERT(edit_matches("x = `a${b}c` + d; e", "x = `a${b}c + d; e"),
+           "opened template runs to the end");
+    ASSERT(edit_matches("x = 1; /*! keep */ y; // @license z\nw", "x = 10; /*! keep */ y; "
+                        "// @license z\nw"), "legal comments past the edit shift");
+    ASSERT(edit_matches("x; /*! a */ y", "x; /*! ab */ y"), "edit inside a legal comment");
+    ASSERT(edit_matches("x /* y */ z", "x /* y z"), "unterminated comment reported");
+    ASSERT(arr.token_end == 4 && arr.nodes[2].kind == NODE_IDENT,
+           "failed edit keeps the old tokens");
+    ASSERT(edit_matches("#!/usr/bin/env node\nx", "#!/usr/bin/env nodejs\nx"), "hashbang");
+    ASSERT(edit_matches("abc", ""), "everything deleted");
+    ASSERT(edit_matches("", "a.b"), "everything inserted");
+    ASSERT(edit_matches("a.b(c)", "a.b(c)"), "no edit");
+    ASSERT(splice.added == splice.removed, "no edit, same tokens");
+    ASSERT(edit_matches("f(a,b)", "f(a,b)\n"), "append at the end");
+
+    // Wide edits over many tokens
+    static char before[4000], after[4000];
+    for (uint32_t i = 0; i < 200; i++) memcpy(before + 15 * i, "v = a[i] / 2;\n ", 15);
+    memcpy(after, before, sizeof(after));
+    memcpy(after + 1500, "x=`${", 5);
+    ASSERT(edit_matches(before, after), "template opened mid-file");
+    memcpy(after + 1500, "/*a*/", 5);
+    ASSERT(edit_matches(before, after), "comment inserted mid-file");
+    ASSERT(splice.removed < 8 && splice.added < 8, "resynchronized right after");
+
+    // Tokens too long for op keep their end in data[1], which shifts too
+    static char long_before[70100], long_after[70100];
+    memset(long_before, 'x', 70050);
+    memcpy(long_before, "a = 1;\nb = \"", 12);
+    memcpy(long_before + 70040, "\"; c\n/2/", 9);
+    memcpy(long_after, "a = 12;\n\nb = \"", 14);
+    memcpy(long_after + 14, long_before + 12, 70049 - 12);
+    ASSERT(edit_matches(long_before, long_after) && arr.nodes[7].op == NODE_LEN_OVERFLOW,
+           "overflowed token after the edit");
+
+    atoms = NULL;
+    ASSERT(edit_matches("ab", "a b") && arr.nodes[1].data[1] == 0, "without atoms");
+    LexEdit bad = { 5, 9, 9 };
+    ASSERT(lex_edit(&arr, buf, 3, &bad, &comments, NULL, &splice, &err) < 0 && err.line == 0,
+           "edit past the end rejected");
+    atom_table_free(&t);
+}
+
+// Starting over on a used array gives the same tokens
+static void test_reuse(void) {
+    run("let x = 1");
+    uint32_t n = arr.token_end;
+    ASSERT(run("let x = 1") == 0 && arr.token_end == n, "relex after reset");
+}
+
+int main(void) {
+    node_array_init(&arr, 0);
+    test_basic();
+    test_keywords();
+    test_punct();
+    test_numbers();
+    test_strings();
+    test_regex();
+    test_templates();
+    test_trivia();
+    test_comments();
+    test_reuse();
+    test_atoms();
+    test_edit();
+    node_array_free(&arr);
+    comment_table_free(&comments);
+    free(buf);
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
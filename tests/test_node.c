@@ -306,6 +306,317 @@ static void test_node_macro(void) {
     node_array_free(&arr);
 }
 
+// list append: tail runs grow in place, others relocate once
+static void test_list_append(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = node_reserve(&arr, 2);
+    arr.nodes[a].start = 1; arr.nodes[a + 1].start = 2;
+    uint32_t b = node_reserve(&arr, 2);
+    arr.nodes[b].start = 3; arr.nodes[b + 1].start = 4;
+    node_push(&arr, NODE_EMPTY, 0, 0, 0, 0, 0);
+
+    // a is not at the tail: relocated
+    uint32_t before = arr.count;
+    uint32_t first = node_list_append(&arr, a, 2, b, 2);
+    ASSERT(first == before, "relocated run starts at old tail");
+    ASSERT(arr.count == before + 4, "relocation copies run + appended");
+    ASSERT(arr.nodes[first].start == 1 && arr.nodes[first + 3].start == 4,
+           "relocated run in order");
+
+    // now at the tail: grows in place
+    uint32_t again = node_list_append(&arr, first, 4, a, 1);
+    ASSERT(again == first, "tail run grows in place");
+    ASSERT(arr.count == before + 5, "only appended node copied");
+    ASSERT(arr.nodes[first + 4].start == 1, "appended node copied");
+
+    node_array_free(&arr);
+}
+
+// liveness: dead make_list originals stay unmarked, relinked runs are found
+static void test_mark_live(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t x = node_push_token(&arr, NODE_IDENT, 0, 1, 1);
+    uint32_t orig = node_push(&arr, NODE_EXPR_STMT, 0, 0, 0, x, 0);
+    uint32_t list = node_reserve(&arr, 2);
+    arr.nodes[list] = arr.nodes[orig];
+    arr.nodes[list + 1].kind = NODE_PROGRAM;
+    arr.nodes[list + 1].data[0] = list;
+    arr.nodes[list + 1].data[1] = 1;
+    arr.root = list + 1;
+
+    // relink the program's list past the root
+    uint32_t y = node_push_token(&arr, NODE_IDENT, 2, 1, 1);
+    uint32_t s2 = node_push(&arr, NODE_EXPR_STMT, 0, 0, 0, y, 0);
+    uint32_t moved = node_list_append(&arr, list, 1, s2, 1);
+    arr.nodes[arr.root].data[0] = moved;
+    arr.nodes[arr.root].data[1] = 2;
+
+    uint8_t live[64] = {0};
+    node_mark_live(&arr, live);
+    ASSERT(live[arr.root], "root live");
+    ASSERT(!live[orig], "dead original not live");
+    ASSERT(!live[list], "old list slot not live");
+    ASSERT(live[moved] && live[moved + 1], "relinked run live");
+    ASSERT(live[x] && live[y], "children of relinked run live");
+    ASSERT(!live[NODE_NULL_IDX], "sentinel not live");
+
+    node_array_free(&arr);
+}
+
+// parents and siblings: live tree only, relinked runs included
+static void test_parents(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    // if (a) b; else c;  then  x = y + z;
+    uint32_t a = node_push_token(&arr, NODE_IDENT, 0, 1, 1);
+    uint32_t b = node_push_token(&arr, NODE_IDENT, 2, 1, 1);
+    uint32_t c = node_push_token(&arr, NODE_IDENT, 4, 1, 1);
+    uint32_t parts[3] = { a, b, c };
+    uint32_t dead = node_push_ext(&arr, NODE_IF, 0, 0, 0, parts);
+    uint32_t ext = arr.nodes[dead].data[1];
+    uint32_t y = node_push_token(&arr, NODE_IDENT, 6, 1, 1);
+    uint32_t z = node_push_token(&arr, NODE_IDENT, 8, 1, 1);
+    uint32_t sum = node_push(&arr, NODE_BINARY, 0, NODE_PLUS, 6, y, z);
+    uint32_t x = node_push_token(&arr, NODE_IDENT, 10, 1, 1);
+    uint32_t asg = node_push(&arr, NODE_ASSIGN, 0, NODE_EQ, 10, x, sum);
+    uint32_t stmt = node_push(&arr, NODE_EXPR_STMT, 0, 0, 10, asg, 0);
+
+    // List of one copy of the if, then relinked past the root with stmt
+    uint32_t list = node_reserve(&arr, 1);
+    arr.nodes[list] = arr.nodes[dead];
+    arr.root = node_push(&arr, NODE_PROGRAM, 0, 0, 0, list, 1);
+    uint32_t moved = node_list_append(&arr, list, 1, stmt, 1);
+    arr.nodes[arr.root].data[0] = moved;
+    arr.nodes[arr.root].data[1] = 2;
+
+    uint32_t parent[64], next[64];
+    node_build_parents(&arr, parent);
+    ASSERT(parent[arr.root] == 0, "root has no parent");
+    ASSERT(parent[moved] == arr.root && parent[moved + 1] == arr.root, "relinked run");
+    ASSERT(parent[a] == moved && parent[b] == moved && parent[c] == moved, "if children");
+    ASSERT(!parent[ext], "extension slot is not a child");
+    ASSERT(parent[asg] == moved + 1 && parent[sum] == asg && parent[z] == sum,
+           "children of a relinked element");
+    ASSERT(!parent[dead] && !parent[list] && !parent[stmt], "dead nodes have no parent");
+
+    node_build_siblings(&arr, parent, next);
+    ASSERT(next[moved] == moved + 1 && next[moved + 1] == 0, "list siblings");
+    ASSERT(next[a] == b && next[b] == c && next[c] == 0, "siblings through the run");
+    ASSERT(next[x] == sum && next[y] == z && next[asg] == 0, "expression siblings");
+
+    node_array_free(&arr);
+}
+
+// reset: count back to 1, touched slots zero again for node_reserve
+static void test_kind_layout(void) {
+    int consistent = 1, tokens_opaque = 1;
+    for (int k = 0; k < 256; k++) {
+        const NodeLayout *l = &node_layout[k];
+        if (IS_TOKEN(k) && (l->arity || l->field[0] || l->field[1] || l->flags))
+            tokens_opaque = 0;
+        if (l->arity == NODE_ARITY_LIST) {
+            if (l->field[0] != NODE_FIELD_LIST || l->field[1] != NODE_FIELD_COUNT) consistent = 0;
+            continue;
+        }
+        // Slot children fill data[0..arity), the rest is not an index;
+        // more than two children need an extension run at data[1]
+        int wide = l->arity > 2;
+        if (wide != (l->field[1] == NODE_FIELD_EXT) || l->ext != (wide ? l->arity / 2 : 0) ||
+            l->optional >> l->arity)
+            consistent = 0;
+        for (int i = 0; i < 2; i++) {
+            int child = l->field[i] == NODE_FIELD_CHILD ||
+                        (i == 1 && l->field[i] == NODE_FIELD_EXT);
+            if (i < l->arity ? !child : l->field[i] != NODE_FIELD_NONE) consistent = 0;
+        }
+    }
+    ASSERT(tokens_opaque, "tokens have no layout");
+    ASSERT(consistent, "fields agree with arity");
+    ASSERT(node_layout[NODE_FOR].arity == 4 && node_layout[NODE_FOR].ext == 2, "for run");
+    ASSERT(node_layout[NODE_TRY].arity == 3 && node_layout[NODE_TRY].ext == 1, "try run");
+    ASSERT(node_layout[NODE_DECLARATOR].optional == 1 << 1, "optional init");
+    ASSERT(node_layout[NODE_EXT].arity == 0, "extension slots are opaque");
+    ASSERT((node_layout[NODE_BINARY].flags & NODE_LAYOUT_OP) &&
+           !(node_layout[NODE_IF].flags & NODE_LAYOUT_OP), "op flag");
+
+    Node list = { NODE_BLOCK, 0, 0, 0, { 5, 3 } };
+    Node unary = { NODE_UNARY, 0, NODE_MINUS, 0, { 7, 0 } };
+    Node ident = { NODE_IDENT, 0, 1, 0, { 1, 0 } };
+    ASSERT(node_child_count(&list) == 3, "list count from data[1]");
+    ASSERT(node_child_count(&unary) == 1, "slot count from arity");
+    ASSERT(node_child_count(&ident) == 0, "token has no children");
+}
+
+// extension runs: contiguous slots before the compound, read through
+static void test_push_ext(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    // for (; t; u) b
+    uint32_t t = node_push_token(&arr, NODE_IDENT, 0, 1, 1);
+    uint32_t u = node_push_token(&arr, NODE_IDENT, 2, 1, 1);
+    uint32_t b = node_push(&arr, NODE_EMPTY, 0, 0, 4, 0, 0);
+    uint32_t parts[4] = { 0, t, u, b };
+    uint32_t f = node_push_ext(&arr, NODE_FOR, 0, 0, 0, parts);
+    const Node *n = &arr.nodes[f];
+    ASSERT(n->data[0] == 0 && n->data[1] == b + 1 && f == b + 3, "run reserved before the for");
+    ASSERT(arr.nodes[b + 1].kind == NODE_EXT && arr.nodes[b + 2].kind == NODE_EXT, "ext slots");
+    ASSERT(arr.nodes[b + 2].data[0] == b && arr.nodes[b + 2].data[1] == 0, "odd tail zeroed");
+    ASSERT(node_child_count(n) == 4, "four children");
+    ASSERT(node_child(&arr, n, 0) == 0 && node_child(&arr, n, 1) == t &&
+           node_child(&arr, n, 2) == u && node_child(&arr, n, 3) == b, "children in order");
+
+    arr.root = node_push(&arr, NODE_PROGRAM, 0, 0, 0, f, 1);
+    uint8_t live[64] = {0};
+    node_mark_live(&arr, live);
+    ASSERT(live[t] && live[u] && live[b], "children live");
+    ASSERT(live[b + 1] && live[b + 2], "run live");
+
+    node_array_free(&arr);
+}
+
+// validate: a lexed-then-parsed array, then one corruption at a time
+static uint32_t v_tok, v_for, v_list, v_ext;
+
+// for (; t; ) b;  x = -y;  over tokens t, b, x, y, a keyword and EOF
+static void build_valid(NodeArray *arr) {
+    node_array_reset(arr);
+    node_push_token(arr, NODE_KW_FOR, 0, 3, 1);
+    uint32_t t = node_push_token(arr, NODE_IDENT, 6, 1, 1);
+    uint32_t b = node_push_token(arr, NODE_IDENT, 10, 1, 1);
+    uint32_t x = node_push_token(arr, NODE_IDENT, 13, 1, 1);
+    uint32_t y = node_push_token(arr, NODE_STRING, 18, 70000, 1);
+    node_push_token(arr, NODE_EOF, 70018, 0, 1);
+    arr->token_end = arr->count;
+    v_tok = y;
+
+    uint32_t body = node_push(arr, NODE_EXPR_STMT, 0, 0, 10, b, 0);
+    uint32_t parts[4] = { 0, t, 0, body };
+    v_for = node_push_ext(arr, NODE_FOR, 0, 0, 0, parts);
+    v_ext = arr->nodes[v_for].data[1];
+    uint32_t neg = node_push(arr, NODE_UNARY, 0, NODE_MINUS, 17, y, 0);
+    uint32_t asg = node_push(arr, NODE_ASSIGN, 0, NODE_EQ, 13, x, neg);
+    uint32_t stmt = node_push(arr, NODE_EXPR_STMT, 0, 0, 13, asg, 0);
+    // make_list: copies of both statements, the originals stay dead
+    v_list = node_reserve(arr, 2);
+    arr->nodes[v_list] = arr->nodes[v_for];
+    arr->nodes[v_list + 1] = arr->nodes[stmt];
+    arr->root = node_push(arr, NODE_PROGRAM, 0, 0, 0, v_list, 2);
+}
+
+static int invalid(NodeArray *arr, uint32_t idx, const char *msg) {
+    NodeError err = { 0, NULL };
+    int rc = node_array_validate(arr, &err);
+    if (rc == 0 || err.idx != idx || strcmp(err.msg, msg) != 0) {
+        fprintf(stderr, "  got %d, node %u: %s\n", rc, err.idx, err.msg ? err.msg : "-");
+        return 0;
+    }
+    return 1;
+}
+
+static void test_validate(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+    NodeError err = { 0, NULL };
+
+    build_valid(&arr);
+    ASSERT(node_array_validate(&arr, &err) == 0, "parser-shaped array is valid");
+    uint32_t asg = arr.nodes[v_list + 1].data[0];
+    uint32_t moved = node_list_append(&arr, v_list, 2, v_list + 1, 1);
+    arr.nodes[arr.root].data[0] = moved;
+    arr.nodes[arr.root].data[1] = 3;
+    ASSERT(invalid(&arr, asg, "node reached twice"), "statement copied twice");
+    arr.nodes[arr.root].data[1] = 2;
+    ASSERT(node_array_validate(&arr, &err) == 0, "run relinked past the root is valid");
+
+    build_valid(&arr);
+    arr.nodes[0].start = 1;
+    ASSERT(invalid(&arr, 0, "sentinel node 0 is not zero"), "sentinel");
+
+    build_valid(&arr);
+    arr.nodes[3].kind = NODE_BINARY;
+    ASSERT(invalid(&arr, 3, "non-token kind below token_end"), "token region");
+
+    build_valid(&arr);
+    arr.nodes[arr.count - 1].kind = NODE_COMMA;
+    ASSERT(invalid(&arr, arr.count - 1, "keyword, punctuation or operator token past token_end"),
+           "AST region, vector tail");
+
+    build_valid(&arr);
+    arr.nodes[v_tok].data[1] = arr.nodes[v_tok].start;
+    ASSERT(invalid(&arr, v_tok, "overflowed token does not end past its start"), "overflow end");
+
+    build_valid(&arr);
+    arr.nodes[v_list + 1].data[0] = arr.count;
+    ASSERT(invalid(&arr, v_list + 1, "child index out of range"), "child range");
+
+    build_valid(&arr);
+    arr.nodes[v_list + 1].data[0] = arr.root - 1;
+    ASSERT(invalid(&arr, v_list + 1, "child does not precede its parent"), "child order");
+
+    build_valid(&arr);
+    arr.nodes[v_ext + 1].data[0] = 0;
+    ASSERT(invalid(&arr, v_list, "required child missing"), "for body required");
+
+    build_valid(&arr);
+    arr.nodes[v_ext].data[0] = 1;
+    ASSERT(invalid(&arr, 1, "token kind used as an AST child"), "keyword as child");
+
+    build_valid(&arr);
+    arr.nodes[v_ext + 1].kind = NODE_EMPTY;
+    ASSERT(invalid(&arr, v_ext + 1, "extension run slot is not NODE_EXT"), "run kind");
+
+    build_valid(&arr);
+    arr.nodes[v_list + 1].data[0] = v_ext;
+    ASSERT(invalid(&arr, v_ext, "extension slot used as a child"), "bare ext slot");
+
+    build_valid(&arr);
+    arr.nodes[arr.root].data[1] = arr.count;
+    ASSERT(invalid(&arr, arr.root, "list run out of range"), "list range");
+
+    build_valid(&arr);
+    uint32_t neg = arr.nodes[arr.nodes[v_list + 1].data[0]].data[1];
+    arr.nodes[neg].op = NODE_LPAREN;
+    ASSERT(invalid(&arr, neg, "op is not an operator"), "unary op");
+    arr.nodes[neg].op = NODE_KW_IF;
+    ASSERT(invalid(&arr, neg, "op is not an operator"), "statement keyword as op");
+    arr.nodes[neg].op = NODE_KW_TYPEOF;
+    ASSERT(node_array_validate(&arr, &err) == 0, "keyword operator as op");
+
+    node_array_free(&arr);
+}
+
+static void test_reset(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t n = NODE_RESET_KEEP + 5000;
+    for (uint32_t i = 0; i < n; i++)
+        node_push(&arr, NODE_BINARY, 0xFF, NODE_PLUS, i, i, i);
+    arr.token_end = 7;
+    arr.root = n;
+
+    Node *before = arr.nodes;
+    node_array_reset(&arr);
+    ASSERT(arr.nodes == before, "reservation kept");
+    ASSERT(arr.count == 1, "count == 1 after reset");
+    ASSERT(arr.token_end == 0 && arr.root == 0, "token_end/root cleared");
+
+    uint32_t first = node_reserve(&arr, n);
+    uint32_t zero = 1;
+    for (uint32_t i = 0; i < n; i++)
+        zero &= arr.nodes[first + i].kind == 0 && arr.nodes[first + i].start == 0 &&
+                arr.nodes[first + i].data[1] == 0;
+    ASSERT(zero, "reserved slots zero after reset");
+
+    node_array_free(&arr);
+}
+
 int main(void) {
     test_struct_layout();
     test_enum_values();
@@ -324,6 +635,13 @@ int main(void) {
     test_null_idx();
     test_node_kind_macro();
     test_node_macro();
+    test_list_append();
+    test_mark_live();
+    test_parents();
+    test_kind_layout();
+    test_push_ext();
+    test_validate();
+    test_reset();
 
     printf("%d tests, %d failed\n", tests_run, tests_failed);
     return tests_failed ? 1 : 0;
@@ -0,0 +1,91 @@
+#include "jsopt/pool.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+#define NJOBS 1000
+
+typedef struct {
+    _Atomic uint32_t runs[NJOBS];
+    _Atomic uint32_t bad_worker;
+    uint32_t         nthreads;
+} Counts;
+
+static int count_job(void *ctx, uint32_t worker, uint32_t job) {
+    Counts *c = ctx;
+    atomic_fetch_add(&c->runs[job], 1);
+    if (worker >= c->nthreads) atomic_fetch_add(&c->bad_worker, 1);
+    return job % 10 == 0 ? -1 : 0;
+}
+
+static int all_once(Counts *c, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++)
+        if (atomic_load(&c->runs[i]) != 1) return 0;
+    return 1;
+}
+
+// every job runs exactly once, failures are counted
+static void test_run_all(void) {
+    static Counts c;
+    c.nthreads = 4;
+    uint32_t failed = pool_run(4, NJOBS, count_job, &c);
+    ASSERT(all_once(&c, NJOBS), "each job runs once");
+    ASSERT(failed == NJOBS / 10, "failures counted");
+    ASSERT(atomic_load(&c.bad_worker) == 0, "worker ids in range");
+}
+
+// more threads than jobs
+static void test_few_jobs(void) {
+    static Counts c;
+    c.nthreads = 3;
+    pool_run(64, 3, count_job, &c);
+    ASSERT(all_once(&c, 3), "three jobs run once");
+    ASSERT(atomic_load(&c.bad_worker) == 0, "threads clamped to jobs");
+}
+
+// single thread runs in order on the caller
+static int order_job(void *ctx, uint32_t worker, uint32_t job) {
+    uint32_t *next = ctx;
+    int ok = worker == 0 && job == *next;
+    (*next)++;
+    return ok ? 0 : -1;
+}
+
+static void test_single_thread_order(void) {
+    uint32_t next = 0;
+    ASSERT(pool_run(1, 50, order_job, &next) == 0, "jobs in index order");
+    ASSERT(next == 50, "all jobs ran");
+}
+
+// no jobs
+static void test_no_jobs(void) {
+    static Counts c;
+    c.nthreads = 1;
+    ASSERT(pool_run(8, 0, count_job, &c) == 0, "no jobs, no failures");
+}
+
+static void test_cpu_count(void) {
+    ASSERT(pool_cpu_count() >= 1, "at least one cpu");
+}
+
+int main(void) {
+    test_run_all();
+    test_few_jobs();
+    test_single_thread_order();
+    test_no_jobs();
+    test_cpu_count();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+#include "jsopt/sink.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+static int tmp_file(char *path) {
+    strcpy(path, "/tmp/jsopt_test_sink_XXXXXX");
+    return mkstemp(path);
+}
+
+// File content equals the pattern byte i % 251 for len bytes
+static int check_file(const char *path, size_t len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return 0;
+    size_t i = 0;
+    int c, ok = 1;
+    while ((c = fgetc(f)) != EOF) {
+        if (i >= len || c != (int)(i % 251)) ok = 0;
+        i++;
+    }
+    fclose(f);
+    return ok && i == len;
+}
+
+// Mixed write sizes spanning several chunks land in order
+static void run_stream(unsigned flags, const char *label) {
+    char path[64];
+    int fd = tmp_file(path);
+    size_t total = 3 * SINK_CHUNK + 12345;
+    char *pattern = malloc(total);
+    for (size_t i = 0; i < total; i++)
+        pattern[i] = (char)(i % 251);
+
+    Sink s;
+    ASSERT(sink_open(&s, fd, flags) == 0, label);
+    size_t at = 0, step = 1;
+    while (at < total) {
+        size_t n = step < total - at ? step : total - at;
+        if (n == 1) sink_putc(&s, pattern[at]);
+        else sink_write(&s, pattern + at, n);
+        at += n;
+        step = step * 7 % 100003 + 1; // 1 byte up to ~100 KB
+    }
+    ASSERT(sink_close(&s) == 0, label);
+    close(fd);
+    ASSERT(check_file(path, total), label);
+
+    free(pattern);
+    unlink(path);
+}
+
+static void test_stream_sync(void) { run_stream(SINK_SYNC, "sync stream"); }
+static void test_stream_async(void) { run_stream(0, "default stream"); }
+
+// single write larger than both buffers
+static void test_large_write(void) {
+    char path[64];
+    int fd = tmp_file(path);
+    size_t total = 5 * SINK_CHUNK / 2;
+    char *pattern = malloc(total);
+    for (size_t i = 0; i < total; i++)
+        pattern[i] = (char)(i % 251);
+
+    Sink s;
+    sink_open(&s, fd, 0);
+    sink_write(&s, pattern, total);
+    ASSERT(sink_close(&s) == 0, "close after large write");
+    close(fd);
+    ASSERT(check_file(path, total), "large write content");
+
+    free(pattern);
+    unlink(path);
+}
+
+// errors are sticky and reported at close
+static void test_error(void) {
+    char path[64];
+    close(tmp_file(path));
+    int fd = open(path, O_RDONLY);
+
+    Sink s;
+    sink_open(&s, fd, 0);
+    char block[4096] = {0};
+    for (int i = 0; i < 200; i++)
+        sink_write(&s, block, sizeof(block));
+    errno = 0;
+    ASSERT(sink_close(&s) == -1, "close reports failure");
+    ASSERT(errno == EBADF, "errno is EBADF");
+    close(fd);
+    unlink(path);
+}
+
+// empty sink writes nothing
+static void test_empty(void) {
+    char path[64];
+    int fd = tmp_file(path);
+    Sink s;
+    sink_open(&s, fd, 0);
+    ASSERT(sink_close(&s) == 0, "empty close");
+    close(fd);
+    ASSERT(check_file(path, 0), "file stays empty");
+    unlink(path);
+}
+
+int main(void) {
+    test_stream_sync();
+    test_stream_async();
+    test_large_write();
+    test_error();
+    test_empty();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
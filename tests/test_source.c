@@ -0,0 +1,157 @@
+#include "jsopt/source.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Write len bytes of a repeating pattern to a fresh temp file
+static void make_file(char *path, size_t len) {
+    strcpy(path, "/tmp/jsopt_test_source_XXXXXX");
+    int fd = mkstemp(path);
+    char *buf = malloc(len + 1);
+    for (size_t i = 0; i < len; i++)
+        buf[i] = (char)('a' + i % 26);
+    if (len && write(fd, buf, len) != (ssize_t)len)
+        fprintf(stderr, "short write\n");
+    close(fd);
+    free(buf);
+}
+
+static int padding_zero(const Source *src) {
+    for (uint32_t i = 0; i < SOURCE_PADDING; i++)
+        if (src->data[src->len + i] != 0) return 0;
+    return 1;
+}
+
+static int content_ok(const Source *src) {
+    for (uint32_t i = 0; i < src->len; i++)
+        if (src->data[i] != (char)('a' + i % 26)) return 0;
+    return 1;
+}
+
+// small file is mapped, padded, page aligned
+static void test_open_small(void) {
+    char path[64];
+    make_file(path, 100);
+
+    Source src;
+    ASSERT(source_open(&src, path) == 0, "open returns 0");
+    ASSERT(src.len == 100, "len == 100");
+    ASSERT(((uintptr_t)src.data % 64) == 0, "data 64-byte aligned");
+    ASSERT(content_ok(&src), "content matches");
+    ASSERT(padding_zero(&src), "padding is zero");
+
+#ifdef __AVX512F__
+    // full-width load straddling the end must not fault
+    __m512i v = _mm512_loadu_si512((const void *)(src.data + src.len));
+    ASSERT(_mm512_test_epi8_mask(v, v) == 0, "64-byte load past end is zero");
+#endif
+
+    source_close(&src);
+    ASSERT(src.data == NULL && src.map == NULL, "close clears struct");
+    unlink(path);
+}
+
+// a page-sized file has no slack in its last page: padding comes from the
+// anonymous tail
+static void test_open_page_exact(void) {
+    char path[64];
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    make_file(path, page);
+
+    Source src;
+    ASSERT(source_open(&src, path) == 0, "open returns 0");
+    ASSERT(src.len == page, "len == page size");
+    ASSERT(content_ok(&src), "content matches");
+    ASSERT(padding_zero(&src), "padding past page boundary is zero");
+    ASSERT(src.map_size >= page + SOURCE_PADDING, "mapping covers padding");
+
+    source_close(&src);
+    unlink(path);
+}
+
+// empty file still has readable padding
+static void test_open_empty(void) {
+    char path[64];
+    make_file(path, 0);
+
+    Source src;
+    ASSERT(source_open(&src, path) == 0, "open returns 0");
+    ASSERT(src.len == 0, "len == 0");
+    ASSERT(padding_zero(&src), "padding is zero");
+
+    source_close(&src);
+    unlink(path);
+}
+
+// missing file
+static void test_open_missing(void) {
+    Source src;
+    ASSERT(source_open(&src, "/nonexistent/jsopt.js") == -1, "open fails");
+    ASSERT(src.data == NULL, "data NULL on failure");
+}
+
+// pipe goes through the read fallback
+static void test_read_pipe(void) {
+    int fds[2];
+    ASSERT(pipe(fds) == 0, "pipe");
+    const char *text = "var x = 1;";
+    ASSERT(write(fds[1], text, strlen(text)) == (ssize_t)strlen(text), "write");
+    close(fds[1]);
+
+    Source src;
+    ASSERT(source_read_fd(&src, fds[0]) == 0, "read returns 0");
+    ASSERT(src.len == strlen(text), "len matches");
+    ASSERT(memcmp(src.data, text, src.len) == 0, "content matches");
+    ASSERT(padding_zero(&src), "padding is zero");
+    ASSERT(((uintptr_t)src.data % 64) == 0, "data 64-byte aligned");
+
+    source_close(&src);
+    close(fds[0]);
+}
+
+// read fallback grows past its initial buffer
+static void test_read_grow(void) {
+    char path[64];
+    size_t len = 300000;
+    make_file(path, len);
+
+    int fd = open(path, O_RDONLY);
+    Source src;
+    ASSERT(source_read_fd(&src, fd) == 0, "read returns 0");
+    ASSERT(src.len == len, "len matches");
+    ASSERT(content_ok(&src), "content matches after growth");
+    ASSERT(padding_zero(&src), "padding is zero after growth");
+
+    source_close(&src);
+    close(fd);
+    unlink(path);
+}
+
+int main(void) {
+    test_open_small();
+    test_open_page_exact();
+    test_open_empty();
+    test_open_missing();
+    test_read_pipe();
+    test_read_grow();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
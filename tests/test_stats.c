@@ -0,0 +1,110 @@
+#include "jsopt/stats.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+// `var a = b;` plus EOF and a compound
+static void build(NodeArray *arr) {
+    node_array_init(arr, 0);
+    node_push_token(arr, NODE_KW_VAR, 0, 3, 1);
+    uint32_t a = node_push_token(arr, NODE_IDENT, 4, 1, 1);
+    node_push_token(arr, NODE_EQ, 6, 1, 1);
+    uint32_t b = node_push_token(arr, NODE_IDENT, 8, 1, 1);
+    node_push_token(arr, NODE_SEMI, 9, 1, 1);
+    node_push_token(arr, NODE_EOF, 10, 0, 1);
+    arr->token_end = arr->count;
+    node_push(arr, NODE_DECLARATOR, 0, 0, 4, a, b);
+}
+
+// nodes are bucketed by NodeKind range, sentinel excluded
+static void test_record(void) {
+    NodeArray arr;
+    build(&arr);
+    Stats s;
+    memset(&s, 0, sizeof(s));
+    stats_record_array(&s, &arr);
+
+    ASSERT(s.nodes[NODE_CLASS_LEAF] == 2, "two leaves");
+    ASSERT(s.nodes[NODE_CLASS_KEYWORD] == 1, "one keyword");
+    ASSERT(s.nodes[NODE_CLASS_OPERATOR] == 1, "one operator");
+    ASSERT(s.nodes[NODE_CLASS_PUNCT] == 2, "semi and EOF are punct");
+    ASSERT(s.nodes[NODE_CLASS_COMPOUND] == 1, "one compound");
+    ASSERT(s.node_bytes == 8 * sizeof(Node), "bytes include sentinel");
+    ASSERT(s.peak_nodes == 8 && s.files == 1, "peak and files");
+    node_array_free(&arr);
+}
+
+// merge sums counters and keeps the larger peak
+static void test_merge(void) {
+    Stats a, b;
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    a.nodes[NODE_CLASS_LEAF] = 3;
+    a.peak_nodes = 10;
+    a.files = 1;
+    a.phase_cycles[PHASE_READ] = 100;
+    b.nodes[NODE_CLASS_LEAF] = 4;
+    b.peak_nodes = 7;
+    b.files = 2;
+    b.phase_cycles[PHASE_READ] = 50;
+    stats_merge(&a, &b);
+    ASSERT(a.nodes[NODE_CLASS_LEAF] == 7, "leaf counts summed");
+    ASSERT(a.peak_nodes == 10, "peak is max");
+    ASSERT(a.files == 3, "files summed");
+    ASSERT(a.phase_cycles[PHASE_READ] == 150, "cycles summed");
+}
+
+// Per-worker Stats in one array never share a cache line
+static void test_layout(void) {
+    ASSERT(_Alignof(Stats) == 64 && sizeof(Stats) % 64 == 0, "whole cache lines");
+}
+
+// report is one JSON object with every phase key
+static void test_print(void) {
+    Stats s;
+    memset(&s, 0, sizeof(s));
+    stats_start();
+    stats_mark(&s);
+    stats_phase(&s, PHASE_READ);
+
+    char *buf = NULL;
+    size_t len = 0;
+    FILE *f = open_memstream(&buf, &len);
+    stats_print_json(&s, f);
+    fclose(f);
+
+    ASSERT(buf[0] == '{' && buf[len - 2] == '}', "object");
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        char key[32];
+        snprintf(key, sizeof(key), "\"%s\":", PHASE_NAMES[p]);
+        ASSERT(strstr(buf, key) != NULL, "phase key present");
+    }
+    ASSERT(strstr(buf, "\"peak_rss_kb\":") != NULL, "rss key present");
+    ASSERT(strstr(buf, "\"compound\":") != NULL, "class key present");
+#ifndef JSOPT_STATS
+    ASSERT(strstr(buf, "\"read\": null") != NULL, "phases null without JSOPT_STATS");
+#endif
+    free(buf);
+}
+
+int main(void) {
+    test_record();
+    test_merge();
+    test_layout();
+    test_print();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
@@ -0,0 +1,66 @@
+#include "jsopt/unicode.h"
+#include <stdio.h>
+#include <stdint.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+static void test_id_start(void) {
+    ASSERT(unicode_is_id_start(0xE9), "e-acute (Ll)");
+    ASSERT(unicode_is_id_start(0x3A9) && unicode_is_id_start(0x4E2D), "Greek, CJK");
+    ASSERT(unicode_is_id_start(0x16EE), "runic letter number (Nl)");
+    ASSERT(unicode_is_id_start(0x2118) && unicode_is_id_start(0x309B), "Other_ID_Start");
+    ASSERT(unicode_is_id_start(0x1D400) && unicode_is_id_start(0x20000), "astral letters");
+    ASSERT(!unicode_is_id_start(0x2E2F), "Pattern_Syntax letter excluded");
+    ASSERT(!unicode_is_id_start(0x301) && !unicode_is_id_start(0x660), "marks, digits");
+    ASSERT(!unicode_is_id_start(0xA0) && !unicode_is_id_start(0x2028), "spaces");
+    ASSERT(!unicode_is_id_start(0x1F600) && !unicode_is_id_start(0xD800), "emoji, surrogate");
+    ASSERT(!unicode_is_id_start(0x10FFFF) && !unicode_is_id_start(0xFFFFFFFF), "out of range");
+}
+
+static void test_id_continue(void) {
+    ASSERT(unicode_is_id_continue(0xE9) && unicode_is_id_continue(0x4E2D), "ID_Start continues");
+    ASSERT(unicode_is_id_continue(0x301) && unicode_is_id_continue(0x903), "Mn, Mc");
+    ASSERT(unicode_is_id_continue(0x660) && unicode_is_id_continue(0x203F), "Nd, Pc");
+    ASSERT(unicode_is_id_continue(0xB7) && unicode_is_id_continue(0x1369), "Other_ID_Continue");
+    ASSERT(unicode_is_id_continue(0xE0100) && unicode_is_id_continue(0xE01EF),
+           "variation selectors up to the limit");
+    ASSERT(!unicode_is_id_continue(0xE01F0) && !unicode_is_id_continue(UNICODE_ID_LIMIT),
+           "past the limit");
+    ASSERT(!unicode_is_id_continue(0x200C), "ZWNJ is the lexer's addition");
+    ASSERT(!unicode_is_id_continue(0x2041) && !unicode_is_id_continue(0xD7),
+           "Pattern_Syntax punctuation, math");
+}
+
+static void test_utf8(void) {
+    uint32_t cp = 0;
+    ASSERT(unicode_utf8_decode((const uint8_t *)"a", &cp) == 1 && cp == 'a', "ASCII");
+    ASSERT(unicode_utf8_decode((const uint8_t *)"\xc3\xa9", &cp) == 2 && cp == 0xE9, "2 bytes");
+    ASSERT(unicode_utf8_decode((const uint8_t *)"\xe4\xb8\xad", &cp) == 3 && cp == 0x4E2D,
+           "3 bytes");
+    ASSERT(unicode_utf8_decode((const uint8_t *)"\xf0\x9d\x90\x80", &cp) == 4 && cp == 0x1D400,
+           "4 bytes");
+    ASSERT(!unicode_utf8_decode((const uint8_t *)"\xc0\xaf", &cp), "overlong 2");
+    ASSERT(!unicode_utf8_decode((const uint8_t *)"\xe0\x80\xaf", &cp), "overlong 3");
+    ASSERT(!unicode_utf8_decode((const uint8_t *)"\xed\xa0\x80", &cp), "surrogate");
+    ASSERT(!unicode_utf8_decode((const uint8_t *)"\xf4\x90\x80\x80", &cp), "past U+10FFFF");
+    ASSERT(!unicode_utf8_decode((const uint8_t *)"\x80", &cp), "stray continuation");
+    ASSERT(!unicode_utf8_decode((const uint8_t *)"\xe4\xb8", &cp), "truncated at terminator");
+}
+
+int main(void) {
+    test_id_start();
+    test_id_continue();
+    test_utf8();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+#include "jsopt/vars.h"
+#include "list.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+// One declarator per statement; the binding leaf's start doubles as a name
+static uint32_t decl(NodeArray *arr, uint8_t flags, uint32_t name, uint32_t init) {
+    uint32_t b = node_push_token(arr, NODE_IDENT, name, 1, 1);
+    uint32_t d = node_push(arr, NODE_DECLARATOR, 0, 0, name, b, init);
+    return make_list(arr, NODE_VAR_DECL, flags, 0, &d, 1);
+}
+
+static uint32_t for_stmt(NodeArray *arr, uint32_t init) {
+    uint32_t body = node_push(arr, NODE_EMPTY, 0, 0, 0, 0, 0);
+    uint32_t parts[4] = { init, 0, 0, body };
+    return node_push_ext(arr, NODE_FOR, 0, 0, 0, parts);
+}
+
+static uint32_t program(NodeArray *arr, const uint32_t *stmts, uint32_t n) {
+    arr->root = make_list(arr, NODE_PROGRAM, 0, 0, stmts, n);
+    return arr->nodes[arr->root].data[0];
+}
+
+static uint32_t stmt_count(const NodeArray *arr) {
+    return arr->nodes[arr->root].data[1];
+}
+
+// Binding name of declarator i of the VAR_DECL at idx
+static uint32_t decl_name(const NodeArray *arr, uint32_t idx, uint32_t i) {
+    const Node *d = &arr->nodes[arr->nodes[idx].data[0] + i];
+    return arr->nodes[d->data[0]].start;
+}
+
+// var a; var b;  ->  var a, b;
+static void test_merge_var(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t s[2] = { decl(&arr, 0, 10, 0), decl(&arr, 0, 20, 0) };
+    uint32_t first = program(&arr, s, 2);
+
+    ASSERT(vars_merge(&arr) == 1, "one statement removed");
+    ASSERT(stmt_count(&arr) == 1, "one statement left");
+    ASSERT(arr.nodes[first].kind == NODE_VAR_DECL, "still a var");
+    ASSERT(arr.nodes[first].data[1] == 2, "two declarators");
+    ASSERT(decl_name(&arr, first, 0) == 10, "a first");
+    ASSERT(decl_name(&arr, first, 1) == 20, "b second");
+
+    node_array_free(&arr);
+}
+
+// let a; const b; var c;  ->  unchanged
+static void test_kinds_differ(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t s[3] = { decl(&arr, NODE_FLAG_LET, 10, 0),
+                      decl(&arr, NODE_FLAG_CONST, 20, 0),
+                      decl(&arr, 0, 30, 0) };
+    program(&arr, s, 3);
+
+    ASSERT(vars_merge(&arr) == 0, "nothing removed");
+    ASSERT(stmt_count(&arr) == 3, "three statements left");
+
+    node_array_free(&arr);
+}
+
+// let a; let b; x; const c; const d;  ->  let a, b; x; const c, d;
+static void test_merge_runs(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t x = node_push(&arr, NODE_EMPTY, 0, 0, 0, 0, 0);
+    uint32_t s[5] = { decl(&arr, NODE_FLAG_LET, 10, 0),
+                      decl(&arr, NODE_FLAG_LET, 20, 0),
+                      x,
+                      decl(&arr, NODE_FLAG_CONST, 30, 0),
+                      decl(&arr, NODE_FLAG_CONST, 40, 0) };
+    uint32_t first = program(&arr, s, 5);
+
+    ASSERT(vars_merge(&arr) == 2, "two statements removed");
+    ASSERT(stmt_count(&arr) == 3, "three statements left");
+    ASSERT(arr.nodes[first].flags == NODE_FLAG_LET, "let kept");
+    ASSERT(arr.nodes[first].data[1] == 2, "let a, b");
+    ASSERT(arr.nodes[first + 1].kind == NODE_EMPTY, "statement kept in order");
+    ASSERT(arr.nodes[first + 2].flags == NODE_FLAG_CONST, "const kept");
+    ASSERT(decl_name(&arr, first + 2, 1) == 40, "const c, d");
+
+    node_array_free(&arr);
+}
+
+// var a; for (;;);  ->  for (var a;;);
+static void test_hoist_empty_init(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t s[2] = { decl(&arr, 0, 10, 0), for_stmt(&arr, 0) };
+    uint32_t first = program(&arr, s, 2);
+
+    ASSERT(vars_merge(&arr) == 1, "var folded into for");
+    ASSERT(stmt_count(&arr) == 1, "one statement left");
+    ASSERT(arr.nodes[first].kind == NODE_FOR, "for remains");
+    uint32_t init = arr.nodes[first].data[0];
+    ASSERT(arr.nodes[init].kind == NODE_VAR_DECL, "for init is var");
+    ASSERT(decl_name(&arr, init, 0) == 10, "for (var a;;)");
+
+    node_array_free(&arr);
+}
+
+// var a; var b; for (var i;;);  ->  for (var a, b, i;;);
+static void test_hoist_merge_init(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t a = decl(&arr, 0, 10, 0);
+    uint32_t b = decl(&arr, 0, 20, 0);
+    uint32_t i = decl(&arr, 0, 30, 0);
+    uint32_t s[3] = { a, b, for_stmt(&arr, i) };
+    uint32_t first = program(&arr, s, 3);
+
+    ASSERT(vars_merge(&arr) == 2, "both vars folded into for");
+    uint32_t init = arr.nodes[first].data[0];
+    ASSERT(init == i, "for init relinked in place");
+    ASSERT(arr.nodes[init].data[1] == 3, "three declarators");
+    ASSERT(decl_name(&arr, init, 0) == 10, "a first");
+    ASSERT(decl_name(&arr, init, 1) == 20, "b second");
+    ASSERT(decl_name(&arr, init, 2) == 30, "loop var last");
+
+    node_array_free(&arr);
+}
+
+// let a; for (;;);  ->  unchanged (let is block scoped)
+static void test_no_hoist_let(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t s[2] = { decl(&arr, NODE_FLAG_LET, 10, 0), for_stmt(&arr, 0) };
+    program(&arr, s, 2);
+
+    ASSERT(vars_merge(&arr) == 0, "let not hoisted");
+    ASSERT(stmt_count(&arr) == 2, "two statements left");
+
+    node_array_free(&arr);
+}
+
+// var a = b in c; for (;;);  ->  unchanged (would parse as for-in)
+static void test_no_hoist_in(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t l = node_push_token(&arr, NODE_IDENT, 1, 1, 1);
+    uint32_t r = node_push_token(&arr, NODE_IDENT, 2, 1, 1);
+    uint32_t in = node_push(&arr, NODE_BINARY, 0, NODE_KW_IN, 1, l, r);
+    uint32_t s[2] = { decl(&arr, 0, 10, in), for_stmt(&arr, 0) };
+    program(&arr, s, 2);
+
+    ASSERT(vars_merge(&arr) == 0, "in-initializer not hoisted");
+    ASSERT(stmt_count(&arr) == 2, "two statements left");
+
+    node_array_free(&arr);
+}
+
+// A long run costs one relocation plus one copy per declarator
+static void test_long_run_linear(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t s[100];
+    for (uint32_t i = 0; i < 100; i++)
+        s[i] = decl(&arr, 0, i, 0);
+    uint32_t first = program(&arr, s, 100);
+
+    uint32_t before = arr.count;
+    ASSERT(vars_merge(&arr) == 99, "99 statements removed");
+    ASSERT(arr.count - before == 100, "each declarator copied once");
+    ASSERT(arr.nodes[first].data[1] == 100, "100 declarators");
+    uint32_t ok = 1;
+    for (uint32_t i = 0; i < 100; i++)
+        ok &= decl_name(&arr, first, i) == i;
+    ASSERT(ok, "declarators in source order");
+
+    node_array_free(&arr);
+}
+
+// Nested blocks are merged too
+static void test_nested_block(void) {
+    NodeArray arr;
+    node_array_init(&arr, 64);
+
+    uint32_t inner[2] = { decl(&arr, 0, 10, 0), decl(&arr, 0, 20, 0) };
+    uint32_t block = make_list(&arr, NODE_BLOCK, 0, 0, inner, 2);
+    uint32_t first = program(&arr, &block, 1);
+
+    ASSERT(vars_merge(&arr) == 1, "inner statement removed");
+    ASSERT(arr.nodes[first].data[1] == 1, "block holds one statement");
+
+    node_array_free(&arr);
+}
+
+int main(void) {
+    test_merge_var();
+    test_kinds_differ();
+    test_merge_runs();
+    test_hoist_empty_init();
+    test_hoist_merge_init();
+    test_no_hoist_let();
+    test_no_hoist_in();
+    test_long_run_linear();
+    test_nested_block();
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
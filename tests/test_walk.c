@@ -0,0 +1,165 @@
+#include "jsopt/walk.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define ASSERT(cond, msg) do { \
+    tests_run++; \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg); \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Visit log: pre entries as idx, post entries as ~idx
+typedef struct {
+    uint32_t log[64];
+    uint32_t parents[64];
+    uint32_t n;
+    uint32_t skip;  // pre returns WALK_SKIP here
+    uint32_t stop;  // pre returns WALK_STOP here
+    uint64_t count;
+} Trace;
+
+static WalkAction pre(NodeArray *arr, uint32_t idx, uint32_t parent, void *ctx) {
+    (void)arr;
+    Trace *t = ctx;
+    t->count++;
+    if (t->n < 64) {
+        t->parents[t->n] = parent;
+        t->log[t->n++] = idx;
+    }
+    if (idx == t->stop) return WALK_STOP;
+    return idx == t->skip ? WALK_SKIP : WALK_CONTINUE;
+}
+
+static WalkAction post(NodeArray *arr, uint32_t idx, uint32_t parent, void *ctx) {
+    (void)arr;
+    (void)parent;
+    Trace *t = ctx;
+    t->count++;
+    if (t->n < 64) t->log[t->n++] = ~idx;
+    return WALK_CONTINUE;
+}
+
+static int log_is(const Trace *t, const uint32_t *want, uint32_t n) {
+    return t->n == n && !memcmp(t->log, want, n * sizeof(uint32_t));
+}
+
+static NodeArray arr;
+static uint32_t a, b, sum, x, asg, stmt, d, decl, list;
+
+// x = a + b; var d;  (the declarator has no init)
+static void build(void) {
+    node_array_reset(&arr);
+    a = node_push_token(&arr, NODE_IDENT, 4, 1, 1);
+    b = node_push_token(&arr, NODE_IDENT, 8, 1, 1);
+    sum = node_push(&arr, NODE_BINARY, 0, NODE_PLUS, 4, a, b);
+    x = node_push_token(&arr, NODE_IDENT, 0, 1, 1);
+    asg = node_push(&arr, NODE_ASSIGN, 0, NODE_EQ, 0, x, sum);
+    d = node_push_token(&arr, NODE_IDENT, 15, 1, 1);
+    uint32_t dcl = node_push(&arr, NODE_DECLARATOR, 0, 0, 15, d, 0);
+    list = node_reserve(&arr, 2);
+    arr.nodes[list] = (Node){ NODE_EXPR_STMT, 0, 0, 0, { asg, 0 } };
+    arr.nodes[list + 1] = (Node){ NODE_VAR_DECL, 0, 0, 11, { dcl, 1 } };
+    stmt = list;
+    decl = dcl;
+    arr.root = node_push(&arr, NODE_PROGRAM, 0, 0, 0, list, 2);
+}
+
+static void test_order(void) {
+    build();
+    Trace t = { .skip = 0, .stop = 0 };
+    ASSERT(walk(&arr, arr.root, pre, post, &t) == 0, "walk completes");
+    uint32_t r = arr.root, v = list + 1;
+    const uint32_t want[] = {
+        r, stmt, asg, x, ~x, sum, a, ~a, b, ~b, ~sum, ~asg, ~stmt,
+        v, decl, d, ~d, ~decl, ~v, ~r,
+    };
+    ASSERT(log_is(&t, want, sizeof(want) / sizeof(want[0])), "pre/post in child order");
+    ASSERT(t.parents[0] == 0 && t.parents[1] == r && t.parents[3] == asg, "parents passed");
+
+    memset(&t, 0, sizeof(t));
+    ASSERT(walk(&arr, 0, pre, post, &t) == 0 && t.n == 0, "null root");
+    ASSERT(walk(&arr, sum, NULL, post, &t) == 0 && t.n == 3 && t.log[2] == ~sum,
+           "post only, from a subtree");
+}
+
+static void test_skip_stop(void) {
+    build();
+    Trace t = { .skip = asg };
+    walk(&arr, arr.root, pre, post, &t);
+    ASSERT(t.log[2] == asg && t.log[3] == ~asg && t.log[4] == ~stmt, "skipped subtree, post kept");
+
+    memset(&t, 0, sizeof(t));
+    t.stop = a;
+    ASSERT(walk(&arr, arr.root, pre, post, &t) == 1, "stop reported");
+    ASSERT(t.log[t.n - 1] == a, "nothing after stop");
+}
+
+// pre swaps the operands before they are reached
+static WalkAction swap(NodeArray *arr, uint32_t idx, uint32_t parent, void *ctx) {
+    (void)parent;
+    Node *n = &arr->nodes[idx];
+    if (n->kind == NODE_BINARY) {
+        uint32_t l = n->data[0];
+        n->data[0] = n->data[1];
+        n->data[1] = l;
+    }
+    return pre(arr, idx, parent, ctx);
+}
+
+static void test_rewrite(void) {
+    build();
+    Trace t = { 0 };
+    walk(&arr, sum, swap, NULL, &t);
+    ASSERT(t.n == 3 && t.log[1] == b && t.log[2] == a, "children read after pre");
+}
+
+// for (; t; u) b: children come out of the extension run, its NODE_EXT
+// slots are never visited and the absent init is skipped
+static void test_extension(void) {
+    node_array_reset(&arr);
+    uint32_t t = node_push_token(&arr, NODE_IDENT, 0, 1, 1);
+    uint32_t u = node_push_token(&arr, NODE_IDENT, 2, 1, 1);
+    uint32_t body = node_push(&arr, NODE_EMPTY, 0, 0, 4, 0, 0);
+    uint32_t parts[4] = { 0, t, u, body };
+    uint32_t f = node_push_ext(&arr, NODE_FOR, 0, 0, 0, parts);
+    Trace tr = { 0 };
+    walk(&arr, f, pre, post, &tr);
+    const uint32_t want[] = { f, t, ~t, u, ~u, body, ~body, ~f };
+    ASSERT(log_is(&tr, want, sizeof(want) / sizeof(want[0])), "for children in order");
+    ASSERT(tr.parents[1] == f && tr.parents[5] == f, "the for is their parent");
+}
+
+// a+a+...+a, 100k deep: far past the inline frames
+static void test_deep(void) {
+    node_array_reset(&arr);
+    uint32_t n = 100000;
+    uint32_t left = node_push_token(&arr, NODE_IDENT, 0, 1, 1);
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t right = node_push_token(&arr, NODE_IDENT, 0, 1, 1);
+        left = node_push(&arr, NODE_BINARY, 0, NODE_PLUS, 0, left, right);
+    }
+    arr.root = left;
+    Trace t = { 0 };
+    ASSERT(walk(&arr, arr.root, pre, post, &t) == 0, "deep walk completes");
+    ASSERT(t.count == 2 * (uint64_t)(2 * n + 1), "every node entered and left");
+}
+
+int main(void) {
+    node_array_init(&arr, 0);
+    test_order();
+    test_skip_stop();
+    test_rewrite();
+    test_extension();
+    test_deep();
+    node_array_free(&arr);
+
+    printf("%d tests, %d failed\n", tests_run, tests_failed);
+    return tests_failed ? 1 : 0;
+}
@@ -0,0 +1,74 @@
+#!/bin/sh
+# End-to-end throughput: jsopt vs the oxc ground truth on one corpus.
+#
+# Usage: tools/bench.sh [-n ITERS] [corpus-dir]
+#
+# Without a corpus-dir, build/corpus is generated from test.js at sizes
+# 1 KB to 50 MB (copies wrapped in IIFEs so top-level names don't
+# collide). Both tools print the same JSON shape; this prints one summary
+# line per file plus the raw JSON under build/bench/. Runs offline: oxc is
+# built with --offline and skipped if its crates are not vendored.
+#
+# No speedup column: until parse and codegen land, jsopt only lexes and
+# writes the text back while oxc parses, minifies and prints, so a ratio
+# of the two MB/s figures would compare different work.
+set -eu
+
+cd "$(dirname "$0")/.."
+
+ITERS=3
+if [ "${1:-}" = "-n" ]; then
+    ITERS=$2
+    shift 2
+fi
+CORPUS=${1:-build/corpus}
+OUT=build/bench
+GT=tools/ground-truth/target/release/ground-truth
+
+make -s build/jsopt
+mkdir -p "$OUT"
+
+if [ $# -eq 0 ]; then
+    mkdir -p "$CORPUS"
+    unit="$OUT/unit.js"
+    { echo '(function () {'; grep -v '^export' test.js; echo '})();'; } > "$unit"
+    for spec in 1k:1024 64k:65536 1m:1048576 10m:10485760 50m:52428800; do
+        name=${spec%%:*}
+        size=${spec#*:}
+        file="$CORPUS/gen-$name.js"
+        [ -f "$file" ] && continue
+        n=$(( (size + $(wc -c < "$unit") - 1) / $(wc -c < "$unit") ))
+        awk -v n="$n" '{ buf = buf $0 "\n" } END { for (i = 0; i < n; i++) printf "%s", buf }' \
+            "$unit" > "$file"
+    done
+fi
+
+if [ ! -x "$GT" ] && command -v cargo >/dev/null 2>&1; then
+    (cd tools/ground-truth && cargo build --release --offline -q) 2>/dev/null || true
+fi
+[ -x "$GT" ] || echo "note: $GT not built; reporting jsopt only" >&2
+
+# field FILE KEY: first numeric value of "KEY": in a JSON file
+field() {
+    sed -n "s/.*\"$2\": \([0-9.]*\).*/\1/p" "$1" | head -n 1
+}
+
+printf '%-24s %10s %12s %12s %10s %10s\n' \
+    file bytes jsopt_MB/s oxc_MB/s jsopt_RSS oxc_RSS
+# Smallest first. Names stay NUL-separated up to ls and are read whole,
+# so spaces and glob characters survive; the tools get /dev/null as stdin
+find "$CORPUS" -name '*.js' -print0 | xargs -0 -r ls -Sr -- |
+while IFS= read -r file; do
+    base=$(basename "$file" .js)
+    ./build/jsopt -j 1 -b "$ITERS" "$file" < /dev/null > "$OUT/$base.jsopt.json"
+    js=$(field "$OUT/$base.jsopt.json" mb_per_s)
+    js_rss=$(field "$OUT/$base.jsopt.json" peak_rss_kb)
+    ox=- ox_rss=-
+    if [ -x "$GT" ]; then
+        "$GT" bench -n "$ITERS" "$file" < /dev/null > "$OUT/$base.oxc.json"
+        ox=$(field "$OUT/$base.oxc.json" mb_per_s)
+        ox_rss=$(field "$OUT/$base.oxc.json" peak_rss_kb)
+    fi
+    printf '%-24s %10s %12s %12s %10s %10s\n' \
+        "$base" "$(wc -c < "$file")" "$js" "$ox" "$js_rss" "$ox_rss"
+done
@@ -0,0 +1,82 @@
+#!/bin/sh
+# Differential lexer fuzzing plus a throughput check on what it finds.
+#
+# Usage: tools/fuzz.sh [-n ITERS] [-s SEED]
+#
+# 1. build/fuzz_lex mutates test.js and the saved corpus, checking the
+#    production lexer against the scalar reference build; new inputs go
+#    to build/fuzz/corpus, failing ones to build/fuzz/crash-*.js
+# 2. if the oxc ground truth is built, every corpus file is lexed by both
+#    and diffed with build/lexdiff; differing inputs are copied to
+#    build/fuzz/mismatch/
+# 3. jsopt -b runs over the corpus files that lex cleanly and its lex
+#    MB/s is compared with build/fuzz/baseline.json (written by the first
+#    run); more than 10% slower is reported and fails the script
+set -eu
+
+cd "$(dirname "$0")/.."
+
+ITERS=100000
+SEED=$(date +%s)
+while getopts n:s: opt; do
+    case $opt in
+    n) ITERS=$OPTARG ;;
+    s) SEED=$OPTARG ;;
+    *) echo "Usage: tools/fuzz.sh [-n ITERS] [-s SEED]" >&2; exit 2 ;;
+    esac
+done
+
+OUT=build/fuzz
+GT=tools/ground-truth/target/release/ground-truth
+
+make -s build/jsopt build/fuzz_lex build/lexdiff
+mkdir -p "$OUT/corpus"
+
+echo "fuzz: seed $SEED"
+(cd "$OUT" && ../fuzz_lex -n "$ITERS" -s "$SEED" corpus ../../test.js)
+
+if [ -x "$GT" ]; then
+    mkdir -p "$OUT/mismatch"
+    total=0 bad=0
+    for file in "$OUT"/corpus/*.js; do
+        total=$((total + 1))
+        # Inputs oxc rejects outright have no oracle
+        "$GT" lex "$file" > "$OUT/oracle.txt" 2>/dev/null || continue
+        if ! ./build/lexdiff "$file" "$OUT/oracle.txt" > "$OUT/lexdiff.txt"; then
+            bad=$((bad + 1))
+            cp "$file" "$OUT/mismatch/"
+            cat "$OUT/lexdiff.txt"
+        fi
+    done
+    echo "lexdiff: $bad of $total corpus files differ from oxc"
+else
+    echo "note: $GT not built; skipping the oxc diff" >&2
+fi
+
+# field FILE: lex mb_per_s from a jsopt -b report
+lex_mbps() {
+    sed -n 's/.*"lex": {"ns": [0-9]*, "mb_per_s": \([0-9.]*\)}.*/\1/p' "$1"
+}
+
+# Time only inputs that lex cleanly: a failed file counts its bytes but
+# not its lex time
+rm -rf "$OUT/valid"
+mkdir -p "$OUT/valid"
+for file in "$OUT"/corpus/*.js; do
+    ./build/jsopt "$file" > /dev/null 2>&1 && ln "$file" "$OUT/valid/"
+done
+./build/jsopt -j 1 -b 20 "$OUT/valid" > "$OUT/throughput.json"
+now=$(lex_mbps "$OUT/throughput.json")
+if [ ! -f "$OUT/baseline.json" ]; then
+    cp "$OUT/throughput.json" "$OUT/baseline.json"
+    echo "throughput: lex $now MB/s (saved as baseline)"
+    exit 0
+fi
+base=$(lex_mbps "$OUT/baseline.json")
+echo "throughput: lex $now MB/s, baseline $base MB/s"
+awk -v now="$now" -v base="$base" 'BEGIN {
+    if (base > 0 && now < base * 0.9) {
+        printf "throughput: lex regressed %.1f%%\n", 100 * (1 - now / base)
+        exit 1
+    }
+}'
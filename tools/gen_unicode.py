@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Generate src/unicode.c: two-level ID_Start / ID_Continue bitmaps.
+
+Usage: tools/gen_unicode.py [DerivedCoreProperties.txt] > src/unicode.c
+
+With DerivedCoreProperties.txt (unicode.org/Public/UCD/latest/ucd/) the
+properties are read as published. Without it they are derived from
+Python's unicodedata the way UAX #31 defines them, so the table can be
+regenerated offline; the Unicode version is recorded either way.
+
+Code points are split into 256-wide blocks. Each property maps a block
+(cp >> 8) to an index into one shared pool of deduplicated 256-bit
+blocks; the all-zero block is index 0, and code points past the last
+set bit are not covered at all.
+"""
+import re
+import sys
+import unicodedata
+
+# PropList.txt, stable since Unicode 6 (Other_ID_* exist for backward
+# compatibility and only ever grow by a few code points per version)
+OTHER_ID_START = [0x1885, 0x1886, 0x2118, 0x212E, 0x309B, 0x309C]
+OTHER_ID_CONTINUE = [0x00B7, 0x0387, *range(0x1369, 0x1372), 0x19DA]
+# Letters that are Pattern_Syntax
+PATTERN_SYNTAX_LETTERS = [0x2E2F]
+
+
+def from_ucd(path):
+    props = {"ID_Start": set(), "ID_Continue": set()}
+    version = "unknown"
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            m = re.match(r"# DerivedCoreProperties-(\S+)\.txt", line)
+            if m:
+                version = m.group(1)
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            cps, prop = (x.strip() for x in line.split(";"))
+            if prop not in props:
+                continue
+            lo, _, hi = cps.partition("..")
+            props[prop].update(range(int(lo, 16), int(hi or lo, 16) + 1))
+    return props["ID_Start"], props["ID_Continue"], version
+
+
+def from_unicodedata():
+    start, cont = set(), set()
+    for cp in range(0x110000):
+        cat = unicodedata.category(chr(cp))
+        if cat in ("Lu", "Ll", "Lt", "Lm", "Lo", "Nl"):
+            start.add(cp)
+        elif cat in ("Mn", "Mc", "Nd", "Pc"):
+            cont.add(cp)
+    start.update(OTHER_ID_START)
+    start.difference_update(PATTERN_SYNTAX_LETTERS)
+    cont |= start
+    cont.update(OTHER_ID_CONTINUE)
+    return start, cont, unicodedata.unidata_version
+
+
+def blocks(cps, limit):
+    out = []
+    for b in range(limit >> 8):
+        words = [0, 0, 0, 0]
+        for cp in range(b << 8, (b + 1) << 8):
+            if cp in cps:
+                words[(cp >> 6) & 3] |= 1 << (cp & 63)
+        out.append(tuple(words))
+    return out
+
+
+def main():
+    if len(sys.argv) > 1:
+        start, cont, version = from_ucd(sys.argv[1])
+        source = "DerivedCoreProperties-%s.txt" % version
+    else:
+        start, cont, version = from_unicodedata()
+        source = "Python unicodedata %s (UAX #31 derivation)" % version
+    # ASCII is classified by the lexer itself
+    start = {cp for cp in start if cp >= 0x80}
+    cont = {cp for cp in cont if cp >= 0x80}
+    limit = (max(cont) >> 8) + 1 << 8
+
+    pool = {(0, 0, 0, 0): 0}
+    index = {}
+    for name, cps in (("START", start), ("CONTINUE", cont)):
+        index[name] = [pool.setdefault(w, len(pool)) for w in blocks(cps, limit)]
+    if len(pool) > 256:
+        sys.exit("gen_unicode: %d blocks do not fit a uint8_t index" % len(pool))
+
+    w = sys.stdout.write
+    w("// Generated by tools/gen_unicode.py; do not edit\n")
+    w("// Source: %s\n" % source)
+    w('#include "jsopt/unicode.h"\n\n')
+    w("_Static_assert(UNICODE_ID_LIMIT == 0x%X, \"regenerate unicode.h\");\n" % limit)
+    w("_Static_assert(UNICODE_ID_BLOCKS == %d, \"regenerate unicode.h\");\n\n" % len(pool))
+    for name in ("START", "CONTINUE"):
+        w("const uint8_t unicode_id_%s[UNICODE_ID_LIMIT >> 8] = {\n" % name.lower())
+        idx = index[name]
+        for i in range(0, len(idx), 16):
+            w("    " + " ".join("%d," % x for x in idx[i:i + 16]) + "\n")
+        w("};\n\n")
+    w("const uint64_t unicode_id_blocks[UNICODE_ID_BLOCKS][4] = {\n")
+    for words, i in sorted(pool.items(), key=lambda kv: kv[1]):
+        w("    { " + ", ".join("0x%016XULL" % x for x in words) + " },\n")
+    w("};\n")
+    sys.stderr.write("gen_unicode: Unicode %s, limit 0x%X, %d blocks\n"
+                     % (version, limit, len(pool)))
+
+
+if __name__ == "__main__":
+    main()
@@ -3,12 +3,15 @@
 //!
 //! Usage: ground-truth <mode> <file.js>
 //! Modes: lex, ast, minify, mangle, scope, all
+//!        bench [-n ITERS] <file.js | dir>...   (per-phase throughput JSON)
 //!
 //! NOTE: oxc API changes between versions. If this doesn't compile on your
 //! oxc version, compiler errors will point to the exact fixes needed.
 
 #![allow(unused_imports)]
 
+use std::path::{Path, PathBuf};
+use std::time::Instant;
 use std::{env, fmt, fs, process};
 
 use oxc_allocator::Allocator;
@@ -51,6 +54,13 @@ fn main() {
     }
 
     let mode = &args[1];
+
+    // Bench mode takes several inputs (files or directories)
+    if mode == "bench" {
+        cmd_bench(&args[2..]);
+        return;
+    }
+
     let path = &args[2];
 
     let source = fs::read_to_string(path).unwrap_or_else(|e| {
@@ -135,6 +145,7 @@ fn usage() -> ! {
     eprintln!("  mangle   Minified + mangled output");
     eprintln!("  scope    Scope analysis (per-reference resolution)");
     eprintln!("  all      All of the above");
+    eprintln!("  bench    Per-phase MB/s and peak RSS as JSON (args: [-n ITERS] <file.js | dir>...)");
     eprintln!();
     eprintln!("AST node count: ground-truth ast <file> | wc -l");
     process::exit(1);
@@ -1160,3 +1171,150 @@ fn cmd_scope(program: &Program) {
         }
     }
 }
+
+// ============================================================================
+// BENCH MODE — per-phase throughput, same JSON shape as `jsopt -b`
+// ============================================================================
+
+const BENCH_PHASES: [&str; 6] = ["read", "lex", "parse", "scope", "mangle", "codegen"];
+
+fn collect_js(path: &Path, out: &mut Vec<PathBuf>) {
+    if path.is_dir() {
+        let mut entries: Vec<PathBuf> = fs::read_dir(path)
+            .unwrap_or_else(|e| {
+                eprintln!("error: {}: {e}", path.display());
+                process::exit(1);
+            })
+            .filter_map(|e| e.ok().map(|e| e.path()))
+            .filter(|p| !p.file_name().map_or(false, |n| n.to_string_lossy().starts_with('.')))
+            .collect();
+        entries.sort();
+        for p in entries {
+            collect_js(&p, out);
+        }
+    } else if path.extension().map_or(false, |e| e == "js" || e == "mjs" || e == "cjs") {
+        out.push(path.to_path_buf());
+    }
+}
+
+/// Peak resident set size (VmHWM) in KB, 0 if /proc is unavailable.
+fn peak_rss_kb() -> u64 {
+    fs::read_to_string("/proc/self/status")
+        .ok()
+        .and_then(|s| {
+            s.lines()
+                .find(|l| l.starts_with("VmHWM:"))
+                .and_then(|l| l.split_whitespace().nth(1).and_then(|v| v.parse().ok()))
+        })
+        .unwrap_or(0)
+}
+
+fn mb_per_s(bytes: u64, ns: u128) -> f64 {
+    if ns == 0 { 0.0 } else { bytes as f64 * 1e3 / ns as f64 }
+}
+
+fn cmd_bench(args: &[String]) {
+    let mut iters: u32 = 1;
+    let mut files = Vec::new();
+    let mut i = 0;
+    while i < args.len() {
+        if args[i] == "-n" && i + 1 < args.len() {
+            iters = args[i + 1].parse().unwrap_or(1).max(1);
+            i += 2;
+            continue;
+        }
+        collect_js(Path::new(&args[i]), &mut files);
+        i += 1;
+    }
+    if files.is_empty() {
+        usage();
+    }
+
+    let mut ns = [0u128; BENCH_PHASES.len()];
+    let mut bytes: u64 = 0;
+    let wall = Instant::now();
+
+    for path in &files {
+        let source_type = SourceType::from_path(path).unwrap_or_default();
+        for _ in 0..iters {
+            let t = Instant::now();
+            let source = fs::read_to_string(path).unwrap_or_else(|e| {
+                eprintln!("error: {}: {e}", path.display());
+                process::exit(1);
+            });
+            ns[0] += t.elapsed().as_nanos();
+            bytes += source.len() as u64;
+
+            let t = Instant::now();
+            {
+                let allocator = Allocator::default();
+                let mut lexer = Lexer::new_for_benchmarks(&allocator, &source, source_type);
+                let mut token = lexer.first_token();
+                while token.kind() != Kind::Eof {
+                    token = lexer.next_token();
+                }
+            }
+            ns[1] += t.elapsed().as_nanos();
+
+            let allocator = Allocator::default();
+            let t = Instant::now();
+            let ret = Parser::new(&allocator, &source, source_type).parse();
+            ns[2] += t.elapsed().as_nanos();
+            if !ret.errors.is_empty() {
+                eprintln!("error: {}: {} parse error(s)", path.display(), ret.errors.len());
+                process::exit(1);
+            }
+
+            let t = Instant::now();
+            let semantic = SemanticBuilder::new().build(&ret.program);
+            ns[3] += t.elapsed().as_nanos();
+            std::hint::black_box(&semantic);
+            drop(semantic);
+
+            // Includes the mangler's own scope pass, as jsopt's mangle will
+            let t = Instant::now();
+            let mr = Mangler::new()
+                .with_options(MangleOptions {
+                    top_level: Some(true),
+                    ..Default::default()
+                })
+                .build(&ret.program);
+            ns[4] += t.elapsed().as_nanos();
+
+            let t = Instant::now();
+            let code = Codegen::new()
+                .with_options(CodegenOptions {
+                    minify: true,
+                    comments: no_comments(),
+                    ..Default::default()
+                })
+                .with_scoping(Some(mr.scoping))
+                .with_private_member_mappings(Some(mr.class_private_mappings))
+                .build(&ret.program)
+                .code;
+            ns[5] += t.elapsed().as_nanos();
+            std::hint::black_box(code);
+        }
+    }
+    let wall_ns = wall.elapsed().as_nanos();
+
+    println!("{{");
+    println!(
+        "  \"tool\": \"oxc\", \"files\": {}, \"iterations\": {}, \"bytes\": {},",
+        files.len(), iters, bytes
+    );
+    println!(
+        "  \"wall_ns\": {}, \"mb_per_s\": {:.2}, \"peak_rss_kb\": {},",
+        wall_ns, mb_per_s(bytes, wall_ns), peak_rss_kb()
+    );
+    println!("  \"phases\": {{");
+    for (i, name) in BENCH_PHASES.iter().enumerate() {
+        let sep = if i + 1 == BENCH_PHASES.len() { "" } else { "," };
+        println!(
+            "    \"{}\": {{\"ns\": {}, \"mb_per_s\": {:.2}}}{}",
+            name, ns[i], mb_per_s(bytes, ns[i]), sep
+        );
+    }
+    println!("  }}");
+    println!("}}");
+}